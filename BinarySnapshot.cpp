@@ -0,0 +1,205 @@
+#include "BinarySnapshot.h"
+#include <fstream>
+#include <cstring>
+
+namespace {
+    const char MAGIC[8] = { 'S', 'T', 'U', 'S', 'N', 'A', 'P', '\0' };
+
+    // 数值列直接按内存布局读写，只支持小端序主机
+    bool hostIsLittleEndian() {
+        const uint32_t probe = 1;
+        unsigned char first;
+        std::memcpy(&first, &probe, 1);
+        return first == 1;
+    }
+
+    template <typename T>
+    void put(std::vector<char>& out, size_t offset, T value) {
+        std::memcpy(&out[offset], &value, sizeof(T));
+    }
+
+    template <typename T>
+    T get(const char* p) {
+        T value;
+        std::memcpy(&value, p, sizeof(T));
+        return value;
+    }
+
+    // 字符串长度使用 LEB128 变长整数，短字符串只占 1 字节
+    void appendString(std::vector<char>& out, StringView s) {
+        uint32_t length = static_cast<uint32_t>(s.size());
+        do {
+            unsigned char byte = length & 0x7F;
+            length >>= 7;
+            out.push_back(static_cast<char>(length ? (byte | 0x80) : byte));
+        } while (length);
+        out.insert(out.end(), s.data(), s.data() + s.size());
+    }
+
+    // 跳过一个字符串，返回其内容的起始位置和长度；越界时返回 false
+    bool skipString(const char*& p, const char* end, const char*& data, uint32_t& length) {
+        length = 0;
+        for (int shift = 0; ; shift += 7) {
+            if (p == end || shift > 28) {
+                return false;
+            }
+            unsigned char byte = static_cast<unsigned char>(*p++);
+            length |= static_cast<uint32_t>(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) break;
+        }
+        if (static_cast<size_t>(end - p) < length) {
+            return false;
+        }
+        data = p;
+        p += length;
+        return true;
+    }
+}
+
+bool BinarySnapshot::isSnapshot(const char* begin, const char* end) {
+    return end - begin >= static_cast<ptrdiff_t>(sizeof(MAGIC)) &&
+           std::memcmp(begin, MAGIC, sizeof(MAGIC)) == 0;
+}
+
+size_t BinarySnapshot::recordCount(const char* begin, const char* end) {
+    if (end - begin < static_cast<ptrdiff_t>(HEADER_SIZE) || !isSnapshot(begin, end)) {
+        return 0;
+    }
+    return static_cast<size_t>(get<uint64_t>(begin + 16));
+}
+
+uint64_t BinarySnapshot::checksum(const char* data, size_t size) {
+    const uint64_t PRIME = 0x100000001B3ULL;
+    uint64_t h = 0xCBF29CE484222325ULL ^ size;
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        h = (h ^ get<uint64_t>(data + i)) * PRIME;
+        h ^= h >> 29;
+    }
+    uint64_t tail = 0;
+    if (i < size) {
+        std::memcpy(&tail, data + i, size - i);
+    }
+    h = (h ^ tail) * PRIME;
+    h ^= h >> 32;
+    return h;
+}
+
+bool BinarySnapshot::save(const std::string& path, const StudentTable& students,
+                          const std::vector<size_t>& rows, std::string& error) {
+    if (!hostIsLittleEndian()) {
+        error = "快照格式只支持小端序主机";
+        return false;
+    }
+
+    uint64_t count = rows.size();
+
+    // 先在内存中拼好完整的文件内容，再一次写出
+    const size_t columnsBytes = static_cast<size_t>(count) * (2 * sizeof(int32_t) + sizeof(double));
+    std::vector<char> out(HEADER_SIZE + columnsBytes);
+    out.reserve(out.size() + static_cast<size_t>(count) * 24);
+    // 空名册时 out 只有文件头，不能用 &out[HEADER_SIZE] 取尾后位置
+    char* ids = out.data() + HEADER_SIZE;
+    char* ages = ids + count * sizeof(int32_t);
+    char* gpas = ages + count * sizeof(int32_t);
+    // 表已按列存放，数值列逐列复制
+    const std::vector<int>& idColumn = students.idColumn();
+    const std::vector<int>& ageColumn = students.ageColumn();
+    const std::vector<double>& gpaColumn = students.gpaColumn();
+    for (size_t row = 0; row < rows.size(); ++row) {
+        size_t i = rows[row];
+        int32_t id = idColumn[i];
+        int32_t age = ageColumn[i];
+        double gpa = gpaColumn[i];
+        std::memcpy(ids + row * sizeof(int32_t), &id, sizeof(id));
+        std::memcpy(ages + row * sizeof(int32_t), &age, sizeof(age));
+        std::memcpy(gpas + row * sizeof(double), &gpa, sizeof(gpa));
+    }
+    for (size_t row = 0; row < rows.size(); ++row) {
+        size_t i = rows[row];
+        appendString(out, students.nameColumn()[i]);
+        appendString(out, students.genderOf(i));
+        appendString(out, students.majorOf(i));
+    }
+
+    std::memcpy(&out[0], MAGIC, sizeof(MAGIC));
+    put<uint32_t>(out, 8, VERSION);
+    put<uint32_t>(out, 12, 0);
+    put<uint64_t>(out, 16, count);
+    put<uint64_t>(out, 24, static_cast<uint64_t>(out.size() - HEADER_SIZE - columnsBytes));
+    put<uint64_t>(out, 32, checksum(out.data() + HEADER_SIZE, out.size() - HEADER_SIZE));
+    put<uint64_t>(out, 40, 0);
+
+    std::ofstream file(path.c_str(), std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        error = "无法打开文件 " + path + " 进行写入";
+        return false;
+    }
+    file.write(&out[0], static_cast<std::streamsize>(out.size()));
+    file.close();
+    if (!file) {
+        error = "写入文件 " + path + " 失败";
+        return false;
+    }
+    return true;
+}
+
+bool BinarySnapshot::load(const char* begin, const char* end, StudentTable& students, std::string& error) {
+    if (!hostIsLittleEndian()) {
+        error = "快照格式只支持小端序主机";
+        return false;
+    }
+    size_t size = static_cast<size_t>(end - begin);
+    if (size < HEADER_SIZE || !isSnapshot(begin, end)) {
+        error = "不是有效的快照文件";
+        return false;
+    }
+    uint32_t version = get<uint32_t>(begin + 8);
+    if (version != VERSION) {
+        error = "不支持的快照版本";
+        return false;
+    }
+    uint64_t count = get<uint64_t>(begin + 16);
+    uint64_t stringBytes = get<uint64_t>(begin + 24);
+    uint64_t expected = get<uint64_t>(begin + 32);
+
+    const uint64_t rowBytes = 2 * sizeof(int32_t) + sizeof(double);
+    uint64_t bodyBytes = size - HEADER_SIZE;
+    if (count > bodyBytes / rowBytes || count * rowBytes + stringBytes != bodyBytes) {
+        error = "快照文件长度与文件头不一致";
+        return false;
+    }
+    if (checksum(begin + HEADER_SIZE, static_cast<size_t>(bodyBytes)) != expected) {
+        error = "快照文件校验和不匹配";
+        return false;
+    }
+
+    // 先完整校验字符串表，保证出错时不追加任何记录
+    const char* strings = begin + HEADER_SIZE + count * rowBytes;
+    const char* data;
+    uint32_t length;
+    const char* p = strings;
+    for (uint64_t i = 0; i < count * 3; ++i) {
+        if (!skipString(p, end, data, length)) {
+            error = "快照字符串表已损坏";
+            return false;
+        }
+    }
+
+    size_t first = students.size();
+    const char* ids = begin + HEADER_SIZE;
+    students.appendColumns(ids, ids + count * sizeof(int32_t), ids + count * 2 * sizeof(int32_t),
+                           static_cast<size_t>(count));
+    const char* name;
+    const char* gender;
+    uint32_t nameLength, genderLength;
+    p = strings;
+    for (size_t i = 0; i < count; ++i) {
+        skipString(p, end, name, nameLength);
+        skipString(p, end, gender, genderLength);
+        skipString(p, end, data, length);
+        students.setText(first + i, StringView(name, nameLength), StringView(gender, genderLength),
+                         StringView(data, length));
+    }
+    return true;
+}
@@ -0,0 +1,52 @@
+#ifndef BINARYSNAPSHOT_H
+#define BINARYSNAPSHOT_H
+
+#include "Student.h"
+#include "StudentTable.h"
+#include <vector>
+#include <string>
+#include <cstddef>
+#include <stdint.h>
+
+// 二进制快照格式（小端序，版本 1）：
+//
+//   文件头（48 字节）
+//     char     magic[8]          "STUSNAP\0"
+//     uint32_t version           格式版本
+//     uint32_t flags             保留，目前为 0
+//     uint64_t count             记录数
+//     uint64_t stringBytes       字符串表字节数
+//     uint64_t checksum          文件头之后全部内容的校验和
+//     uint64_t reserved          保留，目前为 0
+//   定长数值列
+//     int32_t  ids[count]
+//     int32_t  ages[count]
+//     double   gpas[count]
+//   字符串表：每条记录依次为 姓名、性别、专业，各自为 变长整数（LEB128）长度 + 字节
+//
+// 与文本格式不同，姓名和专业中可以包含逗号和换行符
+class BinarySnapshot {
+public:
+    static const uint32_t VERSION = 1;
+    static const size_t HEADER_SIZE = 48;
+
+    // 判断数据是否以快照文件头的魔数开头
+    static bool isSnapshot(const char* begin, const char* end);
+
+    // 读取文件头中的记录数（用于预留容量），不是快照时返回 0
+    static size_t recordCount(const char* begin, const char* end);
+
+    // 按 rows 给出的行号顺序把学生写入快照文件
+    static bool save(const std::string& path, const StudentTable& students,
+                     const std::vector<size_t>& rows, std::string& error);
+
+    // 把快照内容按文件中的顺序整批追加到 students：数值列整段复制，字符串直接从字符串表
+    // 存入字符串池和字典，不经过 Student。学号不查重，由调用方处理。
+    // 文件头、长度、校验和或字符串表不一致时不追加任何记录，返回 false
+    static bool load(const char* begin, const char* end, StudentTable& students, std::string& error);
+
+    // 计算校验和（按 8 字节字处理）
+    static uint64_t checksum(const char* data, size_t size);
+};
+
+#endif // BINARYSNAPSHOT_H
@@ -0,0 +1,251 @@
+#include "CommandInterpreter.h"
+#include "CsvLoader.h"
+#include <cstring>
+#include <cstdio>
+#include <cstdlib>
+#include <cerrno>
+#include <climits>
+
+namespace {
+    const char* const LOG_FAILURE = "写入日志失败，修改已生效但尚未写盘";
+
+    bool isBlank(char c) {
+        return c == ' ' || c == '\t';
+    }
+
+    const char* skipBlanks(const char* p, const char* end) {
+        while (p < end && isBlank(*p)) ++p;
+        return p;
+    }
+
+    // [begin, end) 是否恰好是单词 word
+    bool equals(const char* begin, const char* end, const char* word) {
+        size_t length = std::strlen(word);
+        return static_cast<size_t>(end - begin) == length && std::memcmp(begin, word, length) == 0;
+    }
+
+    // 解析一个学号，前后可以有空白
+    bool parseId(const char* begin, const char* end, int& id) {
+        begin = skipBlanks(begin, end);
+        while (end > begin && isBlank(end[-1])) --end;
+        if (begin == end || end - begin > 15) {
+            return false;
+        }
+        char text[16];
+        std::memcpy(text, begin, static_cast<size_t>(end - begin));
+        text[end - begin] = '\0';
+        char* stop = nullptr;
+        errno = 0;
+        long value = std::strtol(text, &stop, 10);
+        if (*stop != '\0' || errno != 0 || value < INT_MIN || value > INT_MAX) {
+            return false;
+        }
+        id = static_cast<int>(value);
+        return true;
+    }
+
+    bool parseRecord(const char* begin, const char* end, Student& student, std::string& error) {
+        begin = skipBlanks(begin, end);
+        SkippedLine::Reason reason;
+        if (!CsvLoader::parseLine(begin, end, student, reason)) {
+            error = reason == SkippedLine::BAD_FIELD_COUNT
+                ? "记录应为 学号,姓名,年龄,性别,专业,绩点 六个字段"
+                : "记录中的学号、年龄或绩点不是有效的数字";
+            return false;
+        }
+        return true;
+    }
+
+    void appendNumber(std::string& out, const char* format, double value) {
+        char number[32];
+        std::snprintf(number, sizeof(number), format, value);
+        out += number;
+    }
+}
+
+CommandInterpreter::CommandInterpreter(StudentManager& manager) : manager(manager) {}
+
+bool CommandInterpreter::execute(const std::string& line, std::string& out, std::string& error) {
+    return execute(line.data(), line.data() + line.size(), out, error);
+}
+
+bool CommandInterpreter::execute(const char* begin, const char* end, std::string& out, std::string& error) {
+    // 兼容 Windows 换行符
+    while (end > begin && (end[-1] == '\r' || isBlank(end[-1]))) --end;
+    begin = skipBlanks(begin, end);
+    if (begin == end || *begin == '#') {
+        return true;
+    }
+    const char* word = begin;
+    while (begin < end && !isBlank(*begin)) ++begin;
+    const char* wordEnd = begin;
+    begin = skipBlanks(begin, end);
+
+    if (equals(word, wordEnd, "add")) {
+        return add(begin, end, error);
+    } else if (equals(word, wordEnd, "update")) {
+        return update(begin, end, error);
+    } else if (equals(word, wordEnd, "delete")) {
+        return remove(begin, end, error);
+    } else if (equals(word, wordEnd, "find")) {
+        return find(begin, end, out, error);
+    } else if (equals(word, wordEnd, "query")) {
+        return query(begin, end, out, error);
+    } else if (equals(word, wordEnd, "stats") && begin == end) {
+        stats(out);
+        return true;
+    } else if (equals(word, wordEnd, "save") && begin == end) {
+        if (!manager.saveToFile()) {
+            error = manager.isInTransaction() ? "事务进行中，结束时统一保存" : "保存数据文件失败";
+            return false;
+        }
+        return true;
+    }
+    error = "未知命令：" + std::string(word, end);
+    return false;
+}
+
+bool CommandInterpreter::add(const char* begin, const char* end, std::string& error) {
+    Student student;
+    if (!parseRecord(begin, end, student, error)) {
+        return false;
+    }
+    if (manager.findStudent(student.getId())) {
+        error = "学号 " + std::to_string(student.getId()) + " 已存在";
+        return false;
+    }
+    if (!manager.addStudent(student)) {
+        error = LOG_FAILURE;
+        return false;
+    }
+    return true;
+}
+
+bool CommandInterpreter::update(const char* begin, const char* end, std::string& error) {
+    const char* separator = begin;
+    while (separator < end && !isBlank(*separator)) ++separator;
+    int id = 0;
+    if (!parseId(begin, separator, id)) {
+        error = "用法：update <学号> <学号>,<姓名>,<年龄>,<性别>,<专业>,<绩点>";
+        return false;
+    }
+    Student student;
+    if (!parseRecord(separator, end, student, error)) {
+        return false;
+    }
+    if (!manager.findStudent(id)) {
+        error = "未找到学号为 " + std::to_string(id) + " 的学生";
+        return false;
+    }
+    if (student.getId() != id && manager.findStudent(student.getId())) {
+        error = "学号 " + std::to_string(student.getId()) + " 已存在";
+        return false;
+    }
+    if (!manager.updateStudent(id, student)) {
+        error = LOG_FAILURE;
+        return false;
+    }
+    return true;
+}
+
+bool CommandInterpreter::remove(const char* begin, const char* end, std::string& error) {
+    int id = 0;
+    if (!parseId(begin, end, id)) {
+        error = "用法：delete <学号>";
+        return false;
+    }
+    if (!manager.findStudent(id)) {
+        error = "未找到学号为 " + std::to_string(id) + " 的学生";
+        return false;
+    }
+    if (!manager.deleteStudent(id)) {
+        error = LOG_FAILURE;
+        return false;
+    }
+    return true;
+}
+
+bool CommandInterpreter::find(const char* begin, const char* end, std::string& out, std::string& error) {
+    int id = 0;
+    if (!parseId(begin, end, id)) {
+        error = "用法：find <学号>";
+        return false;
+    }
+    StudentRef student = manager.findStudent(id);
+    if (!student) {
+        out += "# 未找到学号为 " + std::to_string(id) + " 的学生\n";
+        return true;
+    }
+    appendRecord(out, student);
+    return true;
+}
+
+bool CommandInterpreter::query(const char* begin, const char* end, std::string& out, std::string& error) {
+    StudentQuery spec;
+    std::string reason;
+    if (!StudentQuery::parse(std::string(begin, end), spec, reason)) {
+        error = "查询语句有误：" + reason;
+        return false;
+    }
+    QueryResult result = manager.query(spec);
+    for (size_t i = 0; i < result.rows.size(); ++i) {
+        appendRecord(out, result.rows[i]);
+    }
+    out += result.complete ? "# 共 " : "# 至少 ";
+    out += std::to_string(result.matched);
+    out += " 名学生符合条件\n";
+    if (spec.wantsStatistics() && result.stats.graded > 0) {
+        out += "# 平均绩点 ";
+        appendNumber(out, "%.2f", result.stats.sum / result.stats.graded);
+        out += '\n';
+    }
+    return true;
+}
+
+void CommandInterpreter::stats(std::string& out) {
+    GpaStatistics stats = manager.getGpaStatistics();
+    out += "# 学生总数 " + std::to_string(manager.getTotalStudents());
+    out += "，平均绩点 ";
+    appendNumber(out, "%.2f", manager.getAverageGpa());
+    if (stats.graded > 0) {
+        out += "，最高绩点 ";
+        appendNumber(out, "%.2f", stats.highest.getGpa());
+        out += "（学号 " + std::to_string(stats.highest.getId()) + "）";
+        out += "，最低绩点 ";
+        appendNumber(out, "%.2f", stats.lowest.getGpa());
+        out += "（学号 " + std::to_string(stats.lowest.getId()) + "）";
+    }
+    out += '\n';
+}
+
+// 与文本数据文件的写法相同（绩点按 ostream 的默认格式，即 %g）
+void CommandInterpreter::appendRecord(std::string& out, const StudentRef& student) {
+    char number[32];
+    out += std::to_string(student.getId());
+    out += ',';
+    StringView name = student.getNameView();
+    out.append(name.data(), name.size());
+    out += ',';
+    out += std::to_string(student.getAge());
+    out += ',';
+    StringView gender = student.getGenderView();
+    out.append(gender.data(), gender.size());
+    out += ',';
+    StringView major = student.getMajorView();
+    out.append(major.data(), major.size());
+    out += ',';
+    std::snprintf(number, sizeof(number), "%g", student.getGpa());
+    out += number;
+    out += '\n';
+}
+
+const char* CommandInterpreter::usage() {
+    return "  add <学号>,<姓名>,<年龄>,<性别>,<专业>,<绩点>\n"
+           "  update <学号> <学号>,<姓名>,<年龄>,<性别>,<专业>,<绩点>\n"
+           "  delete <学号>\n"
+           "  find <学号>\n"
+           "  query <查询语句>（如 major = 计算机科学 and gpa >= 3.5 order by gpa desc limit 10）\n"
+           "  stats\n"
+           "  save\n"
+           "  空行与 # 开头的行被忽略\n";
+}
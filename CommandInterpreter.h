@@ -0,0 +1,40 @@
+#ifndef COMMANDINTERPRETER_H
+#define COMMANDINTERPRETER_H
+
+#include "StudentManager.h"
+#include <string>
+#include <cstddef>
+
+// 文本命令解释器：每行一条命令，对一个 StudentManager 执行，结果追加到调用者的缓冲区，
+// 不经过 iostream，也不输出“学生添加成功！”之类的提示。命令格式：
+//   add <学号>,<姓名>,<年龄>,<性别>,<专业>,<绩点>          添加（记录格式与文本数据文件相同）
+//   update <学号> <学号>,<姓名>,<年龄>,<性别>,<专业>,<绩点> 修改（新记录可以改学号）
+//   delete <学号>                                          删除
+//   find <学号>                                            输出该学生的记录（数据文件格式）
+//   query <查询语句>                                       组合查询（语法见 StudentQuery::parse），输出匹配的记录
+//   stats                                                  人数、平均绩点与最高、最低绩点
+//   save                                                   保存数据文件
+// 空行和以 # 开头的行被忽略。输出中的说明行也以 # 开头，记录行可以直接作为数据文件或 add 的参数
+class CommandInterpreter {
+private:
+    StudentManager& manager;
+
+    bool add(const char* begin, const char* end, std::string& error);
+    bool update(const char* begin, const char* end, std::string& error);
+    bool remove(const char* begin, const char* end, std::string& error);
+    bool find(const char* begin, const char* end, std::string& out, std::string& error);
+    bool query(const char* begin, const char* end, std::string& out, std::string& error);
+    void stats(std::string& out);
+
+public:
+    explicit CommandInterpreter(StudentManager& manager);
+
+    // 执行一行命令（不含换行符）。结果追加到 out；失败时返回 false，原因写入 error（不含换行符）
+    bool execute(const char* begin, const char* end, std::string& out, std::string& error);
+    bool execute(const std::string& line, std::string& out, std::string& error);
+
+    static void appendRecord(std::string& out, const StudentRef& student); // 按数据文件格式追加一行
+    static const char* usage();        // 命令格式说明
+};
+
+#endif // COMMANDINTERPRETER_H
@@ -0,0 +1,138 @@
+#include "ConcurrentStudentManager.h"
+#include <sstream>
+
+ConcurrentStudentManager::ConcurrentStudentManager(const std::string& filename,
+                                                   const ManagerOptions& options,
+                                                   size_t lockShards)
+    : manager(filename, options), lock(lockShards) {}
+
+std::vector<Student> ConcurrentStudentManager::copyOut(const std::vector<StudentRef>& refs) {
+    std::vector<Student> result;
+    result.reserve(refs.size());
+    for (size_t i = 0; i < refs.size(); ++i) {
+        result.push_back(refs[i].toStudent());
+    }
+    return result;
+}
+
+bool ConcurrentStudentManager::addStudent(const Student& student) {
+    ReadWriteLock::WriteGuard guard(lock);
+    return manager.addStudent(student);
+}
+
+bool ConcurrentStudentManager::deleteStudent(int id) {
+    ReadWriteLock::WriteGuard guard(lock);
+    return manager.deleteStudent(id);
+}
+
+bool ConcurrentStudentManager::updateStudent(int id, const Student& newInfo) {
+    ReadWriteLock::WriteGuard guard(lock);
+    return manager.updateStudent(id, newInfo);
+}
+
+LoadReport ConcurrentStudentManager::addStudents(const std::vector<Student>& batch) {
+    ReadWriteLock::WriteGuard guard(lock);
+    return manager.addStudents(batch);
+}
+
+// 在锁外读取整个流，持有写锁的时间只包含解析与导入
+LoadReport ConcurrentStudentManager::importFrom(std::istream& in) {
+    std::stringstream buffered;
+    buffered << in.rdbuf();
+    ReadWriteLock::WriteGuard guard(lock);
+    return manager.importFrom(buffered);
+}
+
+void ConcurrentStudentManager::clearAllStudents() {
+    ReadWriteLock::WriteGuard guard(lock);
+    manager.clearAllStudents();
+}
+
+void ConcurrentStudentManager::compact() {
+    ReadWriteLock::WriteGuard guard(lock);
+    manager.compact();
+}
+
+bool ConcurrentStudentManager::saveToFile() {
+    ReadWriteLock::WriteGuard guard(lock);
+    return manager.saveToFile();
+}
+
+std::future<bool> ConcurrentStudentManager::saveAsync(const SaveCallback& done) {
+    ReadWriteLock::WriteGuard guard(lock);
+    return manager.saveAsync(done);
+}
+
+bool ConcurrentStudentManager::syncLog() {
+    ReadWriteLock::WriteGuard guard(lock);
+    return manager.syncLog();
+}
+
+bool ConcurrentStudentManager::findStudent(int id, Student& out) const {
+    ReadWriteLock::ReadGuard guard(lock);
+    StudentRef student = manager.findStudent(id);
+    if (!student) {
+        return false;
+    }
+    out = student.toStudent();
+    return true;
+}
+
+std::vector<Student> ConcurrentStudentManager::searchByName(const std::string& name, size_t limit) const {
+    ReadWriteLock::ReadGuard guard(lock);
+    return copyOut(manager.searchByName(name, limit));
+}
+
+std::vector<Student> ConcurrentStudentManager::searchByName(const std::string& name, const QueryPage& page) const {
+    ReadWriteLock::ReadGuard guard(lock);
+    return copyOut(manager.searchByName(name, page));
+}
+
+std::vector<Student> ConcurrentStudentManager::searchByMajor(const std::string& major, const QueryPage& page) const {
+    ReadWriteLock::ReadGuard guard(lock);
+    return copyOut(manager.searchByMajor(major, page));
+}
+
+std::vector<Student> ConcurrentStudentManager::getStudentsByGpaRange(double minGpa, double maxGpa) const {
+    ReadWriteLock::ReadGuard guard(lock);
+    return copyOut(manager.getStudentsByGpaRange(minGpa, maxGpa));
+}
+
+std::vector<Student> ConcurrentStudentManager::getTopStudentsByGpa(size_t k) const {
+    ReadWriteLock::ReadGuard guard(lock);
+    return copyOut(manager.getTopStudentsByGpa(k));
+}
+
+int ConcurrentStudentManager::getTotalStudents() const {
+    ReadWriteLock::ReadGuard guard(lock);
+    return manager.getTotalStudents();
+}
+
+double ConcurrentStudentManager::getAverageGpa() const {
+    ReadWriteLock::ReadGuard guard(lock);
+    return manager.getAverageGpa();
+}
+
+double ConcurrentStudentManager::getGpaPercentile(double percent) const {
+    ReadWriteLock::ReadGuard guard(lock);
+    return manager.getGpaPercentile(percent);
+}
+
+double ConcurrentStudentManager::getGpaPercentileRank(int id) const {
+    ReadWriteLock::ReadGuard guard(lock);
+    return manager.getGpaPercentileRank(id);
+}
+
+MetricsSnapshot ConcurrentStudentManager::getMetrics() const {
+    return manager.getMetrics();
+}
+
+void ConcurrentStudentManager::read(const std::function<void(const StudentManager&)>& visit) const {
+    ReadWriteLock::ReadGuard guard(lock);
+    visit(manager);
+}
+
+void ConcurrentStudentManager::write(const std::function<void(StudentManager&)>& change) {
+    ReadWriteLock::WriteGuard guard(lock);
+    change(manager);
+}
@@ -0,0 +1,56 @@
+#ifndef CONCURRENTSTUDENTMANAGER_H
+#define CONCURRENTSTUDENTMANAGER_H
+
+#include "StudentManager.h"
+#include "ReadWriteLock.h"
+#include <vector>
+#include <string>
+#include <functional>
+
+// 线程安全的 StudentManager：查找、搜索、统计持有读锁，可在多个线程中同时执行；
+// 增删改、保存等持有写锁。读锁按线程分片（见 ReadWriteLock），读者增多时不争用同一个缓存行。
+// 锁释放后 StudentRef 视图可能失效，所以查询结果都以 Student 副本返回
+class ConcurrentStudentManager {
+private:
+    StudentManager manager;
+    mutable ReadWriteLock lock;
+
+    static std::vector<Student> copyOut(const std::vector<StudentRef>& refs);
+
+public:
+    // lockShards 为读写锁的分片数，0 表示使用硬件线程数
+    ConcurrentStudentManager(const std::string& filename = "students.txt",
+                             const ManagerOptions& options = ManagerOptions(),
+                             size_t lockShards = 0);
+
+    // 修改操作（写锁）
+    bool addStudent(const Student& student);
+    bool deleteStudent(int id);
+    bool updateStudent(int id, const Student& newInfo);
+    LoadReport addStudents(const std::vector<Student>& batch);
+    LoadReport importFrom(std::istream& in);
+    void clearAllStudents();
+    void compact();
+    bool saveToFile();
+    std::future<bool> saveAsync(const SaveCallback& done = SaveCallback()); // 只在取快照时持有写锁
+    bool syncLog();
+
+    // 查询操作（读锁）
+    bool findStudent(int id, Student& out) const;     // 找到时复制到 out
+    std::vector<Student> searchByName(const std::string& name, size_t limit = 0) const;
+    std::vector<Student> searchByName(const std::string& name, const QueryPage& page) const; // 只复制一页
+    std::vector<Student> searchByMajor(const std::string& major, const QueryPage& page = QueryPage()) const;
+    std::vector<Student> getStudentsByGpaRange(double minGpa, double maxGpa) const;
+    std::vector<Student> getTopStudentsByGpa(size_t k) const;
+    int getTotalStudents() const;
+    double getAverageGpa() const;
+    double getGpaPercentile(double percent) const;
+    double getGpaPercentileRank(int id) const;
+    MetricsSnapshot getMetrics() const;  // 运行指标本身可以多线程记录和读取，不加锁
+
+    // 在锁内执行任意操作；回调中不能再调用本对象的方法（锁不可重入）
+    void read(const std::function<void(const StudentManager&)>& visit) const;
+    void write(const std::function<void(StudentManager&)>& change);
+};
+
+#endif // CONCURRENTSTUDENTMANAGER_H
@@ -0,0 +1,267 @@
+#include "CsvLoader.h"
+#include <fstream>
+#include <cstring>
+#include <cstdlib>
+#include <cerrno>
+#include <climits>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#define CSVLOADER_HAS_MMAP 1
+#endif
+
+namespace {
+    const int FIELD_COUNT = 6;
+
+    bool isSpace(char c) {
+        return c == ' ' || c == '\t' || c == '\n' || c == '\v' || c == '\f' || c == '\r';
+    }
+
+    // 与 std::stoi 语义一致：跳过前导空白，解析最长的数字前缀，溢出视为失败
+    bool parseInt(const char* p, const char* end, int& out) {
+        while (p < end && isSpace(*p)) ++p;
+        bool negative = false;
+        if (p < end && (*p == '+' || *p == '-')) {
+            negative = (*p == '-');
+            ++p;
+        }
+        if (p == end || *p < '0' || *p > '9') {
+            return false;
+        }
+        long long value = 0;
+        while (p < end && *p >= '0' && *p <= '9') {
+            value = value * 10 + (*p - '0');
+            if (value > static_cast<long long>(INT_MAX) + 1) {
+                return false;
+            }
+            ++p;
+        }
+        if (negative) value = -value;
+        if (value > INT_MAX || value < INT_MIN) {
+            return false;
+        }
+        out = static_cast<int>(value);
+        return true;
+    }
+
+    // 回退路径：复制到以 '\0' 结尾的缓冲区后交给 strtod，语义同 std::stod
+    bool parseDoubleSlow(const char* begin, const char* end, double& out) {
+        char buf[128];
+        size_t len = static_cast<size_t>(end - begin);
+        if (len >= sizeof(buf)) {
+            len = sizeof(buf) - 1;
+        }
+        std::memcpy(buf, begin, len);
+        buf[len] = '\0';
+
+        char* stop = nullptr;
+        errno = 0;
+        double value = std::strtod(buf, &stop);
+        if (stop == buf || errno == ERANGE) {
+            return false;
+        }
+        out = value;
+        return true;
+    }
+
+    // 快速路径：形如 [-]123.45 的十进制小数。尾数不超过 2^53、小数位不超过 22 时，
+    // 一次除以 10 的整数次幂即可得到正确舍入的结果；其余情况交给 strtod
+    bool parseDouble(const char* begin, const char* end, double& out) {
+        static const double POW10[] = {
+            1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+            1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+        };
+        const unsigned long long MAX_MANTISSA = 1ULL << 53;
+
+        const char* p = begin;
+        while (p < end && isSpace(*p)) ++p;
+        bool negative = false;
+        if (p < end && (*p == '+' || *p == '-')) {
+            negative = (*p == '-');
+            ++p;
+        }
+
+        unsigned long long mantissa = 0;
+        int digits = 0;
+        int fraction = 0;
+        while (p < end && *p >= '0' && *p <= '9') {
+            mantissa = mantissa * 10 + static_cast<unsigned>(*p - '0');
+            if (mantissa >= MAX_MANTISSA) return parseDoubleSlow(begin, end, out);
+            ++digits;
+            ++p;
+        }
+        if (p < end && *p == '.') {
+            ++p;
+            while (p < end && *p >= '0' && *p <= '9') {
+                mantissa = mantissa * 10 + static_cast<unsigned>(*p - '0');
+                if (mantissa >= MAX_MANTISSA || fraction == 22) {
+                    return parseDoubleSlow(begin, end, out);
+                }
+                ++digits;
+                ++fraction;
+                ++p;
+            }
+        }
+        if (digits == 0 || (p < end && (*p == 'e' || *p == 'E' || *p == 'x' || *p == 'X'))) {
+            return parseDoubleSlow(begin, end, out);
+        }
+
+        double value = static_cast<double>(mantissa) / POW10[fraction];
+        out = negative ? -value : value;
+        return true;
+    }
+}
+
+// ========== MappedFile ==========
+
+MappedFile::MappedFile() : data(nullptr), length(0), mapped(false) {}
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+bool MappedFile::open(const std::string& path) {
+    close();
+
+#ifdef CSVLOADER_HAS_MMAP
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) == 0 && st.st_size > 0) {
+        int flags = MAP_PRIVATE;
+#ifdef MAP_POPULATE
+        flags |= MAP_POPULATE;         // 一次性预读全部页面，避免逐页缺页中断
+#endif
+        void* addr = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, flags, fd, 0);
+        if (addr != MAP_FAILED) {
+#ifdef MADV_SEQUENTIAL
+            madvise(addr, static_cast<size_t>(st.st_size), MADV_SEQUENTIAL);
+#endif
+            data = static_cast<const char*>(addr);
+            length = static_cast<size_t>(st.st_size);
+            mapped = true;
+            ::close(fd);
+            return true;
+        }
+    }
+    ::close(fd);
+#endif
+
+    std::ifstream file(path.c_str(), std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+    buffer.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    data = buffer.empty() ? nullptr : &buffer[0];
+    length = buffer.size();
+    return true;
+}
+
+void MappedFile::close() {
+#ifdef CSVLOADER_HAS_MMAP
+    if (mapped) {
+        munmap(const_cast<char*>(data), length);
+    }
+#endif
+    std::vector<char>().swap(buffer);
+    data = nullptr;
+    length = 0;
+    mapped = false;
+}
+
+const char* MappedFile::begin() const {
+    return data;
+}
+
+const char* MappedFile::end() const {
+    return data + length;
+}
+
+size_t MappedFile::size() const {
+    return length;
+}
+
+// ========== CsvLoader ==========
+
+bool CsvLoader::parseLine(const char* begin, const char* end, Student& out,
+                          SkippedLine::Reason& reason) {
+    // 与 std::getline(ss, item, ',') 的切分方式一致：行尾的逗号不产生空字段
+    const char* fields[FIELD_COUNT + 1];
+    int count = 0;
+    fields[count++] = begin;
+    for (const char* p = begin; p < end; ++p) {
+        if (*p == ',') {
+            if (count > FIELD_COUNT) {
+                reason = SkippedLine::BAD_FIELD_COUNT;
+                return false;
+            }
+            fields[count++] = p + 1;
+        }
+    }
+    bool trailingComma = (count == FIELD_COUNT + 1 && fields[FIELD_COUNT] == end);
+    if (trailingComma) {
+        --count;
+    }
+    if (count != FIELD_COUNT) {
+        reason = SkippedLine::BAD_FIELD_COUNT;
+        return false;
+    }
+
+    // 第 i 个字段为 [fields[i], fields[i + 1] - 1)，最后一个字段到行尾为止
+    const char* lastEnd = trailingComma ? end - 1 : end;
+
+    int id = 0, age = 0;
+    double gpa = 0.0;
+    if (!parseInt(fields[0], fields[1] - 1, id) ||
+        !parseInt(fields[2], fields[3] - 1, age) ||
+        !parseDouble(fields[5], lastEnd, gpa)) {
+        reason = SkippedLine::BAD_NUMBER;
+        return false;
+    }
+
+    out.setId(id);
+    out.setName(std::string(fields[1], fields[2] - 1));
+    out.setAge(age);
+    out.setGender(std::string(fields[3], fields[4] - 1));
+    out.setMajor(std::string(fields[4], fields[5] - 1));
+    out.setGpa(gpa);
+    return true;
+}
+
+size_t CsvLoader::parse(const char* begin, const char* end, size_t firstLine,
+                        StudentRowSink& sink) {
+    Student scratch;
+    size_t lineNumber = firstLine;
+    const char* p = begin;
+    while (p < end) {
+        const char* newline = static_cast<const char*>(std::memchr(p, '\n', static_cast<size_t>(end - p)));
+        const char* lineEnd = newline ? newline : end;
+
+        if (lineEnd != p) {
+            SkippedLine::Reason reason;
+            if (parseLine(p, lineEnd, scratch, reason)) {
+                sink.onRow(lineNumber, scratch, p, lineEnd);
+            } else {
+                sink.onSkip(lineNumber, reason, p, lineEnd);
+            }
+        }
+
+        ++lineNumber;
+        p = newline ? newline + 1 : end;
+    }
+    return lineNumber - firstLine;
+}
+
+size_t CsvLoader::countLines(const char* begin, const char* end) {
+    size_t lines = 0;
+    for (const char* p = begin; p < end; ++lines) {
+        const void* newline = std::memchr(p, '\n', static_cast<size_t>(end - p));
+        p = newline ? static_cast<const char*>(newline) + 1 : end;
+    }
+    return lines;
+}
@@ -0,0 +1,78 @@
+#ifndef CSVLOADER_H
+#define CSVLOADER_H
+
+#include "Student.h"
+#include <vector>
+#include <string>
+#include <cstddef>
+
+// 被跳过的数据行
+struct SkippedLine {
+    enum Reason {
+        BAD_FIELD_COUNT,               // 字段数不是 6
+        BAD_NUMBER,                    // 学号/年龄/绩点无法解析
+        DUPLICATE_ID                   // 学号与之前的行重复
+    };
+
+    size_t lineNumber;                 // 行号（从 1 开始）
+    Reason reason;                     // 跳过原因
+    std::string text;                  // 原始行内容
+};
+
+// 一次加载的结果报告
+struct LoadReport {
+    size_t loadedRows;                 // 成功加载的行数
+    size_t bytesRead;                  // 读取的字节数
+    std::vector<SkippedLine> skipped;  // 被跳过的行
+
+    LoadReport() : loadedRows(0), bytesRead(0) {}
+};
+
+// 只读内存映射文件，不支持 mmap 或映射失败时退回到一次性读入内存
+class MappedFile {
+private:
+    const char* data;                  // 文件内容起始地址
+    size_t length;                     // 文件长度
+    bool mapped;                       // 是否为 mmap 映射
+    std::vector<char> buffer;          // 退回读入时使用的缓冲区
+
+    MappedFile(const MappedFile&);
+    MappedFile& operator=(const MappedFile&);
+
+public:
+    MappedFile();
+    ~MappedFile();
+
+    bool open(const std::string& path); // 打开并映射文件，文件不存在返回 false
+    void close();
+    const char* begin() const;
+    const char* end() const;
+    size_t size() const;
+};
+
+// 解析结果的接收者（onRow 可以移走 student 的内容）
+class StudentRowSink {
+public:
+    virtual ~StudentRowSink() {}
+    virtual void onRow(size_t lineNumber, Student& student,
+                       const char* begin, const char* end) = 0;
+    virtual void onSkip(size_t lineNumber, SkippedLine::Reason reason,
+                        const char* begin, const char* end) = 0;
+};
+
+// 学生数据 CSV 解析器：原地切分字段，不为每行构造临时字符串
+class CsvLoader {
+public:
+    // 解析一行（不含换行符）到 out 中，失败时通过 reason 返回原因
+    static bool parseLine(const char* begin, const char* end, Student& out,
+                          SkippedLine::Reason& reason);
+
+    // 解析 [begin, end) 中的所有行，firstLine 为第一行的行号；空行直接忽略。返回处理的行数
+    static size_t parse(const char* begin, const char* end, size_t firstLine,
+                        StudentRowSink& sink);
+
+    // 统计 [begin, end) 中的行数（最后一行可以没有换行符）
+    static size_t countLines(const char* begin, const char* end);
+};
+
+#endif // CSVLOADER_H
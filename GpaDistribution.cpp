@@ -0,0 +1,158 @@
+#include "GpaDistribution.h"
+#include <cmath>
+#include <limits>
+
+namespace {
+    const size_t BUCKETS = 403;        // 低于 0、[0, 4] 内每 0.01 一个、高于 4
+}
+
+GpaDistribution::GpaDistribution() : tree(BUCKETS + 1, 0), values(BUCKETS), total(0) {}
+
+size_t GpaDistribution::bucketOf(double gpa) {
+    if (gpa < 0.0) {
+        return 0;
+    }
+    if (gpa > 4.0) {
+        return BUCKETS - 1;
+    }
+    return 1 + static_cast<size_t>(std::floor(gpa * 100.0));
+}
+
+void GpaDistribution::update(size_t bucket, bool increase) {
+    for (size_t i = bucket + 1; i <= BUCKETS; i += i & (~i + 1)) {
+        if (increase) {
+            ++tree[i];
+        } else {
+            --tree[i];
+        }
+    }
+}
+
+size_t GpaDistribution::prefix(size_t buckets) const {
+    size_t sum = 0;
+    for (size_t i = buckets; i > 0; i -= i & (~i + 1)) {
+        sum += tree[i];
+    }
+    return sum;
+}
+
+size_t GpaDistribution::below(double gpa, bool inclusive) const {
+    if (std::isnan(gpa)) {
+        return 0;
+    }
+    size_t bucket = bucketOf(gpa);
+    size_t count = prefix(bucket);
+    const std::map<double, size_t>& inBucket = values[bucket];
+    for (std::map<double, size_t>::const_iterator it = inBucket.begin(); it != inBucket.end(); ++it) {
+        if (inclusive ? it->first > gpa : it->first >= gpa) break;
+        count += it->second;
+    }
+    return count;
+}
+
+void GpaDistribution::add(double gpa) {
+    if (std::isnan(gpa)) {
+        return;
+    }
+    size_t bucket = bucketOf(gpa);
+    update(bucket, true);
+    ++values[bucket][gpa];
+    ++total;
+}
+
+void GpaDistribution::remove(double gpa) {
+    if (std::isnan(gpa)) {
+        return;
+    }
+    size_t bucket = bucketOf(gpa);
+    std::map<double, size_t>::iterator it = values[bucket].find(gpa);
+    if (it == values[bucket].end()) {
+        return;
+    }
+    if (--it->second == 0) {
+        values[bucket].erase(it);
+    }
+    update(bucket, false);
+    --total;
+}
+
+void GpaDistribution::clear() {
+    tree.assign(BUCKETS + 1, 0);
+    for (size_t i = 0; i < values.size(); ++i) {
+        values[i].clear();
+    }
+    total = 0;
+}
+
+size_t GpaDistribution::size() const {
+    return total;
+}
+
+size_t GpaDistribution::countBelow(double gpa) const {
+    return below(gpa, false);
+}
+
+size_t GpaDistribution::countAtMost(double gpa) const {
+    return below(gpa, true);
+}
+
+// 在树状数组上自顶向下找到第 k 个所在的桶，再在桶内按取值累计
+double GpaDistribution::select(size_t k) const {
+    size_t pos = 0;
+    size_t step = 1;
+    while (step * 2 <= BUCKETS) step *= 2;
+    for (; step > 0; step /= 2) {
+        if (pos + step <= BUCKETS && tree[pos + step] <= k) {
+            pos += step;
+            k -= tree[pos];
+        }
+    }
+    const std::map<double, size_t>& inBucket = values[pos];
+    for (std::map<double, size_t>::const_iterator it = inBucket.begin(); it != inBucket.end(); ++it) {
+        if (k < it->second) {
+            return it->first;
+        }
+        k -= it->second;
+    }
+    return std::numeric_limits<double>::quiet_NaN();
+}
+
+double GpaDistribution::percentile(double percent) const {
+    if (total == 0) {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+    if (percent < 0.0) percent = 0.0;
+    if (percent > 100.0) percent = 100.0;
+    double position = (total - 1) * percent / 100.0;
+    size_t rank = static_cast<size_t>(position);
+    double fraction = position - rank;
+    double value = select(rank);
+    if (fraction > 0.0 && rank + 1 < total) {
+        value += fraction * (select(rank + 1) - value);
+    }
+    return value;
+}
+
+std::vector<GpaBin> GpaDistribution::histogram(double low, double high, double width) const {
+    std::vector<GpaBin> bins;
+    if (!(width > 0.0) || !(low <= high)) {
+        return bins;
+    }
+    // 容许 (high - low) / width 的舍入误差，避免多出一个几乎为空的区间
+    size_t count = static_cast<size_t>(std::ceil((high - low) / width - 1e-9));
+    if (count == 0) {
+        count = 1;
+    }
+    size_t previous = countBelow(low);
+    for (size_t i = 0; i < count; ++i) {
+        GpaBin bin;
+        bin.lower = low + i * width;
+        bool last = i + 1 == count;
+        bin.upper = last ? high : low + (i + 1) * width;
+        size_t upTo = last ? countAtMost(bin.upper) : countBelow(bin.upper);
+        bin.count = upTo - previous;
+        previous = upTo;
+        bins.push_back(bin);
+    }
+    return bins;
+}
@@ -0,0 +1,47 @@
+#ifndef GPADISTRIBUTION_H
+#define GPADISTRIBUTION_H
+
+#include <vector>
+#include <map>
+#include <cstddef>
+
+// 直方图的一个区间 [lower, upper)（最后一个区间包含上界）
+struct GpaBin {
+    double lower;
+    double upper;
+    size_t count;
+
+    GpaBin() : lower(0.0), upper(0.0), count(0) {}
+};
+
+// 有效绩点（不含 NaN）的分布，随增删改增量维护，支持按值求排名与按排名求值。
+// 绩点按 0.01 分桶（[0, 4] 内 401 个桶，另有低于 0 与高于 4 的两个桶），桶计数放在树状数组中；
+// 每个桶内另存精确取值及其人数，所以排名与分位数是精确的，不受分桶粒度影响。
+// 增删、排名、分位数均为 O(log 桶数 + 桶内不同取值数)，绩点为两位小数时桶内只有一个取值
+class GpaDistribution {
+private:
+    std::vector<size_t> tree;          // 树状数组（下标从 1 开始），第 i 个桶的人数
+    std::vector<std::map<double, size_t> > values; // 每个桶内：绩点 -> 人数
+    size_t total;
+
+    static size_t bucketOf(double gpa); // 单调：gpa 越大桶号不会越小
+    void update(size_t bucket, bool increase);
+    size_t prefix(size_t buckets) const; // 前 buckets 个桶的人数之和
+    size_t below(double gpa, bool inclusive) const;
+
+public:
+    GpaDistribution();
+
+    void add(double gpa);              // NaN 被忽略
+    void remove(double gpa);           // 必须是之前 add 过的值
+    void clear();
+
+    size_t size() const;               // 有效绩点人数
+    size_t countBelow(double gpa) const;  // 绩点 < gpa 的人数
+    size_t countAtMost(double gpa) const; // 绩点 <= gpa 的人数
+    double select(size_t k) const;     // 从低到高第 k 个（从 0 开始）绩点，k < size()
+    double percentile(double percent) const; // 第 percent（0~100）百分位，相邻排名间线性插值；为空时返回 NaN
+    std::vector<GpaBin> histogram(double low, double high, double width) const; // [low, high] 按 width 分组
+};
+
+#endif // GPADISTRIBUTION_H
@@ -0,0 +1,249 @@
+#include "GpaKernels.h"
+#include <limits>
+#include <cstring>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define GPAKERNELS_HAS_X86 1
+#endif
+
+const size_t GpaSummary::NPOS;
+
+GpaSummary::GpaSummary()
+    : count(0), sum(0.0), min(std::numeric_limits<double>::infinity()),
+      max(-std::numeric_limits<double>::infinity()), minRow(NPOS), maxRow(NPOS) {}
+
+namespace {
+    // 把一个向量通道（或标量部分）的结果并入 summary；最值相同时保留行号较小的一个
+    void mergeLane(GpaSummary& summary, size_t count, double sum,
+                   double min, size_t minRow, double max, size_t maxRow) {
+        summary.count += count;
+        summary.sum += sum;
+        if (minRow != GpaSummary::NPOS &&
+            (summary.minRow == GpaSummary::NPOS || min < summary.min ||
+             (min == summary.min && minRow < summary.minRow))) {
+            summary.min = min;
+            summary.minRow = minRow;
+        }
+        if (maxRow != GpaSummary::NPOS &&
+            (summary.maxRow == GpaSummary::NPOS || max > summary.max ||
+             (max == summary.max && maxRow < summary.maxRow))) {
+            summary.max = max;
+            summary.maxRow = maxRow;
+        }
+    }
+
+    // 标量实现，也用于处理向量实现剩下的不足 64 行的尾部。
+    // begin 必须是 64 的倍数，bitmap 中对应的字由这里整体写入
+    void scanScalar(const double* gpas, size_t begin, size_t n, double minGpa, uint64_t* bitmap,
+                    GpaSummary& summary) {
+        if (bitmap != nullptr && begin < n) {
+            std::memset(bitmap + begin / 64, 0, ((n - begin + 63) / 64) * sizeof(uint64_t));
+        }
+        GpaSummary part;
+        for (size_t i = begin; i < n; ++i) {
+            double x = gpas[i];
+            if (!(x >= minGpa)) continue;
+            if (bitmap != nullptr) {
+                bitmap[i / 64] |= 1ULL << (i % 64);
+            }
+            ++part.count;
+            part.sum += x;
+            if (part.minRow == GpaSummary::NPOS || x < part.min) {
+                part.min = x;
+                part.minRow = i;
+            }
+            if (part.maxRow == GpaSummary::NPOS || x > part.max) {
+                part.max = x;
+                part.maxRow = i;
+            }
+        }
+        mergeLane(summary, part.count, part.sum, part.min, part.minRow, part.max, part.maxRow);
+    }
+
+    // 向量通道的最值初值为 ±inf，取值恰好为 ±inf 的行不会被选中。
+    // 最大值为 -inf 说明满足条件的值全是 -inf，应取第一个满足条件的行（最小值同理）
+    void fixInfiniteExtremes(const double* gpas, size_t n, double minGpa, GpaSummary& summary) {
+        const double INF = std::numeric_limits<double>::infinity();
+        if (summary.count == 0 || (summary.min != INF && summary.max != -INF)) {
+            return;
+        }
+        for (size_t i = 0; i < n; ++i) {
+            if (gpas[i] >= minGpa) {
+                if (summary.min == INF) {
+                    summary.minRow = i;
+                }
+                if (summary.max == -INF) {
+                    summary.maxRow = i;
+                }
+                return;
+            }
+        }
+    }
+
+#ifdef GPAKERNELS_HAS_X86
+    // 行号以 double 保存在向量中（2^53 以内精确），-1 表示该通道没有满足条件的行
+    size_t laneRow(double row) {
+        return row < 0 ? GpaSummary::NPOS : static_cast<size_t>(row);
+    }
+
+    __attribute__((target("sse2")))
+    size_t scanSse2(const double* gpas, size_t n, double minGpa, uint64_t* bitmap,
+                    GpaSummary& summary) {
+        const double INF = std::numeric_limits<double>::infinity();
+        const __m128d threshold = _mm_set1_pd(minGpa);
+        const __m128d step = _mm_set1_pd(2.0);
+        __m128d sum = _mm_setzero_pd();
+        __m128d min = _mm_set1_pd(INF);
+        __m128d max = _mm_set1_pd(-INF);
+        __m128d minRow = _mm_set1_pd(-1.0);
+        __m128d maxRow = _mm_set1_pd(-1.0);
+        __m128d row = _mm_set_pd(1.0, 0.0);
+        __m128i count = _mm_setzero_si128();
+
+        const size_t blocks = n / 64;
+        for (size_t b = 0; b < blocks; ++b) {
+            const double* p = gpas + b * 64;
+            uint64_t word = 0;
+            for (int k = 0; k < 32; ++k) {
+                __m128d x = _mm_loadu_pd(p + 2 * k);
+                __m128d pass = _mm_cmpge_pd(x, threshold);     // NaN 比较结果为假
+                word |= static_cast<uint64_t>(_mm_movemask_pd(pass)) << (2 * k);
+                sum = _mm_add_pd(sum, _mm_and_pd(x, pass));
+                count = _mm_sub_epi64(count, _mm_castpd_si128(pass));
+                __m128d lower = _mm_and_pd(pass, _mm_cmplt_pd(x, min));
+                min = _mm_or_pd(_mm_and_pd(lower, x), _mm_andnot_pd(lower, min));
+                minRow = _mm_or_pd(_mm_and_pd(lower, row), _mm_andnot_pd(lower, minRow));
+                __m128d higher = _mm_and_pd(pass, _mm_cmpgt_pd(x, max));
+                max = _mm_or_pd(_mm_and_pd(higher, x), _mm_andnot_pd(higher, max));
+                maxRow = _mm_or_pd(_mm_and_pd(higher, row), _mm_andnot_pd(higher, maxRow));
+                row = _mm_add_pd(row, step);
+            }
+            if (bitmap != nullptr) {
+                bitmap[b] = word;
+            }
+        }
+
+        double sums[2], mins[2], maxs[2], minRows[2], maxRows[2];
+        int64_t counts[2];
+        _mm_storeu_pd(sums, sum);
+        _mm_storeu_pd(mins, min);
+        _mm_storeu_pd(maxs, max);
+        _mm_storeu_pd(minRows, minRow);
+        _mm_storeu_pd(maxRows, maxRow);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(counts), count);
+        for (int lane = 0; lane < 2; ++lane) {
+            mergeLane(summary, static_cast<size_t>(counts[lane]), sums[lane],
+                      mins[lane], laneRow(minRows[lane]), maxs[lane], laneRow(maxRows[lane]));
+        }
+        scanScalar(gpas, blocks * 64, n, minGpa, bitmap, summary);
+        fixInfiniteExtremes(gpas, n, minGpa, summary);
+        return summary.count;
+    }
+
+    __attribute__((target("avx2")))
+    size_t scanAvx2(const double* gpas, size_t n, double minGpa, uint64_t* bitmap,
+                    GpaSummary& summary) {
+        const double INF = std::numeric_limits<double>::infinity();
+        const __m256d threshold = _mm256_set1_pd(minGpa);
+        const __m256d step = _mm256_set1_pd(4.0);
+        __m256d sum = _mm256_setzero_pd();
+        __m256d min = _mm256_set1_pd(INF);
+        __m256d max = _mm256_set1_pd(-INF);
+        __m256d minRow = _mm256_set1_pd(-1.0);
+        __m256d maxRow = _mm256_set1_pd(-1.0);
+        __m256d row = _mm256_set_pd(3.0, 2.0, 1.0, 0.0);
+        __m256i count = _mm256_setzero_si256();
+
+        const size_t blocks = n / 64;
+        for (size_t b = 0; b < blocks; ++b) {
+            const double* p = gpas + b * 64;
+            uint64_t word = 0;
+            for (int k = 0; k < 16; ++k) {
+                __m256d x = _mm256_loadu_pd(p + 4 * k);
+                __m256d pass = _mm256_cmp_pd(x, threshold, _CMP_GE_OQ);   // NaN 比较结果为假
+                word |= static_cast<uint64_t>(_mm256_movemask_pd(pass)) << (4 * k);
+                sum = _mm256_add_pd(sum, _mm256_and_pd(x, pass));
+                count = _mm256_sub_epi64(count, _mm256_castpd_si256(pass));
+                __m256d lower = _mm256_and_pd(pass, _mm256_cmp_pd(x, min, _CMP_LT_OQ));
+                min = _mm256_blendv_pd(min, x, lower);
+                minRow = _mm256_blendv_pd(minRow, row, lower);
+                __m256d higher = _mm256_and_pd(pass, _mm256_cmp_pd(x, max, _CMP_GT_OQ));
+                max = _mm256_blendv_pd(max, x, higher);
+                maxRow = _mm256_blendv_pd(maxRow, row, higher);
+                row = _mm256_add_pd(row, step);
+            }
+            if (bitmap != nullptr) {
+                bitmap[b] = word;
+            }
+        }
+
+        double sums[4], mins[4], maxs[4], minRows[4], maxRows[4];
+        int64_t counts[4];
+        _mm256_storeu_pd(sums, sum);
+        _mm256_storeu_pd(mins, min);
+        _mm256_storeu_pd(maxs, max);
+        _mm256_storeu_pd(minRows, minRow);
+        _mm256_storeu_pd(maxRows, maxRow);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(counts), count);
+        for (int lane = 0; lane < 4; ++lane) {
+            mergeLane(summary, static_cast<size_t>(counts[lane]), sums[lane],
+                      mins[lane], laneRow(minRows[lane]), maxs[lane], laneRow(maxRows[lane]));
+        }
+        scanScalar(gpas, blocks * 64, n, minGpa, bitmap, summary);
+        fixInfiniteExtremes(gpas, n, minGpa, summary);
+        return summary.count;
+    }
+#endif
+
+    GpaKernels::Isa detectIsa() {
+#ifdef GPAKERNELS_HAS_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) {
+            return GpaKernels::ISA_AVX2;
+        }
+        if (__builtin_cpu_supports("sse2")) {
+            return GpaKernels::ISA_SSE2;
+        }
+#endif
+        return GpaKernels::ISA_SCALAR;
+    }
+}
+
+GpaKernels::Isa GpaKernels::bestIsa() {
+    static const Isa isa = detectIsa();
+    return isa;
+}
+
+const char* GpaKernels::isaName(Isa isa) {
+    switch (isa) {
+        case ISA_AVX2: return "AVX2";
+        case ISA_SSE2: return "SSE2";
+        default: return "标量";
+    }
+}
+
+size_t GpaKernels::scan(const double* gpas, size_t n, double minGpa, uint64_t* bitmap,
+                        GpaSummary& summary) {
+    return scanWith(bestIsa(), gpas, n, minGpa, bitmap, summary);
+}
+
+size_t GpaKernels::scanWith(Isa isa, const double* gpas, size_t n, double minGpa, uint64_t* bitmap,
+                            GpaSummary& summary) {
+    summary = GpaSummary();
+#ifdef GPAKERNELS_HAS_X86
+    if (isa > bestIsa()) {
+        isa = bestIsa();
+    }
+    if (isa == ISA_AVX2) {
+        return scanAvx2(gpas, n, minGpa, bitmap, summary);
+    }
+    if (isa == ISA_SSE2) {
+        return scanSse2(gpas, n, minGpa, bitmap, summary);
+    }
+#else
+    (void)isa;
+#endif
+    scanScalar(gpas, 0, n, minGpa, bitmap, summary);
+    return summary.count;
+}
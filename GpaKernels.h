@@ -0,0 +1,45 @@
+#ifndef GPAKERNELS_H
+#define GPAKERNELS_H
+
+#include <cstddef>
+#include <stdint.h>
+
+// 一次扫描的统计结果（只统计满足 gpa >= 阈值 的行）
+struct GpaSummary {
+    size_t count;                      // 满足条件的行数
+    double sum;                        // 绩点之和
+    double min;                        // 最低绩点
+    double max;                        // 最高绩点
+    size_t minRow;                     // 最低绩点所在行（相同时取靠前的行），没有满足条件的行时为 NPOS
+    size_t maxRow;                     // 最高绩点所在行（相同时取靠前的行）
+
+    static const size_t NPOS = static_cast<size_t>(-1);
+
+    GpaSummary();
+};
+
+// 绩点列的扫描内核：一次遍历同时得到筛选位图、行数、总和、最小值与最大值。
+// 绩点为 NaN 的行（已删除的槽位）不满足任何条件。
+// 运行时按 CPU 支持的指令集选择 AVX2 / SSE2 / 标量实现
+class GpaKernels {
+public:
+    enum Isa {
+        ISA_SCALAR,
+        ISA_SSE2,
+        ISA_AVX2
+    };
+
+    static Isa bestIsa();              // 当前 CPU 可用的最佳实现
+    static const char* isaName(Isa isa);
+
+    // 扫描 gpas[0, n)：bitmap 不为空时按行写入筛选结果（共 (n + 63) / 64 个字，第 i 行为
+    // bitmap[i / 64] 的第 i % 64 位），返回满足条件的行数
+    static size_t scan(const double* gpas, size_t n, double minGpa, uint64_t* bitmap,
+                       GpaSummary& summary);
+
+    // 使用指定实现扫描（用于基准测试；CPU 不支持时退回标量实现）
+    static size_t scanWith(Isa isa, const double* gpas, size_t n, double minGpa, uint64_t* bitmap,
+                           GpaSummary& summary);
+};
+
+#endif // GPAKERNELS_H
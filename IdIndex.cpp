@@ -0,0 +1,117 @@
+#include "IdIndex.h"
+#include <stdint.h>
+
+namespace {
+    const size_t MIN_CAPACITY = 16;
+
+    // 负载因子上限为 0.7
+    bool overLoaded(size_t count, size_t capacity) {
+        return count * 10 >= capacity * 7;
+    }
+}
+
+IdIndex::IdIndex() : count(0), mask(0) {}
+
+// Fibonacci 散列：相邻学号也能均匀分布到各个桶
+size_t IdIndex::bucketOf(int id) const {
+    uint64_t h = static_cast<uint64_t>(static_cast<uint32_t>(id)) * 0x9E3779B97F4A7C15ULL;
+    return static_cast<size_t>(h >> 32) & mask;
+}
+
+void IdIndex::rehash(size_t newCapacity) {
+    std::vector<Entry> old;
+    old.swap(table);
+
+    Entry empty = { 0, -1 };
+    table.assign(newCapacity, empty);
+    mask = newCapacity - 1;
+
+    for (size_t i = 0; i < old.size(); ++i) {
+        if (old[i].slot < 0) continue;
+        size_t pos = bucketOf(old[i].key);
+        while (table[pos].slot >= 0) {
+            pos = (pos + 1) & mask;
+        }
+        table[pos] = old[i];
+    }
+}
+
+int IdIndex::find(int id) const {
+    if (count == 0) {
+        return -1;
+    }
+    size_t pos = bucketOf(id);
+    while (table[pos].slot >= 0) {
+        if (table[pos].key == id) {
+            return table[pos].slot;
+        }
+        pos = (pos + 1) & mask;
+    }
+    return -1;
+}
+
+bool IdIndex::insert(int id, int slot) {
+    if (table.empty() || overLoaded(count + 1, table.size())) {
+        rehash(table.empty() ? MIN_CAPACITY : table.size() * 2);
+    }
+    size_t pos = bucketOf(id);
+    while (table[pos].slot >= 0) {
+        if (table[pos].key == id) {
+            return false;
+        }
+        pos = (pos + 1) & mask;
+    }
+    table[pos].key = id;
+    table[pos].slot = slot;
+    ++count;
+    return true;
+}
+
+// 删除时使用向后移位，避免墓碑标记拖慢后续查找
+bool IdIndex::erase(int id) {
+    if (count == 0) {
+        return false;
+    }
+    size_t pos = bucketOf(id);
+    while (table[pos].slot >= 0 && table[pos].key != id) {
+        pos = (pos + 1) & mask;
+    }
+    if (table[pos].slot < 0) {
+        return false;
+    }
+
+    size_t hole = pos;
+    size_t next = (hole + 1) & mask;
+    while (table[next].slot >= 0) {
+        size_t home = bucketOf(table[next].key);
+        // 只有当 next 的初始桶不在 (hole, next] 区间内时，才能前移填洞
+        if (((next - home) & mask) >= ((next - hole) & mask)) {
+            table[hole] = table[next];
+            hole = next;
+        }
+        next = (next + 1) & mask;
+    }
+    table[hole].slot = -1;
+    --count;
+    return true;
+}
+
+void IdIndex::clear() {
+    table.clear();
+    count = 0;
+    mask = 0;
+}
+
+void IdIndex::reserve(size_t n) {
+    size_t capacity = table.empty() ? MIN_CAPACITY : table.size();
+    while (overLoaded(n, capacity)) {
+        capacity *= 2;
+    }
+    if (capacity > table.size()) {
+        rehash(capacity);
+    }
+}
+
+size_t IdIndex::size() const {
+    return count;
+}
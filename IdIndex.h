@@ -0,0 +1,34 @@
+#ifndef IDINDEX_H
+#define IDINDEX_H
+
+#include <vector>
+#include <cstddef>
+
+// 学号 -> 存储位置 的开放寻址哈希索引（线性探测）
+// 查找、插入、删除的期望时间复杂度均为 O(1)
+class IdIndex {
+private:
+    struct Entry {
+        int key;                       // 学号
+        int slot;                      // 在学生容器中的下标，-1 表示空桶
+    };
+
+    std::vector<Entry> table;          // 哈希桶数组，容量始终为2的幂
+    size_t count;                      // 已存储的条目数
+    size_t mask;                       // 容量 - 1
+
+    size_t bucketOf(int id) const;     // 计算学号的初始桶位置
+    void rehash(size_t newCapacity);   // 扩容并重新散列
+
+public:
+    IdIndex();
+
+    int find(int id) const;            // 查找学号对应的位置，不存在返回 -1
+    bool insert(int id, int slot);     // 插入新条目，学号已存在时返回 false
+    bool erase(int id);                // 删除条目，不存在时返回 false
+    void clear();                      // 清空索引
+    void reserve(size_t n);            // 预留至少 n 个条目的空间
+    size_t size() const;               // 条目数
+};
+
+#endif // IDINDEX_H
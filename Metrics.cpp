@@ -0,0 +1,380 @@
+#include "Metrics.h"
+#include <sstream>
+#include <iomanip>
+#include <algorithm>
+
+namespace {
+    const char* const OPERATION_NAMES[METRIC_OPERATIONS] = {
+        "add", "delete", "update", "import", "find", "list", "search_name", "search_major",
+        "filter_gpa", "range", "query", "statistics", "sort", "index_build", "save", "load"
+    };
+
+    // Prometheus 直方图的区间上界（秒）。HDR 分组按其最大值归入，与上界不对齐的组会计入下一个区间
+    const double PROMETHEUS_BOUNDS[] = {
+        1e-6, 5e-6, 1e-5, 5e-5, 1e-4, 5e-4, 1e-3, 5e-3, 1e-2, 5e-2, 0.1, 0.5, 1.0, 5.0, 10.0
+    };
+
+    // 按量级选单位显示耗时，如 "850ns"、"12.5us"、"3.20ms"
+    std::string formatNanos(double nanos) {
+        std::ostringstream text;
+        text << std::fixed;
+        if (nanos < 1e3) {
+            text << std::setprecision(0) << nanos << "ns";
+        } else if (nanos < 1e6) {
+            text << std::setprecision(1) << nanos / 1e3 << "us";
+        } else if (nanos < 1e9) {
+            text << std::setprecision(2) << nanos / 1e6 << "ms";
+        } else {
+            text << std::setprecision(2) << nanos / 1e9 << "s";
+        }
+        return text.str();
+    }
+}
+
+// ========== LatencyHistogram ==========
+
+size_t LatencyHistogram::bucketOf(uint64_t nanos) {
+    if (nanos < SUB_BUCKETS) {
+        return static_cast<size_t>(nanos);
+    }
+    size_t exponent = 63 - static_cast<size_t>(__builtin_clzll(nanos)); // >= 4
+    size_t bucket = (exponent - 3) * SUB_BUCKETS + static_cast<size_t>((nanos >> (exponent - 4)) & (SUB_BUCKETS - 1));
+    return std::min(bucket, BUCKETS - 1);
+}
+
+uint64_t LatencyHistogram::bucketLower(size_t bucket) {
+    if (bucket < SUB_BUCKETS) {
+        return bucket;
+    }
+    size_t exponent = bucket / SUB_BUCKETS + 3;
+    return static_cast<uint64_t>(SUB_BUCKETS + bucket % SUB_BUCKETS) << (exponent - 4);
+}
+
+uint64_t LatencyHistogram::bucketUpper(size_t bucket) {
+    if (bucket < SUB_BUCKETS) {
+        return bucket;
+    }
+    size_t exponent = bucket / SUB_BUCKETS + 3;
+    return bucketLower(bucket) + (static_cast<uint64_t>(1) << (exponent - 4)) - 1;
+}
+
+uint64_t LatencyHistogram::count() const {
+    uint64_t total = 0;
+    for (size_t i = 0; i < counts.size(); ++i) {
+        total += counts[i];
+    }
+    return total;
+}
+
+double LatencyHistogram::meanNanos() const {
+    uint64_t n = count();
+    return n == 0 ? 0.0 : static_cast<double>(totalNanos) / n;
+}
+
+uint64_t LatencyHistogram::percentileNanos(double percent) const {
+    uint64_t n = count();
+    if (n == 0) {
+        return 0;
+    }
+    percent = std::max(0.0, std::min(100.0, percent));
+    // 第 rank 次（从 1 开始）记录所在的组
+    uint64_t rank = static_cast<uint64_t>(percent / 100.0 * n + 0.5);
+    rank = std::max<uint64_t>(1, std::min(rank, n));
+    uint64_t seen = 0;
+    for (size_t i = 0; i < counts.size(); ++i) {
+        seen += counts[i];
+        if (seen >= rank) {
+            return std::min(bucketUpper(i), maxNanos);
+        }
+    }
+    return maxNanos;
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other) {
+    for (size_t i = 0; i < counts.size(); ++i) {
+        counts[i] += other.counts[i];
+    }
+    totalNanos += other.totalNanos;
+    maxNanos = std::max(maxNanos, other.maxNanos);
+}
+
+// ========== MetricsSnapshot ==========
+
+void MetricsSnapshot::merge(const MetricsSnapshot& other) {
+    enabled = enabled || other.enabled;
+    for (size_t op = 0; op < METRIC_OPERATIONS; ++op) {
+        operations[op].merge(other.operations[op]);
+    }
+    bytesRead += other.bytesRead;
+    bytesWritten += other.bytesWritten;
+}
+
+void MetricsSnapshot::display(std::ostream& out) const {
+    std::ostringstream text;
+    text << "\n========== 运行指标 ==========\n";
+    if (!enabled) {
+        text << "编译时已关闭运行指标（STUDENT_NO_METRICS）。\n";
+        out << text.str();
+        return;
+    }
+    // 每个汉字占 3 个字节、2 列宽，表头的宽度按字节数补足
+    text << std::left << std::setw(16) << "操作" << std::right
+         << std::setw(12) << "次数" << std::setw(12) << "平均" << std::setw(10) << "P50"
+         << std::setw(10) << "P99" << std::setw(12) << "最长" << std::setw(15) << "总耗时" << "\n";
+    text << std::string(76, '-') << "\n";
+    bool any = false;
+    for (size_t op = 0; op < METRIC_OPERATIONS; ++op) {
+        const LatencyHistogram& histogram = operations[op];
+        uint64_t count = histogram.count();
+        if (count == 0) {
+            continue;
+        }
+        any = true;
+        text << std::left << std::setw(14) << Metrics::operationName(static_cast<MetricOperation>(op))
+             << std::right << std::setw(10) << count
+             << std::setw(10) << formatNanos(histogram.meanNanos())
+             << std::setw(10) << formatNanos(static_cast<double>(histogram.percentileNanos(50)))
+             << std::setw(10) << formatNanos(static_cast<double>(histogram.percentileNanos(99)))
+             << std::setw(10) << formatNanos(static_cast<double>(histogram.maxNanos))
+             << std::setw(12) << formatNanos(static_cast<double>(histogram.totalNanos)) << "\n";
+    }
+    if (!any) {
+        text << "尚无记录。\n";
+    }
+    text << std::string(76, '-') << "\n";
+    text << "数据文件读取：" << bytesRead << " 字节，写出：" << bytesWritten << " 字节\n";
+    out << text.str();
+}
+
+void MetricsSnapshot::writePrometheus(std::ostream& out) const {
+    std::ostringstream text;
+    text << "# HELP student_manager_operation_duration_seconds Latency of StudentManager operations.\n";
+    text << "# TYPE student_manager_operation_duration_seconds histogram\n";
+    const size_t boundCount = sizeof(PROMETHEUS_BOUNDS) / sizeof(PROMETHEUS_BOUNDS[0]);
+    for (size_t op = 0; op < METRIC_OPERATIONS; ++op) {
+        const LatencyHistogram& histogram = operations[op];
+        std::string label = std::string("operation=\"") +
+                            Metrics::operationName(static_cast<MetricOperation>(op)) + "\"";
+        uint64_t cumulative = 0;
+        size_t bucket = 0;
+        for (size_t b = 0; b < boundCount; ++b) {
+            uint64_t limit = static_cast<uint64_t>(PROMETHEUS_BOUNDS[b] * 1e9);
+            while (bucket < histogram.counts.size() && LatencyHistogram::bucketUpper(bucket) <= limit) {
+                cumulative += histogram.counts[bucket++];
+            }
+            text << "student_manager_operation_duration_seconds_bucket{" << label
+                 << ",le=\"" << PROMETHEUS_BOUNDS[b] << "\"} " << cumulative << "\n";
+        }
+        uint64_t count = histogram.count();
+        text << "student_manager_operation_duration_seconds_bucket{" << label << ",le=\"+Inf\"} " << count << "\n";
+        text << "student_manager_operation_duration_seconds_sum{" << label << "} "
+             << std::setprecision(9) << histogram.totalNanos / 1e9 << std::setprecision(6) << "\n";
+        text << "student_manager_operation_duration_seconds_count{" << label << "} " << count << "\n";
+    }
+    text << "# HELP student_manager_file_read_bytes_total Bytes of data files read by loadFromFile.\n";
+    text << "# TYPE student_manager_file_read_bytes_total counter\n";
+    text << "student_manager_file_read_bytes_total " << bytesRead << "\n";
+    text << "# HELP student_manager_file_written_bytes_total Bytes of data files written by saveToFile.\n";
+    text << "# TYPE student_manager_file_written_bytes_total counter\n";
+    text << "student_manager_file_written_bytes_total " << bytesWritten << "\n";
+    out << text.str();
+}
+
+// ========== Metrics ==========
+
+const char* Metrics::operationName(MetricOperation op) {
+    return op < METRIC_OPERATIONS ? OPERATION_NAMES[op] : "unknown";
+}
+
+#ifdef STUDENT_NO_METRICS
+
+Metrics::Metrics() {}
+Metrics::~Metrics() {}
+
+MetricsSnapshot Metrics::snapshot() const {
+    return MetricsSnapshot();
+}
+
+void Metrics::reset() {}
+
+#else
+
+namespace {
+    // 前 15 个槽位由线程独占，最后一个由其余线程共用（Metrics::SLOTS 为 16）
+    const size_t EXCLUSIVE_SLOTS = 15;
+    std::atomic<bool> slotTaken[EXCLUSIVE_SLOTS];
+
+    // 线程第一次记录时领取一个空闲的独占槽位，线程退出时归还；没有空闲槽位时使用共用槽位。
+    // 槽位编号对所有 Metrics 实例通用：一个线程在每个实例中都写同一个编号的槽位
+    struct ThreadSlot {
+        size_t index;
+
+        ThreadSlot() : index(EXCLUSIVE_SLOTS) {
+            for (size_t i = 0; i < EXCLUSIVE_SLOTS; ++i) {
+                bool expected = false;
+                if (!slotTaken[i].load(std::memory_order_relaxed) &&
+                    slotTaken[i].compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+                    index = i;
+                    break;
+                }
+            }
+        }
+
+        ~ThreadSlot() {
+            if (index < EXCLUSIVE_SLOTS) {
+                slotTaken[index].store(false, std::memory_order_release);
+            }
+        }
+    };
+
+    thread_local ThreadSlot threadSlot;
+
+    // 独占槽位只有一个写者，普通的读改写即可；共用槽位用原子加
+    void add(std::atomic<uint64_t>& counter, uint64_t value, bool exclusive) {
+        if (exclusive) {
+            counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+        } else {
+            counter.fetch_add(value, std::memory_order_relaxed);
+        }
+    }
+
+    // 时钟读数与纳秒的换算比例：用 steady_clock 计量一段约 200 微秒的忙等
+    double calibrateNanosPerTick() {
+#ifdef METRICS_USE_TSC
+        std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+        uint64_t firstTick = Metrics::ticks();
+        std::chrono::steady_clock::time_point end;
+        do {
+            end = std::chrono::steady_clock::now();
+        } while (end - begin < std::chrono::microseconds(200));
+        uint64_t lastTick = Metrics::ticks();
+        double nanos = std::chrono::duration<double, std::nano>(end - begin).count();
+        return lastTick > firstTick ? nanos / static_cast<double>(lastTick - firstTick) : 1.0;
+#else
+        return 1.0;
+#endif
+    }
+
+    double nanosPerTick() {
+        static const double scale = calibrateNanosPerTick();
+        return scale;
+    }
+}
+
+// 一个槽位的全部计数。前后留出一个缓存行，相邻分配的槽位不会共用缓存行
+struct Metrics::Slot {
+    char leading[64];
+    std::atomic<uint64_t> counts[METRIC_OPERATIONS][LatencyHistogram::BUCKETS];
+    std::atomic<uint64_t> totalNanos[METRIC_OPERATIONS];
+    std::atomic<uint64_t> maxNanos[METRIC_OPERATIONS];
+    std::atomic<uint64_t> bytesRead;
+    std::atomic<uint64_t> bytesWritten;
+    char trailing[64];
+
+    Slot() {
+        clear();
+    }
+
+    void clear() {
+        for (size_t op = 0; op < METRIC_OPERATIONS; ++op) {
+            for (size_t b = 0; b < LatencyHistogram::BUCKETS; ++b) {
+                counts[op][b].store(0, std::memory_order_relaxed);
+            }
+            totalNanos[op].store(0, std::memory_order_relaxed);
+            maxNanos[op].store(0, std::memory_order_relaxed);
+        }
+        bytesRead.store(0, std::memory_order_relaxed);
+        bytesWritten.store(0, std::memory_order_relaxed);
+    }
+};
+
+Metrics::Metrics() {
+    for (size_t i = 0; i < SLOTS; ++i) {
+        slots[i].store(nullptr, std::memory_order_relaxed);
+    }
+    nanosPerTick(); // 校准放在构造时，不计入第一次操作的耗时
+}
+
+Metrics::~Metrics() {
+    for (size_t i = 0; i < SLOTS; ++i) {
+        delete slots[i].load(std::memory_order_relaxed);
+    }
+}
+
+// 第 index 个槽位，第一次使用时分配；两个线程同时分配共用槽位时只保留先装入的
+Metrics::Slot& Metrics::slotFor(size_t index) {
+    std::atomic<Slot*>& entry = slots[index];
+    Slot* slot = entry.load(std::memory_order_acquire);
+    if (slot == nullptr) {
+        Slot* created = new Slot();
+        if (entry.compare_exchange_strong(slot, created, std::memory_order_acq_rel)) {
+            slot = created;
+        } else {
+            delete created;
+        }
+    }
+    return *slot;
+}
+
+void Metrics::record(MetricOperation op, uint64_t elapsedTicks) {
+    size_t index = threadSlot.index;
+    bool exclusive = index < EXCLUSIVE_SLOTS;
+    Slot& slot = slotFor(index);
+    uint64_t nanos = static_cast<uint64_t>(static_cast<double>(elapsedTicks) * nanosPerTick());
+    add(slot.counts[op][LatencyHistogram::bucketOf(nanos)], 1, exclusive);
+    add(slot.totalNanos[op], nanos, exclusive);
+    uint64_t longest = slot.maxNanos[op].load(std::memory_order_relaxed);
+    if (exclusive) {
+        if (nanos > longest) {
+            slot.maxNanos[op].store(nanos, std::memory_order_relaxed);
+        }
+        return;
+    }
+    while (nanos > longest &&
+           !slot.maxNanos[op].compare_exchange_weak(longest, nanos, std::memory_order_relaxed)) {
+    }
+}
+
+void Metrics::addBytesRead(uint64_t bytes) {
+    size_t index = threadSlot.index;
+    add(slotFor(index).bytesRead, bytes, index < EXCLUSIVE_SLOTS);
+}
+
+void Metrics::addBytesWritten(uint64_t bytes) {
+    size_t index = threadSlot.index;
+    add(slotFor(index).bytesWritten, bytes, index < EXCLUSIVE_SLOTS);
+}
+
+MetricsSnapshot Metrics::snapshot() const {
+    MetricsSnapshot result;
+    result.enabled = true;
+    for (size_t i = 0; i < SLOTS; ++i) {
+        const Slot* slot = slots[i].load(std::memory_order_acquire);
+        if (slot == nullptr) {
+            continue;
+        }
+        for (size_t op = 0; op < METRIC_OPERATIONS; ++op) {
+            LatencyHistogram& histogram = result.operations[op];
+            for (size_t b = 0; b < LatencyHistogram::BUCKETS; ++b) {
+                histogram.counts[b] += slot->counts[op][b].load(std::memory_order_relaxed);
+            }
+            histogram.totalNanos += slot->totalNanos[op].load(std::memory_order_relaxed);
+            histogram.maxNanos = std::max(histogram.maxNanos, slot->maxNanos[op].load(std::memory_order_relaxed));
+        }
+        result.bytesRead += slot->bytesRead.load(std::memory_order_relaxed);
+        result.bytesWritten += slot->bytesWritten.load(std::memory_order_relaxed);
+    }
+    return result;
+}
+
+// 与记录同时进行时，正在进行的记录可能覆盖清零的结果
+void Metrics::reset() {
+    for (size_t i = 0; i < SLOTS; ++i) {
+        Slot* slot = slots[i].load(std::memory_order_acquire);
+        if (slot != nullptr) {
+            slot->clear();
+        }
+    }
+}
+
+#endif // STUDENT_NO_METRICS
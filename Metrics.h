@@ -0,0 +1,151 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <vector>
+#include <string>
+#include <ostream>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+
+#if !defined(STUDENT_NO_METRICS) && (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#include <x86intrin.h>
+#define METRICS_USE_TSC 1
+#endif
+
+// 记录耗时的操作类别
+enum MetricOperation {
+    METRIC_ADD,                        // addStudent
+    METRIC_DELETE,                     // deleteStudent
+    METRIC_UPDATE,                     // updateStudent
+    METRIC_IMPORT,                     // addStudents / importFrom
+    METRIC_FIND,                       // findStudent 等按学号查找
+    METRIC_LIST,                       // 按显示顺序列出全部学生
+    METRIC_SEARCH_NAME,                // 按姓名搜索
+    METRIC_SEARCH_MAJOR,               // 按专业筛选
+    METRIC_FILTER_GPA,                 // 按最低绩点筛选
+    METRIC_RANGE,                      // 有序索引上的区间与前 k 名查询
+    METRIC_QUERY,                      // 组合查询
+    METRIC_STATISTICS,                 // 统计与绩点分布
+    METRIC_SORT,                       // 切换显示顺序
+    METRIC_INDEX_BUILD,                // 按需建立有序索引或姓名索引（耗时同时计入触发它的操作）
+    METRIC_SAVE,                       // saveToFile
+    METRIC_LOAD,                       // loadFromFile
+    METRIC_OPERATIONS
+};
+
+// 一类操作的调用次数与耗时分布（纳秒）。
+// 耗时按 HDR 直方图的方式分组：小于 16 ns 每纳秒一组，之后每个 2 的幂区间等分为 16 组，
+// 各组宽度不超过其下界的 1/16，所以分位数的相对误差不超过 6.25%；超过约 137 秒的计入最后一组
+struct LatencyHistogram {
+    static const size_t SUB_BUCKETS = 16;
+    static const size_t BUCKETS = SUB_BUCKETS * 34;
+
+    std::vector<uint64_t> counts;      // 每组的次数
+    uint64_t totalNanos;               // 耗时总和
+    uint64_t maxNanos;                 // 最长的一次
+
+    LatencyHistogram() : counts(BUCKETS, 0), totalNanos(0), maxNanos(0) {}
+
+    static size_t bucketOf(uint64_t nanos);
+    static uint64_t bucketLower(size_t bucket); // 该组的最小值
+    static uint64_t bucketUpper(size_t bucket); // 该组的最大值
+
+    uint64_t count() const;            // 调用次数
+    double meanNanos() const;
+    uint64_t percentileNanos(double percent) const; // 所在组的最大值（不超过 maxNanos），没有记录时为 0
+    void merge(const LatencyHistogram& other);
+};
+
+// 某一时刻的全部指标（见 Metrics::snapshot），可以相加合并多个实例的结果
+struct MetricsSnapshot {
+    bool enabled;                      // 编译时关闭指标时为 false，其余字段都为 0
+    LatencyHistogram operations[METRIC_OPERATIONS];
+    uint64_t bytesRead;                // loadFromFile 读取的数据文件字节数
+    uint64_t bytesWritten;             // saveToFile 写出的数据文件字节数
+
+    MetricsSnapshot() : enabled(false), bytesRead(0), bytesWritten(0) {}
+
+    void merge(const MetricsSnapshot& other);
+    void display(std::ostream& out) const;          // 以表格显示有调用的操作
+    void writePrometheus(std::ostream& out) const;  // Prometheus 文本格式
+};
+
+// 运行指标：各类操作的调用次数、耗时分布与数据文件读写字节数，可由多个线程同时记录。
+// 每个线程第一次记录时独占一个槽位（线程退出时归还），只有它写这个槽位，计数用普通的读改写，
+// 不需要带锁前缀的原子指令；同时记录的线程超过 15 个时，其余线程共用最后一个槽位并改用原子加。
+// 读取时把各槽位相加。计时在 x86 上读时间戳计数器（比 steady_clock 便宜得多），首次使用时按 steady_clock 校准。
+// 编译时定义 STUDENT_NO_METRICS 后，记录函数和 OperationTimer 都是空的内联函数，不读时钟也不写内存
+class Metrics {
+private:
+#ifndef STUDENT_NO_METRICS
+    struct Slot;
+
+    static const size_t SLOTS = 16;
+    std::atomic<Slot*> slots[SLOTS];   // 按需分配
+
+    Slot& slotFor(size_t index);
+#endif
+
+public:
+    Metrics();
+    ~Metrics();
+    Metrics(const Metrics&) = delete;
+    Metrics& operator=(const Metrics&) = delete;
+
+#ifndef STUDENT_NO_METRICS
+    static bool enabled() { return true; } // 编译时是否启用
+#else
+    static bool enabled() { return false; }
+#endif
+    static const char* operationName(MetricOperation op); // 如 "search_name"
+
+    MetricsSnapshot snapshot() const;  // 合并各槽位；与记录同时进行时结果可能差几次尚未完成的记录
+    void reset();
+
+#ifndef STUDENT_NO_METRICS
+    // 计时用的时钟读数，单位由平台决定，只能相减后交给 record
+    static uint64_t ticks() {
+#ifdef METRICS_USE_TSC
+        return __rdtsc();
+#else
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+    }
+
+    void record(MetricOperation op, uint64_t elapsedTicks);
+    void addBytesRead(uint64_t bytes);
+    void addBytesWritten(uint64_t bytes);
+#else
+    void record(MetricOperation, uint64_t) {}
+    void addBytesRead(uint64_t) {}
+    void addBytesWritten(uint64_t) {}
+#endif
+};
+
+// 作用域计时：析构时把经过的时间记入 metrics
+class OperationTimer {
+#ifndef STUDENT_NO_METRICS
+private:
+    Metrics& metrics;
+    MetricOperation op;
+    uint64_t start;
+
+public:
+    OperationTimer(Metrics& metrics, MetricOperation op)
+        : metrics(metrics), op(op), start(Metrics::ticks()) {}
+    ~OperationTimer() {
+        metrics.record(op, Metrics::ticks() - start);
+    }
+#else
+public:
+    OperationTimer(Metrics&, MetricOperation) {}
+#endif
+
+    OperationTimer(const OperationTimer&) = delete;
+    OperationTimer& operator=(const OperationTimer&) = delete;
+};
+
+#endif // METRICS_H
@@ -0,0 +1,195 @@
+#include "NameIndex.h"
+#include <algorithm>
+
+namespace {
+    // 失效条目达到该值且超过有效条目时清理倒排表
+    const size_t PURGE_MIN_STALE = 4096;
+
+    // 按 UTF-8 解码为码点。不合法的字节单独作为一个字符，
+    // 映射到 0x110000 以上（不与任何合法码点冲突，仍在 21 位以内）
+    void decodeUtf8(StringView text, std::vector<uint32_t>& out) {
+        out.clear();
+        const unsigned char* p = reinterpret_cast<const unsigned char*>(text.data());
+        const unsigned char* end = p + text.size();
+        while (p < end) {
+            unsigned char lead = *p;
+            size_t length = lead < 0x80 ? 1 : (lead >> 5) == 0x6 ? 2 : (lead >> 4) == 0xE ? 3 : (lead >> 3) == 0x1E ? 4 : 0;
+            bool valid = length != 0 && static_cast<size_t>(end - p) >= length;
+            uint32_t cp = length == 1 ? lead : length == 2 ? (lead & 0x1F) : length == 3 ? (lead & 0x0F) : (lead & 0x07);
+            for (size_t i = 1; valid && i < length; ++i) {
+                valid = (p[i] & 0xC0) == 0x80;
+                cp = (cp << 6) | (p[i] & 0x3F);
+            }
+            if (!valid) {
+                out.push_back(0x110000 + lead);
+                ++p;
+                continue;
+            }
+            out.push_back(cp);
+            p += length;
+        }
+    }
+
+    // n 个码点拼成一个键，每个码点占 21 位
+    uint64_t gramKey(const uint32_t* cps, size_t n) {
+        uint64_t key = 0;
+        for (size_t i = 0; i < n; ++i) {
+            key = (key << 21) | cps[i];
+        }
+        return key;
+    }
+
+    // 姓名中出现的 1、2、3 字片段（每种长度内去重）
+    void gramsOf(StringView name, std::vector<uint64_t> keys[3]) {
+        std::vector<uint32_t> cps;
+        decodeUtf8(name, cps);
+        for (size_t n = 1; n <= 3; ++n) {
+            std::vector<uint64_t>& bucket = keys[n - 1];
+            bucket.clear();
+            for (size_t i = 0; i + n <= cps.size(); ++i) {
+                bucket.push_back(gramKey(&cps[i], n));
+            }
+            std::sort(bucket.begin(), bucket.end());
+            bucket.erase(std::unique(bucket.begin(), bucket.end()), bucket.end());
+        }
+    }
+}
+
+NameIndex::NameIndex(const StudentTable& table)
+    : table(table), liveEntries(0), staleEntries(0), built(false) {}
+
+bool NameIndex::isBuilt() const {
+    return built;
+}
+
+bool NameIndex::isLive(const Posting& posting) const {
+    return posting.version == versions[posting.row];
+}
+
+size_t NameIndex::addGrams(int row) {
+    std::vector<uint64_t> keys[3];
+    gramsOf(table.nameColumn()[row], keys);
+    if (static_cast<size_t>(row) >= versions.size()) {
+        versions.resize(row + 1, 0);
+    }
+    Posting posting = { row, versions[row] };
+    size_t added = 0;
+    for (size_t n = 0; n < 3; ++n) {
+        for (size_t i = 0; i < keys[n].size(); ++i) {
+            grams[n][keys[n][i]].push_back(posting);
+        }
+        added += keys[n].size();
+    }
+    return added;
+}
+
+size_t NameIndex::countGrams(int row) const {
+    std::vector<uint64_t> keys[3];
+    gramsOf(table.nameColumn()[row], keys);
+    return keys[0].size() + keys[1].size() + keys[2].size();
+}
+
+void NameIndex::build(const std::vector<size_t>& rows) {
+    reset();
+    versions.assign(table.size(), 0);
+    for (size_t i = 0; i < rows.size(); ++i) {
+        liveEntries += addGrams(static_cast<int>(rows[i]));
+    }
+    built = true;
+}
+
+void NameIndex::reset() {
+    for (size_t n = 0; n < 3; ++n) {
+        grams[n].clear();
+    }
+    versions.clear();
+    liveEntries = 0;
+    staleEntries = 0;
+    built = false;
+}
+
+void NameIndex::insert(int row) {
+    if (built) {
+        liveEntries += addGrams(row);
+    }
+}
+
+void NameIndex::erase(int row) {
+    if (!built) {
+        return;
+    }
+    size_t count = countGrams(row);
+    liveEntries -= count;
+    staleEntries += count;
+    ++versions[row];
+    if (staleEntries >= PURGE_MIN_STALE && staleEntries > liveEntries) {
+        purge();
+    }
+}
+
+void NameIndex::purge() {
+    for (size_t n = 0; n < 3; ++n) {
+        for (GramMap::iterator it = grams[n].begin(); it != grams[n].end(); ) {
+            std::vector<Posting>& list = it->second;
+            size_t kept = 0;
+            for (size_t i = 0; i < list.size(); ++i) {
+                if (isLive(list[i])) {
+                    list[kept++] = list[i];
+                }
+            }
+            list.resize(kept);
+            if (list.empty()) {
+                it = grams[n].erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+    staleEntries = 0;
+}
+
+void NameIndex::search(const std::string& query, size_t limit, std::vector<size_t>& out) const {
+    std::vector<uint32_t> cps;
+    decodeUtf8(query, cps);
+    if (cps.empty()) {
+        return;
+    }
+
+    // 不超过 3 个字：倒排表本身就是答案
+    if (cps.size() <= 3) {
+        GramMap::const_iterator it = grams[cps.size() - 1].find(gramKey(&cps[0], cps.size()));
+        if (it == grams[cps.size() - 1].end()) {
+            return;
+        }
+        const std::vector<Posting>& list = it->second;
+        size_t found = 0;
+        for (size_t i = 0; i < list.size() && (limit == 0 || found < limit); ++i) {
+            if (isLive(list[i])) {
+                out.push_back(static_cast<size_t>(list[i].row));
+                ++found;
+            }
+        }
+        return;
+    }
+
+    // 更长的查询：取最短的 3 字倒排表作为候选，再核对完整姓名
+    const std::vector<Posting>* shortest = nullptr;
+    for (size_t i = 0; i + 3 <= cps.size(); ++i) {
+        GramMap::const_iterator it = grams[2].find(gramKey(&cps[i], 3));
+        if (it == grams[2].end()) {
+            return;
+        }
+        if (!shortest || it->second.size() < shortest->size()) {
+            shortest = &it->second;
+        }
+    }
+    const std::vector<StringView>& names = table.nameColumn();
+    size_t found = 0;
+    for (size_t i = 0; i < shortest->size() && (limit == 0 || found < limit); ++i) {
+        const Posting& posting = (*shortest)[i];
+        if (isLive(posting) && names[posting.row].find(query) != StringView::npos) {
+            out.push_back(static_cast<size_t>(posting.row));
+            ++found;
+        }
+    }
+}
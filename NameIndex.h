@@ -0,0 +1,53 @@
+#ifndef NAMEINDEX_H
+#define NAMEINDEX_H
+
+#include "StudentTable.h"
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include <atomic>
+#include <cstddef>
+#include <stdint.h>
+
+// 姓名子串索引：按 UTF-8 字符（码点）切分，记录每个姓名中出现的 1、2、3 字片段。
+// 长度不超过 3 个字的查询直接取对应片段的倒排表；更长的查询取其中最短的 3 字倒排表，
+// 再逐条核对姓名。
+// 删除或修改时只把该行的版本号加一，倒排表中的旧条目随之失效；
+// 失效条目超过有效条目时整体清理一次。行号整体变化后调用 reset，下次使用时重建
+class NameIndex {
+private:
+    struct Posting {
+        int row;                       // 行号
+        uint32_t version;              // 写入时该行的版本号，与当前版本不同表示已失效
+    };
+    typedef std::unordered_map<uint64_t, std::vector<Posting> > GramMap;
+
+    const StudentTable& table;
+    GramMap grams[3];                  // grams[n - 1]：n 字片段 -> 倒排表
+    std::vector<uint32_t> versions;    // 每行的当前版本号
+    size_t liveEntries;                // 有效条目数
+    size_t staleEntries;               // 失效条目数
+    std::atomic<bool> built;           // 建立完成后才置位，并发的读者可以无锁检查
+
+    size_t addGrams(int row);          // 把该行当前姓名的片段写入倒排表，返回写入的条目数
+    size_t countGrams(int row) const;  // 该行当前姓名的片段数（去重后）
+    void purge();                      // 清理所有失效条目
+    bool isLive(const Posting& posting) const;
+
+public:
+    explicit NameIndex(const StudentTable& table);
+
+    bool isBuilt() const;
+    void build(const std::vector<size_t>& rows); // 用给定的存活行建立索引
+    void reset();                      // 丢弃索引
+
+    // 增量维护（未建立时忽略）。修改一行时先 erase、改表、再 insert
+    void insert(int row);
+    void erase(int row);
+
+    // 要求索引已建立。把姓名包含 query（非空）的行追加到 out，按索引中的顺序；
+    // limit 不为 0 时找到 limit 条即停止
+    void search(const std::string& query, size_t limit, std::vector<size_t>& out) const;
+};
+
+#endif // NAMEINDEX_H
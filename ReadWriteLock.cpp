@@ -0,0 +1,94 @@
+#include "ReadWriteLock.h"
+#include "ThreadPool.h"
+#include <atomic>
+#include <new>
+#include <cstdlib>
+
+namespace {
+    const size_t CACHE_LINE = 64;
+
+    // 每个线程第一次加读锁时分到一个编号，之后固定使用同一个分片
+    std::atomic<size_t> nextThreadSlot(0);
+    thread_local size_t threadSlot = static_cast<size_t>(-1);
+
+    size_t currentThreadSlot() {
+        if (threadSlot == static_cast<size_t>(-1)) {
+            threadSlot = nextThreadSlot.fetch_add(1, std::memory_order_relaxed);
+        }
+        return threadSlot;
+    }
+}
+
+struct ReadWriteLock::Shard {
+    pthread_rwlock_t lock;
+    char padding[CACHE_LINE - sizeof(pthread_rwlock_t) % CACHE_LINE];
+};
+
+ReadWriteLock::ReadWriteLock(size_t shardCount)
+    : shards(nullptr), count(shardCount != 0 ? shardCount : ThreadPool::hardwareThreads()) {
+    void* memory = nullptr;
+    if (::posix_memalign(&memory, CACHE_LINE, count * sizeof(Shard)) != 0) {
+        throw std::bad_alloc();
+    }
+    shards = static_cast<Shard*>(memory);
+
+    pthread_rwlockattr_t attr;
+    pthread_rwlockattr_init(&attr);
+#ifdef __GLIBC__
+    // glibc 默认读者优先，读请求源源不断时写者会一直等待
+    pthread_rwlockattr_setkind_np(&attr, PTHREAD_RWLOCK_PREFER_WRITER_NONRECURSIVE_NP);
+#endif
+    for (size_t i = 0; i < count; ++i) {
+        pthread_rwlock_init(&shards[i].lock, &attr);
+    }
+    pthread_rwlockattr_destroy(&attr);
+}
+
+ReadWriteLock::~ReadWriteLock() {
+    for (size_t i = 0; i < count; ++i) {
+        pthread_rwlock_destroy(&shards[i].lock);
+    }
+    std::free(shards);
+}
+
+size_t ReadWriteLock::lockShared() const {
+    size_t shard = currentThreadSlot() % count;
+    pthread_rwlock_rdlock(&shards[shard].lock);
+    return shard;
+}
+
+void ReadWriteLock::unlockShared(size_t shard) const {
+    pthread_rwlock_unlock(&shards[shard].lock);
+}
+
+void ReadWriteLock::lock() {
+    for (size_t i = 0; i < count; ++i) {
+        pthread_rwlock_wrlock(&shards[i].lock);
+    }
+}
+
+void ReadWriteLock::unlock() {
+    for (size_t i = count; i > 0; --i) {
+        pthread_rwlock_unlock(&shards[i - 1].lock);
+    }
+}
+
+size_t ReadWriteLock::shardCount() const {
+    return count;
+}
+
+ReadWriteLock::ReadGuard::ReadGuard(const ReadWriteLock& owner)
+    : owner(owner), shard(owner.lockShared()) {}
+
+ReadWriteLock::ReadGuard::~ReadGuard() {
+    owner.unlockShared(shard);
+}
+
+ReadWriteLock::WriteGuard::WriteGuard(ReadWriteLock& owner)
+    : owner(owner) {
+    owner.lock();
+}
+
+ReadWriteLock::WriteGuard::~WriteGuard() {
+    owner.unlock();
+}
@@ -0,0 +1,59 @@
+#ifndef READWRITELOCK_H
+#define READWRITELOCK_H
+
+#include <pthread.h>
+#include <cstddef>
+
+// 分片读写锁：内部有多把读写锁，每把独占一个缓存行。
+// 读者只锁自己线程对应的那一把，不同核上的读者互不争用同一个缓存行；
+// 写者按固定顺序锁住全部分片。写者优先，持续的读请求不会让写者饿死。
+// 同一线程不能嵌套加锁
+class ReadWriteLock {
+private:
+    struct Shard;
+
+    Shard* shards;                     // 按缓存行对齐的分片数组
+    size_t count;                      // 分片数
+
+    ReadWriteLock(const ReadWriteLock&);
+    ReadWriteLock& operator=(const ReadWriteLock&);
+
+public:
+    explicit ReadWriteLock(size_t shards = 0); // shards 为 0 时使用硬件线程数
+    ~ReadWriteLock();
+
+    size_t lockShared() const;         // 加读锁，返回所用的分片，解锁时传回
+    void unlockShared(size_t shard) const;
+    void lock();                       // 加写锁
+    void unlock();
+    size_t shardCount() const;
+
+    // 作用域内持有读锁
+    class ReadGuard {
+    private:
+        const ReadWriteLock& owner;
+        size_t shard;
+
+        ReadGuard(const ReadGuard&);
+        ReadGuard& operator=(const ReadGuard&);
+
+    public:
+        explicit ReadGuard(const ReadWriteLock& owner);
+        ~ReadGuard();
+    };
+
+    // 作用域内持有写锁
+    class WriteGuard {
+    private:
+        ReadWriteLock& owner;
+
+        WriteGuard(const WriteGuard&);
+        WriteGuard& operator=(const WriteGuard&);
+
+    public:
+        explicit WriteGuard(ReadWriteLock& owner);
+        ~WriteGuard();
+    };
+};
+
+#endif // READWRITELOCK_H
@@ -0,0 +1,186 @@
+#include "RunningStatistics.h"
+#include <cmath>
+#include <limits>
+
+namespace {
+    const uint32_t EMPTY_LEAF = static_cast<uint32_t>(-1);
+
+    // 锦标赛树中两个子树的胜者：a 来自左子树（行号较小），绩点相同时取 a；空叶子不参与比较
+    uint32_t higherOf(const std::vector<double>& gpas, uint32_t a, uint32_t b) {
+        if (a == EMPTY_LEAF) return b;
+        if (b == EMPTY_LEAF) return a;
+        return gpas[b] > gpas[a] ? b : a;
+    }
+
+    uint32_t lowerOf(const std::vector<double>& gpas, uint32_t a, uint32_t b) {
+        if (a == EMPTY_LEAF) return b;
+        if (b == EMPTY_LEAF) return a;
+        return gpas[b] < gpas[a] ? b : a;
+    }
+}
+
+void RunningStatistics::Accumulator::add(double gpa) {
+    ++count;
+    if (std::isnan(gpa)) {
+        return;
+    }
+    ++graded;
+    double total = sum + gpa;
+    if (std::fabs(sum) >= std::fabs(gpa)) {
+        compensation += (sum - total) + gpa;
+    } else {
+        compensation += (gpa - total) + sum;
+    }
+    sum = total;
+}
+
+void RunningStatistics::Accumulator::remove(double gpa) {
+    --count;
+    if (std::isnan(gpa)) {
+        return;
+    }
+    if (--graded == 0) {
+        sum = 0.0;
+        compensation = 0.0;
+        return;
+    }
+    double total = sum - gpa;
+    if (std::fabs(sum) >= std::fabs(gpa)) {
+        compensation += (sum - total) - gpa;
+    } else {
+        compensation += (-gpa - total) + sum;
+    }
+    sum = total;
+}
+
+GroupStatistics RunningStatistics::Accumulator::value() const {
+    GroupStatistics stats;
+    stats.count = count;
+    stats.graded = graded;
+    stats.gpaSum = sum + compensation;
+    return stats;
+}
+
+RunningStatistics::RunningStatistics(const StudentTable& table)
+    : table(table), leaves(0), extremesBuilt(false) {}
+
+void RunningStatistics::add(size_t row) {
+    double gpa = table.gpaColumn()[row];
+    if (extremesBuilt) {
+        if (row < leaves) {
+            setLeaf(row, gpa);
+        } else {
+            buildExtremes();           // 行数超过叶子数：叶子数翻倍后整体重建，均摊 O(1)
+        }
+    }
+    overall.add(gpa);
+    distribution.add(gpa);
+    size_t major = table.majorColumn()[row];
+    if (major >= byMajor.size()) {
+        byMajor.resize(major + 1);
+    }
+    byMajor[major].add(gpa);
+    byAge[table.ageColumn()[row]].add(gpa);
+}
+
+void RunningStatistics::remove(size_t row) {
+    double gpa = table.gpaColumn()[row];
+    if (extremesBuilt) {
+        setLeaf(row, std::numeric_limits<double>::quiet_NaN());
+    }
+    overall.remove(gpa);
+    distribution.remove(gpa);
+    byMajor[table.majorColumn()[row]].remove(gpa);
+    std::map<int, Accumulator>::iterator age = byAge.find(table.ageColumn()[row]);
+    age->second.remove(gpa);
+    if (age->second.count == 0) {
+        byAge.erase(age);
+    }
+}
+
+void RunningStatistics::clear() {
+    overall = Accumulator();
+    byMajor.clear();
+    byAge.clear();
+    distribution.clear();
+    invalidateExtremes();
+}
+
+void RunningStatistics::rebuild(const std::vector<size_t>& rows) {
+    clear();
+    for (size_t i = 0; i < rows.size(); ++i) {
+        add(rows[i]);
+    }
+}
+
+void RunningStatistics::invalidateExtremes() {
+    extremesBuilt = false;
+    std::vector<uint32_t>().swap(highestTree);
+    std::vector<uint32_t>().swap(lowestTree);
+    leaves = 0;
+}
+
+void RunningStatistics::setLeaf(size_t row, double gpa) {
+    const std::vector<double>& gpas = table.gpaColumn();
+    size_t node = leaves + row;
+    highestTree[node] = lowestTree[node] = std::isnan(gpa) ? EMPTY_LEAF : static_cast<uint32_t>(row);
+    for (node /= 2; node > 0; node /= 2) {
+        highestTree[node] = higherOf(gpas, highestTree[2 * node], highestTree[2 * node + 1]);
+        lowestTree[node] = lowerOf(gpas, lowestTree[2 * node], lowestTree[2 * node + 1]);
+    }
+}
+
+void RunningStatistics::buildExtremes() const {
+    const std::vector<double>& gpas = table.gpaColumn();
+    leaves = 1;
+    while (leaves < gpas.size()) {
+        leaves *= 2;
+    }
+    highestTree.assign(2 * leaves, EMPTY_LEAF);
+    for (size_t row = 0; row < gpas.size(); ++row) {
+        if (!std::isnan(gpas[row])) {
+            highestTree[leaves + row] = static_cast<uint32_t>(row);
+        }
+    }
+    lowestTree = highestTree;
+    for (size_t node = leaves - 1; node > 0; --node) {
+        highestTree[node] = higherOf(gpas, highestTree[2 * node], highestTree[2 * node + 1]);
+        lowestTree[node] = lowerOf(gpas, lowestTree[2 * node], lowestTree[2 * node + 1]);
+    }
+    extremesBuilt = true;
+}
+
+GroupStatistics RunningStatistics::total() const {
+    return overall.value();
+}
+
+std::map<std::string, GroupStatistics> RunningStatistics::majors() const {
+    std::map<std::string, GroupStatistics> result;
+    for (size_t code = 0; code < byMajor.size(); ++code) {
+        if (byMajor[code].count > 0) {
+            result[table.majorDictionary().lookup(static_cast<StringDictionary::Code>(code))] = byMajor[code].value();
+        }
+    }
+    return result;
+}
+
+std::map<int, GroupStatistics> RunningStatistics::ages() const {
+    std::map<int, GroupStatistics> result;
+    for (std::map<int, Accumulator>::const_iterator it = byAge.begin(); it != byAge.end(); ++it) {
+        result[it->first] = it->second.value();
+    }
+    return result;
+}
+
+const GpaDistribution& RunningStatistics::gpaDistribution() const {
+    return distribution;
+}
+
+bool RunningStatistics::extremes(size_t& highest, size_t& lowest) const {
+    if (!extremesBuilt) {
+        return false;
+    }
+    highest = highestTree[1] == EMPTY_LEAF ? NO_ROW : highestTree[1];
+    lowest = lowestTree[1] == EMPTY_LEAF ? NO_ROW : lowestTree[1];
+    return true;
+}
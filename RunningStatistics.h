@@ -0,0 +1,80 @@
+#ifndef RUNNINGSTATISTICS_H
+#define RUNNINGSTATISTICS_H
+
+#include "StudentTable.h"
+#include "GpaDistribution.h"
+#include <vector>
+#include <map>
+#include <string>
+#include <cstddef>
+#include <atomic>
+#include <stdint.h>
+
+// 一组学生的人数与绩点汇总
+struct GroupStatistics {
+    size_t count;                      // 学生人数
+    size_t graded;                     // 绩点有效（不是 NaN）的人数
+    double gpaSum;                     // 有效绩点之和
+
+    GroupStatistics() : count(0), graded(0), gpaSum(0.0) {}
+    double averageGpa() const { return graded == 0 ? 0.0 : gpaSum / graded; }
+};
+
+// 随增删改增量维护的统计：总人数、绩点总和，以及按专业、按年龄分组的人数与绩点总和。
+// 读取总体统计为 O(1)，分组统计为 O(组数)。绩点总和用补偿求和（Neumaier）累加和扣除，
+// 反复增删后误差仍在一个舍入单位的量级；一组的有效绩点人数归零时总和精确归零。
+// 最高、最低绩点所在行由两棵按行号排列的锦标赛树求出（每个内部节点存两个子树中胜出的行），
+// 第一次读取时 O(n) 建立，之后随增删改 O(log n) 维护，删除最值所在的行也不必重新扫描；
+// 表被重排后丢弃，下次读取时重建（见 StudentManager::getGpaStatistics）。全体有效绩点的分布另由 GpaDistribution 维护
+class RunningStatistics {
+private:
+    // 带补偿项的累加器
+    struct Accumulator {
+        size_t count;
+        size_t graded;
+        double sum;
+        double compensation;           // 累加中丢失的低位
+
+        Accumulator() : count(0), graded(0), sum(0.0), compensation(0.0) {}
+        void add(double gpa);          // 计入一名学生
+        void remove(double gpa);       // 扣除一名学生
+        GroupStatistics value() const;
+    };
+
+    const StudentTable& table;
+    Accumulator overall;
+    std::vector<Accumulator> byMajor;  // 按专业编码
+    std::map<int, Accumulator> byAge;  // 年龄 -> 汇总（人数为 0 的年龄会被移除）
+    GpaDistribution distribution;      // 全体有效绩点的分布（分位数、排名、直方图）
+    // 锦标赛树：下标 1 为根，叶子从 leaves 开始，第 i 个叶子对应第 i 行（绩点为 NaN 或已删除时为空）。
+    // highestTree 的节点存子树中绩点最高的行，lowestTree 存最低的行，相同时取靠前的行
+    mutable std::vector<uint32_t> highestTree;
+    mutable std::vector<uint32_t> lowestTree;
+    mutable size_t leaves;             // 叶子数（2 的幂，不小于表的行数）
+    mutable std::atomic<bool> extremesBuilt; // 建立完成后才置位，并发的读者可以无锁检查
+
+    void setLeaf(size_t row, double gpa); // 改一个叶子（gpa 为 NaN 时置空）并向上重新比较
+
+public:
+    static const size_t NO_ROW = static_cast<size_t>(-1);
+
+    explicit RunningStatistics(const StudentTable& table);
+
+    void add(size_t row);              // 该行已写入表
+    void remove(size_t row);           // 该行即将被删除或覆盖（表中仍是旧值）
+    void clear();
+    void rebuild(const std::vector<size_t>& rows); // 用给定的存活行重新统计
+    void invalidateExtremes();         // 行号整体改变（压缩、重排）后调用，丢弃最值树
+
+    GroupStatistics total() const;
+    std::map<std::string, GroupStatistics> majors() const; // 专业 -> 汇总（不含人数为 0 的专业）
+    std::map<int, GroupStatistics> ages() const;           // 年龄 -> 汇总
+    const GpaDistribution& gpaDistribution() const;
+
+    // 绩点最高、最低的行：最值树已建立时取出并返回 true（没有有效绩点时为 NO_ROW）；
+    // 未建立时返回 false，由调用者加锁后 buildExtremes
+    bool extremes(size_t& highest, size_t& lowest) const;
+    void buildExtremes() const;        // 按表中的绩点列建立最值树（已删除的行绩点为 NaN，不参与）
+};
+
+#endif // RUNNINGSTATISTICS_H
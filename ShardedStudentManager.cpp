@@ -0,0 +1,396 @@
+#include "ShardedStudentManager.h"
+#include <queue>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <climits>
+#include <stdexcept>
+#include <stdint.h>
+
+namespace {
+    // 多路归并各分片已排好序的结果；before(a, b) 为 a 应排在 b 之前，limit 为 0 表示不限
+    std::vector<StudentRef> mergeSorted(const std::vector<std::vector<StudentRef> >& parts,
+                                        bool (*before)(const StudentRef&, const StudentRef&),
+                                        size_t limit) {
+        typedef std::pair<size_t, size_t> Cursor;  // (分片, 位置)
+        // 堆顶为最先输出的元素；键相同时分片编号小的在前
+        auto later = [&parts, before](const Cursor& a, const Cursor& b) {
+            const StudentRef& x = parts[a.first][a.second];
+            const StudentRef& y = parts[b.first][b.second];
+            if (before(y, x)) return true;
+            if (before(x, y)) return false;
+            return a.first > b.first;
+        };
+        std::priority_queue<Cursor, std::vector<Cursor>, decltype(later)> heap(later);
+        size_t total = 0;
+        for (size_t i = 0; i < parts.size(); ++i) {
+            total += parts[i].size();
+            if (!parts[i].empty()) {
+                heap.push(Cursor(i, 0));
+            }
+        }
+        if (limit != 0 && total > limit) {
+            total = limit;
+        }
+        std::vector<StudentRef> merged;
+        merged.reserve(total);
+        while (!heap.empty() && merged.size() < total) {
+            Cursor top = heap.top();
+            heap.pop();
+            merged.push_back(parts[top.first][top.second]);
+            if (++top.second < parts[top.first].size()) {
+                heap.push(top);
+            }
+        }
+        return merged;
+    }
+
+    bool idBefore(const StudentRef& a, const StudentRef& b) {
+        return a.getId() < b.getId();
+    }
+
+    bool nameBefore(const StudentRef& a, const StudentRef& b) {
+        return a.getNameView() < b.getNameView();
+    }
+
+    // 绩点从高到低，NaN 排在最后（与各分片的有序索引一致，见 SortedIndexes::gpaKey）
+    bool gpaBefore(const StudentRef& a, const StudentRef& b) {
+        if (std::isnan(b.getGpa())) return !std::isnan(a.getGpa());
+        if (std::isnan(a.getGpa())) return false;
+        return a.getGpa() > b.getGpa();
+    }
+}
+
+ShardedStudentManager::ShardedStudentManager(const std::string& filename, size_t shardCount,
+                                             const ManagerOptions& options)
+    : shards(shardCount), pool(shardCount), messages(options.messages) {
+    if (shardCount == 0) {
+        throw std::invalid_argument("分片数必须大于 0");
+    }
+    // 各分片的数据文件互不相关，并行加载
+    forEachShard([&](size_t i) {
+        shards[i].reset(new StudentManager(shardPath(filename, i), options));
+    });
+}
+
+ShardedStudentManager::~ShardedStudentManager() {
+    // 析构时各分片可能要保存数据文件，同样并行进行
+    forEachShard([this](size_t i) {
+        shards[i].reset();
+    });
+}
+
+// students.txt -> students.0.txt；没有扩展名时在末尾加 .i
+std::string ShardedStudentManager::shardPath(const std::string& filename, size_t shard) {
+    if (filename.empty()) {
+        return filename;
+    }
+    std::string::size_type slash = filename.rfind('/');
+    std::string::size_type dot = filename.rfind('.');
+    std::string index = std::to_string(shard);
+    if (dot == std::string::npos || (slash != std::string::npos && dot < slash) || dot == 0 || dot == slash + 1) {
+        return filename + "." + index;
+    }
+    return filename.substr(0, dot) + "." + index + filename.substr(dot);
+}
+
+size_t ShardedStudentManager::getShardCount() const {
+    return shards.size();
+}
+
+// 学号按乘法散列分片：连续的学号也能均匀分布到各分片
+size_t ShardedStudentManager::shardOf(int id) const {
+    uint64_t hash = static_cast<uint64_t>(static_cast<uint32_t>(id)) * 0x9E3779B97F4A7C15ULL;
+    return static_cast<size_t>((hash >> 32) % shards.size());
+}
+
+void ShardedStudentManager::forEachShard(const std::function<void(size_t)>& task) const {
+    std::vector<std::future<void> > pending;
+    pending.reserve(shards.size());
+    for (size_t i = 0; i < shards.size(); ++i) {
+        pending.push_back(pool.submit([&task, i]() {
+            task(i);
+        }));
+    }
+    for (size_t i = 0; i < pending.size(); ++i) {
+        pending[i].get();
+    }
+}
+
+bool ShardedStudentManager::addStudent(const Student& student) {
+    return shards[shardOf(student.getId())]->addStudent(student);
+}
+
+bool ShardedStudentManager::deleteStudent(int id) {
+    return shards[shardOf(id)]->deleteStudent(id);
+}
+
+bool ShardedStudentManager::updateStudent(int id, const Student& newInfo) {
+    size_t from = shardOf(id);
+    size_t to = shardOf(newInfo.getId());
+    if (from == to) {
+        return shards[from]->updateStudent(id, newInfo);
+    }
+
+    if (!shards[from]->findStudent(id)) {
+        report("错误：未找到学号为 " + std::to_string(id) + " 的学生！");
+        return false;
+    }
+    if (shards[to]->findStudent(newInfo.getId())) {
+        report("错误：学号 " + std::to_string(newInfo.getId()) + " 已存在！");
+        return false;
+    }
+    // 先添加后删除：两步之间崩溃时最多多出一条旧记录，不会丢失。
+    // 两个分片各自的提示不输出，只报告一次结果。新学号已查过重，添加与删除只会因日志写入失败而返回 false；
+    // 添加失败时不再删除旧记录，否则删除先写盘、添加还在缓冲区中时崩溃会丢掉这名学生
+    shards[to]->setMessageStream(nullptr);
+    shards[from]->setMessageStream(nullptr);
+    bool added = shards[to]->addStudent(newInfo);
+    bool deleted = added && shards[from]->deleteStudent(id);
+    shards[to]->setMessageStream(messages);
+    shards[from]->setMessageStream(messages);
+    if (!added) {
+        report("错误：写入日志失败（磁盘已满或 I/O 错误），新记录尚未写盘，旧记录 " +
+               std::to_string(id) + " 暂时保留！");
+        return false;
+    }
+    if (!deleted) {
+        report("错误：写入日志失败（磁盘已满或 I/O 错误），旧记录 " + std::to_string(id) +
+               " 的删除尚未写盘，恢复写盘之前崩溃时新旧两条记录会同时存在！");
+        return false;
+    }
+    report("学生信息更新成功！");
+    return true;
+}
+
+LoadReport ShardedStudentManager::addStudents(const std::vector<Student>& batch) {
+    std::vector<std::vector<Student> > parts(shards.size());
+    std::vector<std::vector<size_t> > positions(shards.size());   // 每条记录在 batch 中的下标
+    for (size_t i = 0; i < batch.size(); ++i) {
+        size_t shard = shardOf(batch[i].getId());
+        parts[shard].push_back(batch[i]);
+        positions[shard].push_back(i);
+    }
+
+    std::vector<LoadReport> reports(shards.size());
+    forEachShard([&](size_t i) {
+        reports[i] = shards[i]->addStudents(parts[i]);
+    });
+
+    LoadReport merged;
+    for (size_t i = 0; i < reports.size(); ++i) {
+        merged.loadedRows += reports[i].loadedRows;
+        for (size_t s = 0; s < reports[i].skipped.size(); ++s) {
+            SkippedLine skipped = reports[i].skipped[s];
+            skipped.lineNumber = positions[i][skipped.lineNumber - 1] + 1;
+            merged.skipped.push_back(skipped);
+        }
+    }
+    std::sort(merged.skipped.begin(), merged.skipped.end(),
+        [](const SkippedLine& a, const SkippedLine& b) {
+            return a.lineNumber < b.lineNumber;
+        });
+    return merged;
+}
+
+StudentRef ShardedStudentManager::findStudent(int id) const {
+    return shards[shardOf(id)]->findStudent(id);
+}
+
+int ShardedStudentManager::getTotalStudents() const {
+    int total = 0;
+    for (size_t i = 0; i < shards.size(); ++i) {
+        total += shards[i]->getTotalStudents();
+    }
+    return total;
+}
+
+double ShardedStudentManager::getAverageGpa() const {
+    GpaStatistics stats = getGpaStatistics();
+    return stats.graded == 0 ? 0.0 : stats.sum / stats.graded;
+}
+
+GpaStatistics ShardedStudentManager::getGpaStatistics() const {
+    std::vector<GpaStatistics> parts(shards.size());
+    forEachShard([&](size_t i) {
+        parts[i] = shards[i]->getGpaStatistics();
+    });
+
+    GpaStatistics merged;
+    for (size_t i = 0; i < parts.size(); ++i) {
+        merged.count += parts[i].count;
+        if (parts[i].graded == 0) continue;
+        if (merged.graded == 0 || parts[i].highest.getGpa() > merged.highest.getGpa()) {
+            merged.highest = parts[i].highest;
+        }
+        if (merged.graded == 0 || parts[i].lowest.getGpa() < merged.lowest.getGpa()) {
+            merged.lowest = parts[i].lowest;
+        }
+        merged.graded += parts[i].graded;
+        merged.sum += parts[i].sum;
+    }
+    return merged;
+}
+
+// 显示统计信息（格式与 StudentManager::getStatistics 相同）
+void ShardedStudentManager::getStatistics(std::ostream& out) const {
+    StudentManager::formatStatistics(getGpaStatistics(), out);
+}
+
+std::vector<StudentRef> ShardedStudentManager::searchByName(const std::string& name, size_t limit) const {
+    std::vector<std::vector<StudentRef> > parts(shards.size());
+    forEachShard([&](size_t i) {
+        parts[i] = shards[i]->searchByName(name, limit);
+    });
+    std::vector<StudentRef> result;
+    for (size_t i = 0; i < parts.size(); ++i) {
+        result.insert(result.end(), parts[i].begin(), parts[i].end());
+    }
+    if (limit != 0 && result.size() > limit) {
+        result.resize(limit);
+    }
+    return result;
+}
+
+std::vector<StudentRef> ShardedStudentManager::searchByName(const std::string& name, const QueryPage& page) const {
+    std::vector<std::vector<StudentRef> > parts(shards.size());
+    forEachShard([&](size_t i) {
+        parts[i] = shards[i]->searchByName(name, shardPage(page));
+    });
+    return concatPage(parts, page);
+}
+
+std::vector<StudentRef> ShardedStudentManager::searchByMajor(const std::string& major, const QueryPage& page) const {
+    std::vector<std::vector<StudentRef> > parts(shards.size());
+    forEachShard([&](size_t i) {
+        parts[i] = shards[i]->searchByMajor(major, shardPage(page));
+    });
+    return concatPage(parts, page);
+}
+
+// 结果按分片顺序拼接，第 offset 条之后的一页最多用到每个分片的前 offset + limit 条
+QueryPage ShardedStudentManager::shardPage(const QueryPage& page) {
+    return QueryPage(0, page.limit == 0 ? 0 : page.offset + page.limit);
+}
+
+std::vector<StudentRef> ShardedStudentManager::concatPage(const std::vector<std::vector<StudentRef> >& parts,
+                                                          const QueryPage& page) {
+    std::vector<StudentRef> result;
+    size_t skip = page.offset;
+    for (size_t i = 0; i < parts.size(); ++i) {
+        size_t begin = std::min(skip, parts[i].size());
+        skip -= begin;
+        size_t end = parts[i].size();
+        if (page.limit != 0) {
+            end = std::min(end, begin + (page.limit - result.size()));
+        }
+        result.insert(result.end(), parts[i].begin() + begin, parts[i].begin() + end);
+        if (page.limit != 0 && result.size() == page.limit) {
+            break;
+        }
+    }
+    return result;
+}
+
+std::vector<StudentRef> ShardedStudentManager::getAllStudents(SortKey order) const {
+    switch (order) {
+        case SORT_BY_NAME:
+            return getStudentsByNamePrefix("");
+        case SORT_BY_GPA:
+            return getStudentsByGpaRange(-std::numeric_limits<double>::infinity(),
+                                         std::numeric_limits<double>::infinity());
+        default:
+            return getStudentsByIdRange(INT_MIN, INT_MAX);
+    }
+}
+
+std::vector<StudentRef> ShardedStudentManager::getStudentsByIdRange(int minId, int maxId) const {
+    std::vector<std::vector<StudentRef> > parts(shards.size());
+    forEachShard([&](size_t i) {
+        parts[i] = shards[i]->getStudentsByIdRange(minId, maxId);
+    });
+    return mergeSorted(parts, idBefore, 0);
+}
+
+std::vector<StudentRef> ShardedStudentManager::getStudentsByNamePrefix(const std::string& prefix) const {
+    std::vector<std::vector<StudentRef> > parts(shards.size());
+    forEachShard([&](size_t i) {
+        parts[i] = shards[i]->getStudentsByNamePrefix(prefix);
+    });
+    return mergeSorted(parts, nameBefore, 0);
+}
+
+std::vector<StudentRef> ShardedStudentManager::getStudentsByGpaRange(double minGpa, double maxGpa) const {
+    std::vector<std::vector<StudentRef> > parts(shards.size());
+    forEachShard([&](size_t i) {
+        parts[i] = shards[i]->getStudentsByGpaRange(minGpa, maxGpa);
+    });
+    return mergeSorted(parts, gpaBefore, 0);
+}
+
+// 每个分片各取前 k 名，归并后再取前 k 名
+std::vector<StudentRef> ShardedStudentManager::getTopStudentsByGpa(size_t k) const {
+    std::vector<std::vector<StudentRef> > parts(shards.size());
+    forEachShard([&](size_t i) {
+        parts[i] = shards[i]->getTopStudentsByGpa(k);
+    });
+    return mergeSorted(parts, gpaBefore, k);
+}
+
+bool ShardedStudentManager::saveToFile() const {
+    std::vector<char> ok(shards.size());
+    forEachShard([&](size_t i) {
+        ok[i] = shards[i]->saveToFile();
+    });
+    for (size_t i = 0; i < ok.size(); ++i) {
+        if (!ok[i]) return false;
+    }
+    return true;
+}
+
+bool ShardedStudentManager::syncLog() {
+    std::vector<char> ok(shards.size());
+    forEachShard([&](size_t i) {
+        ok[i] = shards[i]->syncLog();
+    });
+    for (size_t i = 0; i < ok.size(); ++i) {
+        if (!ok[i]) return false;
+    }
+    return true;
+}
+
+void ShardedStudentManager::compact() {
+    forEachShard([this](size_t i) {
+        shards[i]->compact();
+    });
+}
+
+void ShardedStudentManager::report(const std::string& text) const {
+    if (messages) {
+        *messages << text << '\n';
+    }
+}
+
+void ShardedStudentManager::setMessageStream(std::ostream* out) {
+    messages = out;
+    for (size_t i = 0; i < shards.size(); ++i) {
+        shards[i]->setMessageStream(out);
+    }
+}
+
+void ShardedStudentManager::clearAllStudents() {
+    forEachShard([this](size_t i) {
+        shards[i]->setMessageStream(nullptr);
+        shards[i]->clearAllStudents();
+        shards[i]->setMessageStream(messages);
+    });
+    report("所有学生数据已清空！");
+}
+
+MetricsSnapshot ShardedStudentManager::getMetrics() const {
+    MetricsSnapshot total;
+    for (size_t i = 0; i < shards.size(); ++i) {
+        total.merge(shards[i]->getMetrics());
+    }
+    return total;
+}
@@ -0,0 +1,71 @@
+#ifndef SHARDEDSTUDENTMANAGER_H
+#define SHARDEDSTUDENTMANAGER_H
+
+#include "StudentManager.h"
+#include "ThreadPool.h"
+#include <vector>
+#include <string>
+#include <memory>
+#include <functional>
+
+// 分片的学生管理器：按学号散列把学生分到 N 个 StudentManager，每个分片有自己的数据文件
+// （students.txt 的第 i 片为 students.i.txt，扩展名不变，格式仍按扩展名识别）。
+// 按学号的操作只访问一个分片；统计、搜索与有序列表在线程池中并行访问所有分片，再合并结果。
+// 分片数在数据文件建立后不能更改（学号与分片的对应关系取决于分片数）
+class ShardedStudentManager {
+private:
+    std::vector<std::unique_ptr<StudentManager> > shards;
+    mutable ThreadPool pool;           // 每个分片一个工作线程
+    std::ostream* messages;            // 提示与错误信息的输出目标，为空时不输出
+
+    void forEachShard(const std::function<void(size_t)>& task) const; // 并行对每个分片执行 task 并等待完成
+    void report(const std::string& text) const; // 输出一条提示或错误信息
+    static QueryPage shardPage(const QueryPage& page); // 拼接前每个分片需要取出的范围
+    static std::vector<StudentRef> concatPage(const std::vector<std::vector<StudentRef> >& parts,
+                                              const QueryPage& page); // 按分片顺序拼接并截取一页
+
+public:
+    ShardedStudentManager(const std::string& filename, size_t shardCount,
+                          const ManagerOptions& options = ManagerOptions());
+    ~ShardedStudentManager();          // 并行关闭各分片（未启用日志时各自保存数据文件）
+
+    static std::string shardPath(const std::string& filename, size_t shard); // 第 shard 片的数据文件名
+    size_t getShardCount() const;
+    size_t shardOf(int id) const;      // 学号所在的分片
+
+    // 基本操作（按学号路由到单个分片）
+    bool addStudent(const Student& student);
+    bool deleteStudent(int id);
+    bool updateStudent(int id, const Student& newInfo); // 学号改变且新学号在其他分片时，先添加新记录再删除旧记录；
+                                                        // 任一步日志写入失败时返回 false（添加失败时保留旧记录）
+    StudentRef findStudent(int id) const;              // 视图在下一次修改前有效
+    LoadReport addStudents(const std::vector<Student>& batch); // 按分片拆分后并行导入，行号为在 batch 中的位置
+
+    // 统计（并行扫描各分片后合并）
+    int getTotalStudents() const;
+    double getAverageGpa() const;
+    GpaStatistics getGpaStatistics() const;
+    void getStatistics(std::ostream& out = std::cout) const; // 显示统计信息
+
+    // 搜索（并行，结果按分片顺序拼接）。取一页时每个分片最多取 offset + limit 条，拼接后再截取
+    std::vector<StudentRef> searchByName(const std::string& name, size_t limit = 0) const;
+    std::vector<StudentRef> searchByName(const std::string& name, const QueryPage& page) const;
+    std::vector<StudentRef> searchByMajor(const std::string& major, const QueryPage& page = QueryPage()) const;
+
+    // 有序列表与区间查询（各分片在有序索引上查询，再多路归并）
+    std::vector<StudentRef> getAllStudents(SortKey order) const;
+    std::vector<StudentRef> getStudentsByIdRange(int minId, int maxId) const;
+    std::vector<StudentRef> getStudentsByNamePrefix(const std::string& prefix) const;
+    std::vector<StudentRef> getStudentsByGpaRange(double minGpa, double maxGpa) const;
+    std::vector<StudentRef> getTopStudentsByGpa(size_t k) const;
+
+    // 存储（对所有分片并行执行）
+    bool saveToFile() const;
+    bool syncLog();
+    void compact();
+    void clearAllStudents();
+    void setMessageStream(std::ostream* out);          // 同时设置所有分片的提示信息输出目标
+    MetricsSnapshot getMetrics() const;                // 各分片运行指标之和
+};
+
+#endif // SHARDEDSTUDENTMANAGER_H
@@ -0,0 +1,192 @@
+#include "SortedIndexes.h"
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <limits>
+#include <stdint.h>
+
+namespace {
+    struct PrefixedRow {
+        uint64_t prefix;
+        int row;
+    };
+
+    // 姓名前 8 字节按大端序拼成整数（不足补 0），整数的大小关系与字节序比较一致，相等时需要比较完整姓名
+    uint64_t namePrefixKey(StringView name) {
+        uint64_t key = 0;
+        for (size_t i = 0; i < 8; ++i) {
+            key = (key << 8) | (i < name.size() ? static_cast<unsigned char>(name.data()[i]) : 0);
+        }
+        return key;
+    }
+}
+
+SortedIndexes::SortedIndexes(const StudentTable& table)
+    : table(table), byName(NameOrder(&table)), idBuilt(false), nameBuilt(false), gpaBuilt(false) {}
+
+double SortedIndexes::gpaKey(double gpa) {
+    return std::isnan(gpa) ? std::numeric_limits<double>::infinity() : -gpa;
+}
+
+bool SortedIndexes::isBuilt(SortKey key) const {
+    switch (key) {
+        case SORT_BY_ID: return idBuilt;
+        case SORT_BY_NAME: return nameBuilt;
+        case SORT_BY_GPA: return gpaBuilt;
+        default: return true;
+    }
+}
+
+void SortedIndexes::build(SortKey key, const std::vector<size_t>& rows) {
+    if (key == SORT_BY_ID) {
+        byId.clear();
+        for (size_t i = 0; i < rows.size(); ++i) {
+            byId.insert(std::make_pair(table.idColumn()[rows[i]], static_cast<int>(rows[i])));
+        }
+        idBuilt = true;
+    } else if (key == SORT_BY_NAME) {
+        // 先排好序再逐个插到末尾（带位置提示的插入均摊 O(1)），比逐个在树中查找位置少走很多次随机访问；
+        // 排序时带上姓名的前 8 字节，多数比较不必到字符串池中取姓名
+        const std::vector<StringView>& names = table.nameColumn();
+        std::vector<PrefixedRow> keys(rows.size());
+        for (size_t i = 0; i < rows.size(); ++i) {
+            keys[i].prefix = namePrefixKey(names[rows[i]]);
+            keys[i].row = static_cast<int>(rows[i]);
+        }
+        std::sort(keys.begin(), keys.end(), [&names](const PrefixedRow& a, const PrefixedRow& b) {
+            if (a.prefix != b.prefix) return a.prefix < b.prefix;
+            int c = names[a.row].compare(names[b.row]);
+            return c != 0 ? c < 0 : a.row < b.row;
+        });
+        byName.clear();
+        for (size_t i = 0; i < keys.size(); ++i) {
+            NameKey key = { keys[i].row, StringView() };
+            byName.insert(byName.end(), key);
+        }
+        nameBuilt = true;
+    } else if (key == SORT_BY_GPA) {
+        byGpa.clear();
+        for (size_t i = 0; i < rows.size(); ++i) {
+            byGpa.insert(std::make_pair(gpaKey(table.gpaColumn()[rows[i]]), static_cast<int>(rows[i])));
+        }
+        gpaBuilt = true;
+    }
+}
+
+void SortedIndexes::reset() {
+    byId.clear();
+    byName.clear();
+    byGpa.clear();
+    idBuilt = nameBuilt = gpaBuilt = false;
+}
+
+void SortedIndexes::insert(int row) {
+    if (idBuilt) {
+        byId.insert(std::make_pair(table.idColumn()[row], row));
+    }
+    if (nameBuilt) {
+        NameKey key = { row, StringView() };
+        byName.insert(key);
+    }
+    if (gpaBuilt) {
+        byGpa.insert(std::make_pair(gpaKey(table.gpaColumn()[row]), row));
+    }
+}
+
+void SortedIndexes::erase(int row) {
+    if (idBuilt) {
+        byId.erase(std::make_pair(table.idColumn()[row], row));
+    }
+    if (nameBuilt) {
+        NameKey key = { row, StringView() };
+        byName.erase(key);
+    }
+    if (gpaBuilt) {
+        byGpa.erase(std::make_pair(gpaKey(table.gpaColumn()[row]), row));
+    }
+}
+
+void SortedIndexes::rowsInOrder(SortKey key, std::vector<size_t>& out) const {
+    out.reserve(out.size() + (key == SORT_BY_ID ? byId.size() : key == SORT_BY_NAME ? byName.size() : byGpa.size()));
+    visitInOrder(key, [&out](size_t row) {
+        out.push_back(row);
+        return true;
+    });
+}
+
+void SortedIndexes::idRange(int minId, int maxId, std::vector<size_t>& out) const {
+    visitIdRange(minId, maxId, [&out](size_t row) {
+        out.push_back(row);
+        return true;
+    });
+}
+
+void SortedIndexes::namePrefix(const std::string& prefix, std::vector<size_t>& out) const {
+    visitNamePrefix(prefix, [&out](size_t row) {
+        out.push_back(row);
+        return true;
+    });
+}
+
+void SortedIndexes::gpaRange(double minGpa, double maxGpa, std::vector<size_t>& out) const {
+    visitGpaRange(minGpa, maxGpa, [&out](size_t row) {
+        out.push_back(row);
+        return true;
+    });
+}
+
+void SortedIndexes::topGpa(size_t k, std::vector<size_t>& out) const {
+    std::set<std::pair<double, int> >::const_iterator it = byGpa.begin();
+    for (size_t i = 0; i < k && it != byGpa.end(); ++i, ++it) {
+        // NaN 排在最后，不计入“最高”
+        if (std::isinf(it->first) && it->first > 0) break;
+        out.push_back(static_cast<size_t>(it->second));
+    }
+}
+
+bool SortedIndexes::visitInOrder(SortKey key, const std::function<bool(size_t)>& visit) const {
+    if (key == SORT_BY_ID) {
+        for (std::set<std::pair<int, int> >::const_iterator it = byId.begin(); it != byId.end(); ++it) {
+            if (!visit(static_cast<size_t>(it->second))) return false;
+        }
+    } else if (key == SORT_BY_NAME) {
+        for (std::set<NameKey, NameOrder>::const_iterator it = byName.begin(); it != byName.end(); ++it) {
+            if (!visit(static_cast<size_t>(it->row))) return false;
+        }
+    } else if (key == SORT_BY_GPA) {
+        for (std::set<std::pair<double, int> >::const_iterator it = byGpa.begin(); it != byGpa.end(); ++it) {
+            if (!visit(static_cast<size_t>(it->second))) return false;
+        }
+    }
+    return true;
+}
+
+bool SortedIndexes::visitIdRange(int minId, int maxId, const std::function<bool(size_t)>& visit) const {
+    std::set<std::pair<int, int> >::const_iterator it = byId.lower_bound(std::make_pair(minId, INT_MIN));
+    for (; it != byId.end() && it->first <= maxId; ++it) {
+        if (!visit(static_cast<size_t>(it->second))) return false;
+    }
+    return true;
+}
+
+bool SortedIndexes::visitNamePrefix(const std::string& prefix, const std::function<bool(size_t)>& visit) const {
+    NameKey probe = { INT_MIN, StringView(prefix) };
+    const std::vector<StringView>& names = table.nameColumn();
+    std::set<NameKey, NameOrder>::const_iterator it = byName.lower_bound(probe);
+    for (; it != byName.end() && names[it->row].startsWith(prefix); ++it) {
+        if (!visit(static_cast<size_t>(it->row))) return false;
+    }
+    return true;
+}
+
+bool SortedIndexes::visitGpaRange(double minGpa, double maxGpa, const std::function<bool(size_t)>& visit) const {
+    if (!(minGpa <= maxGpa)) {
+        return true;
+    }
+    // 键为 -gpa：绩点区间 [minGpa, maxGpa] 对应键区间 [-maxGpa, -minGpa]
+    std::set<std::pair<double, int> >::const_iterator it = byGpa.lower_bound(std::make_pair(-maxGpa, INT_MIN));
+    for (; it != byGpa.end() && it->first <= -minGpa; ++it) {
+        if (!visit(static_cast<size_t>(it->second))) return false;
+    }
+    return true;
+}
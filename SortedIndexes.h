@@ -0,0 +1,80 @@
+#ifndef SORTEDINDEXES_H
+#define SORTEDINDEXES_H
+
+#include "StudentTable.h"
+#include <set>
+#include <atomic>
+#include <functional>
+#include <vector>
+#include <string>
+#include <utility>
+#include <cstddef>
+
+// 排序键
+enum SortKey {
+    SORT_NONE,                         // 不排序（按存储顺序）
+    SORT_BY_ID,                        // 学号从小到大
+    SORT_BY_NAME,                      // 姓名字典序
+    SORT_BY_GPA                        // 绩点从高到低
+};
+
+// 学号、姓名、绩点三个有序二级索引，元素为 (键, 行号)，键相同时按行号排列。
+// 每个索引在第一次使用时才建立，之后随插入、修改、删除增量维护（O(log n)）；
+// 行号整体变化（压缩、重新加载）后调用 reset，下次使用时重建
+class SortedIndexes {
+private:
+    // 姓名索引的元素只存行号，比较时到表中取姓名，不另存一份字符串；
+    // 表重排字符串池（见 StudentTable::repackNames）后仍然有效。
+    // C++11 的 std::set 不能用别的类型查找，行号为负的键只用于按前缀查找，姓名取 text
+    struct NameKey {
+        int row;
+        StringView text;
+    };
+    struct NameOrder {
+        const StudentTable* table;
+        explicit NameOrder(const StudentTable* table) : table(table) {}
+        StringView nameOf(const NameKey& key) const {
+            return key.row < 0 ? key.text : table->nameColumn()[key.row];
+        }
+        bool operator()(const NameKey& a, const NameKey& b) const {
+            int c = nameOf(a).compare(nameOf(b));
+            return c != 0 ? c < 0 : a.row < b.row;
+        }
+    };
+
+    const StudentTable& table;
+    std::set<std::pair<int, int> > byId;           // (学号, 行号)
+    std::set<NameKey, NameOrder> byName;           // 按 (姓名, 行号) 排列
+    std::set<std::pair<double, int> > byGpa;       // (绩点键, 行号)，绩点键见 gpaKey
+    std::atomic<bool> idBuilt;         // 建立完成后才置位，并发的读者可以无锁检查
+    std::atomic<bool> nameBuilt;
+    std::atomic<bool> gpaBuilt;
+
+    static double gpaKey(double gpa); // 取负使升序遍历即绩点从高到低；NaN 排在最后
+
+public:
+    explicit SortedIndexes(const StudentTable& table);
+
+    bool isBuilt(SortKey key) const;
+    void build(SortKey key, const std::vector<size_t>& rows); // 用给定的存活行建立索引
+    void reset();                      // 丢弃所有索引
+
+    // 增量维护（只更新已建立的索引）。修改一行时先 erase、改表、再 insert
+    void insert(int row);
+    void erase(int row);
+
+    // 以下查询要求对应的索引已建立，结果按行号追加到 out
+    void rowsInOrder(SortKey key, std::vector<size_t>& out) const;
+    void idRange(int minId, int maxId, std::vector<size_t>& out) const;             // 学号在 [minId, maxId]
+    void namePrefix(const std::string& prefix, std::vector<size_t>& out) const;     // 姓名以 prefix 开头
+    void gpaRange(double minGpa, double maxGpa, std::vector<size_t>& out) const;    // 绩点在 [minGpa, maxGpa]，从高到低
+    void topGpa(size_t k, std::vector<size_t>& out) const;                          // 绩点最高的 k 行
+
+    // 逐个把行号交给 visit，不生成列表；visit 返回 false 时提前结束，此时返回 false
+    bool visitInOrder(SortKey key, const std::function<bool(size_t)>& visit) const;
+    bool visitIdRange(int minId, int maxId, const std::function<bool(size_t)>& visit) const;
+    bool visitNamePrefix(const std::string& prefix, const std::function<bool(size_t)>& visit) const;
+    bool visitGpaRange(double minGpa, double maxGpa, const std::function<bool(size_t)>& visit) const;
+};
+
+#endif // SORTEDINDEXES_H
@@ -0,0 +1,59 @@
+#include "StringDictionary.h"
+#include <stdexcept>
+
+StringDictionary::StringDictionary() : lastCode(0) {}
+
+StringDictionary::Code StringDictionary::intern(const std::string& value) {
+    // 数据文件中相邻记录的专业、性别往往相同
+    if (lastCode < values.size() && values[lastCode] == value) {
+        return lastCode;
+    }
+    std::unordered_map<std::string, Code>::const_iterator it = codes.find(value);
+    if (it != codes.end()) {
+        lastCode = it->second;
+        return lastCode;
+    }
+    if (values.size() >= MAX_CODES) {
+        throw std::length_error("StringDictionary: too many distinct values");
+    }
+    lastCode = static_cast<Code>(values.size());
+    values.push_back(value);
+    codes[value] = lastCode;
+    return lastCode;
+}
+
+StringDictionary::Code StringDictionary::intern(StringView value) {
+    // 专业、性别通常只有几十种取值，逐个比较比构造 std::string 再查哈希表便宜
+    const size_t LINEAR_SCAN_CODES = 64;
+    if (lastCode < values.size() && StringView(values[lastCode]) == value) {
+        return lastCode;
+    }
+    if (values.size() <= LINEAR_SCAN_CODES) {
+        for (size_t code = 0; code < values.size(); ++code) {
+            if (StringView(values[code]) == value) {
+                lastCode = static_cast<Code>(code);
+                return lastCode;
+            }
+        }
+    }
+    return intern(value.str());
+}
+
+int StringDictionary::find(const std::string& value) const {
+    std::unordered_map<std::string, Code>::const_iterator it = codes.find(value);
+    return it == codes.end() ? -1 : static_cast<int>(it->second);
+}
+
+const std::string& StringDictionary::lookup(Code code) const {
+    return values[code];
+}
+
+size_t StringDictionary::size() const {
+    return values.size();
+}
+
+void StringDictionary::clear() {
+    values.clear();
+    codes.clear();
+    lastCode = 0;
+}
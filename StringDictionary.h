@@ -0,0 +1,33 @@
+#ifndef STRINGDICTIONARY_H
+#define STRINGDICTIONARY_H
+
+#include "StringPool.h"
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <stdint.h>
+
+// 字符串字典：把重复出现的少量取值（专业、性别）映射为 16 位编码。
+// 编码从 0 开始按首次出现的顺序分配，分配后不会改变
+class StringDictionary {
+public:
+    typedef uint16_t Code;
+    static const size_t MAX_CODES = 65536;     // 最多容纳的不同取值数
+
+private:
+    std::vector<std::string> values;           // 编码 -> 字符串
+    std::unordered_map<std::string, Code> codes; // 字符串 -> 编码
+    Code lastCode;                             // 最近一次 intern 的编码（连续相同取值时免去哈希）
+
+public:
+    StringDictionary();
+
+    Code intern(const std::string& value);     // 取得编码，不存在时分配新编码；超过上限时抛出 std::length_error
+    Code intern(StringView value);             // 同上；取值不多时逐个比较，已有的取值不必构造 std::string
+    int find(const std::string& value) const;  // 查找编码，不存在返回 -1
+    const std::string& lookup(Code code) const; // 编码 -> 字符串
+    size_t size() const;                       // 不同取值的个数
+    void clear();                              // 清空字典
+};
+
+#endif // STRINGDICTIONARY_H
@@ -0,0 +1,109 @@
+#include "StringPool.h"
+#include <utility>
+
+// ========== StringView ==========
+
+size_t StringView::find(StringView needle) const {
+    if (needle.length == 0) {
+        return 0;
+    }
+    if (needle.length > length) {
+        return npos;
+    }
+    // 用 memchr 找首字节的候选位置，再比较其余部分
+    const char* last = ptr + (length - needle.length);
+    const char* p = ptr;
+    while (p <= last) {
+        p = static_cast<const char*>(std::memchr(p, needle.ptr[0], static_cast<size_t>(last - p) + 1));
+        if (p == nullptr) {
+            return npos;
+        }
+        if (std::memcmp(p + 1, needle.ptr + 1, needle.length - 1) == 0) {
+            return static_cast<size_t>(p - ptr);
+        }
+        ++p;
+    }
+    return npos;
+}
+
+// ========== StringPool ==========
+
+namespace {
+    std::shared_ptr<char> allocate(size_t size) {
+        return std::shared_ptr<char>(new char[size], std::default_delete<char[]>());
+    }
+}
+
+StringPool::StringPool()
+    : cursor(nullptr), remaining(0), liveBytes(0), wastedBytes(0), reservedBytes(0) {}
+
+StringView StringPool::store(StringView value) {
+    size_t size = value.size();
+    if (size == 0) {
+        return StringView();
+    }
+    liveBytes += size;
+    // 较长的字符串单独占一块，不浪费当前块的剩余空间
+    if (size > BLOCK_SIZE / 4) {
+        blocks.push_back(allocate(size));
+        reservedBytes += size;
+        std::memcpy(blocks.back().get(), value.data(), size);
+        return StringView(blocks.back().get(), size);
+    }
+    if (size > remaining) {
+        blocks.push_back(allocate(BLOCK_SIZE));
+        reservedBytes += BLOCK_SIZE;
+        cursor = blocks.back().get();
+        remaining = BLOCK_SIZE;
+    }
+    char* start = cursor;
+    std::memcpy(start, value.data(), size);
+    cursor += size;
+    remaining -= size;
+    return StringView(start, size);
+}
+
+void StringPool::discard(StringView value) {
+    liveBytes -= value.size();
+    wastedBytes += value.size();
+}
+
+void StringPool::clear() {
+    std::vector<std::shared_ptr<char> >().swap(blocks);
+    cursor = nullptr;
+    remaining = 0;
+    liveBytes = 0;
+    wastedBytes = 0;
+    reservedBytes = 0;
+}
+
+// 共享 other 的大块但不接着写 other 的当前块：本池的下一个字符串从新块开始
+void StringPool::shareFrom(const StringPool& other) {
+    blocks = other.blocks;
+    cursor = nullptr;
+    remaining = 0;
+    liveBytes = other.liveBytes;
+    wastedBytes = other.wastedBytes;
+    reservedBytes = other.reservedBytes;
+}
+
+void StringPool::swap(StringPool& other) {
+    blocks.swap(other.blocks);
+    std::swap(cursor, other.cursor);
+    std::swap(remaining, other.remaining);
+    std::swap(liveBytes, other.liveBytes);
+    std::swap(wastedBytes, other.wastedBytes);
+    std::swap(reservedBytes, other.reservedBytes);
+}
+
+size_t StringPool::bytesLive() const {
+    return liveBytes;
+}
+
+size_t StringPool::bytesWasted() const {
+    return wastedBytes;
+}
+
+size_t StringPool::bytesReserved() const {
+    return reservedBytes;
+}
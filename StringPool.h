@@ -0,0 +1,79 @@
+#ifndef STRINGPOOL_H
+#define STRINGPOOL_H
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <ostream>
+#include <cstring>
+#include <cstddef>
+
+// 只读的字符串片段（指针 + 长度），不持有内存。C++11 没有 std::string_view，这里只实现用到的部分。
+// 指向 StringPool 或 std::string 的内容，原字符串被修改或释放后失效
+class StringView {
+private:
+    const char* ptr;
+    size_t length;
+
+public:
+    static const size_t npos = static_cast<size_t>(-1);
+
+    StringView() : ptr(""), length(0) {}
+    StringView(const char* data, size_t size) : ptr(data), length(size) {}
+    StringView(const std::string& s) : ptr(s.data()), length(s.size()) {} // 可以隐式转换
+
+    const char* data() const { return ptr; }
+    size_t size() const { return length; }
+    bool empty() const { return length == 0; }
+    std::string str() const { return std::string(ptr, length); }
+
+    // 字节序比较，返回负数、0、正数
+    int compare(StringView other) const {
+        int c = std::memcmp(ptr, other.ptr, length < other.length ? length : other.length);
+        if (c != 0) return c;
+        return length < other.length ? -1 : (length > other.length ? 1 : 0);
+    }
+    bool startsWith(StringView prefix) const {
+        return prefix.length <= length && std::memcmp(ptr, prefix.ptr, prefix.length) == 0;
+    }
+    size_t find(StringView needle) const; // 子串首次出现的位置，没有时返回 npos
+};
+
+inline bool operator==(StringView a, StringView b) { return a.size() == b.size() && a.compare(b) == 0; }
+inline bool operator!=(StringView a, StringView b) { return !(a == b); }
+inline bool operator<(StringView a, StringView b) { return a.compare(b) < 0; }
+inline std::ostream& operator<<(std::ostream& out, StringView s) { return out.write(s.data(), s.size()); }
+
+// 字符串池：把大量短字符串依次复制进 64 KB 的大块内存，每个字符串不再单独向堆申请。
+// 单个字符串不能释放，discard 只记账；废弃的字节由使用者在合适的时机整体重排（见 StudentTable）。
+// clear 只释放各个大块，与字符串个数无关。
+// 已写入的字节不会再被修改，所以大块按引用计数持有，shareFrom 得到的副本与原池共享全部大块，
+// 不复制字符串；两边之后新存入的字符串各自写进新的大块
+class StringPool {
+private:
+    static const size_t BLOCK_SIZE = 64 * 1024;
+
+    std::vector<std::shared_ptr<char> > blocks;
+    char* cursor;                      // 当前块中下一个可用字节
+    size_t remaining;                  // 当前块剩余的字节数
+    size_t liveBytes;                  // 仍在使用的字符串字节数
+    size_t wastedBytes;                // discard 过的字节数
+    size_t reservedBytes;              // 已申请的块大小之和
+
+public:
+    StringPool();
+    StringPool(const StringPool&) = delete;
+    StringPool& operator=(const StringPool&) = delete;
+
+    StringView store(StringView value); // 复制到池中，返回的视图在 clear 之前一直有效
+    void discard(StringView value);    // 该字符串不再使用
+    void clear();                      // 释放所有块（仍被其他池共享的块由最后一个持有者释放）
+    void shareFrom(const StringPool& other); // 改为与 other 共享其全部大块，other 中已有的视图在本池中同样有效
+    void swap(StringPool& other);
+
+    size_t bytesLive() const;
+    size_t bytesWasted() const;
+    size_t bytesReserved() const;
+};
+
+#endif // STRINGPOOL_H
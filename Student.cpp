@@ -1,5 +1,6 @@
 #include "Student.h"
 #include <iomanip>
+#include <cstdio>
 
 // 默认构造函数
 Student::Student() : id(0), name(""), age(0), gender(""), major(""), gpa(0.0) {}
@@ -64,12 +65,46 @@ void Student::setGpa(double gpa) {
 
 // 显示学生信息
 void Student::display() const {
-    std::cout << "学号: " << std::setw(8) << id 
-              << " | 姓名: " << std::setw(10) << name 
-              << " | 年龄: " << std::setw(3) << age 
-              << " | 性别: " << std::setw(4) << gender 
-              << " | 专业: " << std::setw(15) << major 
-              << " | 绩点: " << std::fixed << std::setprecision(2) << gpa << std::endl;
+    display(id, name, age, gender, major, gpa);
+}
+
+void Student::display(int id, StringView name, int age, StringView gender,
+                      StringView major, double gpa) {
+    std::string line;
+    formatRow(line, id, name, age, gender, major, gpa);
+    std::cout.write(line.data(), static_cast<std::streamsize>(line.size()));
+}
+
+namespace {
+    // 右对齐到 width 个字节（与 std::setw 作用于字符串时相同）
+    void appendPadded(std::string& out, StringView text, size_t width) {
+        if (text.size() < width) {
+            out.append(width - text.size(), ' ');
+        }
+        out.append(text.data(), text.size());
+    }
+}
+
+// 格式与原来的 std::setw / std::setprecision 输出逐字节相同，但不经过 iostream 格式化
+void Student::formatRow(std::string& out, int id, StringView name, int age,
+                        StringView gender, StringView major, double gpa) {
+    char number[32];
+    out += "学号: ";
+    std::snprintf(number, sizeof(number), "%8d", id);
+    out += number;
+    out += " | 姓名: ";
+    appendPadded(out, name, 10);
+    out += " | 年龄: ";
+    std::snprintf(number, sizeof(number), "%3d", age);
+    out += number;
+    out += " | 性别: ";
+    appendPadded(out, gender, 4);
+    out += " | 专业: ";
+    appendPadded(out, major, 15);
+    out += " | 绩点: ";
+    std::snprintf(number, sizeof(number), "%.2f", gpa);
+    out += number;
+    out += '\n';
 }
 
 // 重载==运算符
@@ -1,6 +1,7 @@
 #ifndef STUDENT_H
 #define STUDENT_H
 
+#include "StringPool.h"
 #include <string>
 #include <iostream>
 
@@ -40,6 +41,10 @@ public:
     
     // 显示学生信息
     void display() const;
+    static void display(int id, StringView name, int age, StringView gender,
+                        StringView major, double gpa); // 按相同格式显示一组字段
+    static void formatRow(std::string& out, int id, StringView name, int age,
+                          StringView gender, StringView major, double gpa); // 把 display 的一行（含换行符）追加到 out
     
     // 重载运算符
     bool operator==(const Student& other) const;
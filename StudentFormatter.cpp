@@ -0,0 +1,45 @@
+#include "StudentFormatter.h"
+
+namespace {
+    // 缓冲区超过该大小时写出一次
+    const size_t FLUSH_BYTES = 1 << 20;
+}
+
+StudentFormatter::StudentFormatter(std::ostream& out) : out(out) {
+    buffer.reserve(FLUSH_BYTES + 256);
+}
+
+StudentFormatter::~StudentFormatter() {
+    flush();
+}
+
+void StudentFormatter::row(const StudentRef& student) {
+    Student::formatRow(buffer, student.getId(), student.getNameView(), student.getAge(),
+                       student.getGenderView(), student.getMajorView(), student.getGpa());
+    if (buffer.size() >= FLUSH_BYTES) {
+        flush();
+    }
+}
+
+void StudentFormatter::row(const Student& student) {
+    Student::formatRow(buffer, student.getId(), student.getName(), student.getAge(),
+                       student.getGender(), student.getMajor(), student.getGpa());
+    if (buffer.size() >= FLUSH_BYTES) {
+        flush();
+    }
+}
+
+void StudentFormatter::line(const std::string& text) {
+    buffer += text;
+    buffer += '\n';
+    if (buffer.size() >= FLUSH_BYTES) {
+        flush();
+    }
+}
+
+void StudentFormatter::flush() {
+    if (!buffer.empty()) {
+        out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        buffer.clear();
+    }
+}
@@ -0,0 +1,29 @@
+#ifndef STUDENTFORMATTER_H
+#define STUDENTFORMATTER_H
+
+#include "Student.h"
+#include "StudentTable.h"
+#include <string>
+#include <ostream>
+
+// 把学生列表渲染成 Student::display 格式的表格：所有行先写入内存缓冲区，
+// 攒够一大块再一次写到输出流（控制台、文件或字符串流），不会每行刷新一次
+class StudentFormatter {
+private:
+    std::ostream& out;                 // 输出目标
+    std::string buffer;                // 尚未写出的内容
+
+    StudentFormatter(const StudentFormatter&);
+    StudentFormatter& operator=(const StudentFormatter&);
+
+public:
+    explicit StudentFormatter(std::ostream& out);
+    ~StudentFormatter();               // 写出剩余内容
+
+    void row(const StudentRef& student); // 一行学生信息
+    void row(const Student& student);
+    void line(const std::string& text);  // 一行文字（自动加换行符）
+    void flush();                        // 把缓冲区写到输出流（不强制输出流刷新）
+};
+
+#endif // STUDENTFORMATTER_H
@@ -1,17 +1,421 @@
 #include "StudentManager.h"
+#include "ThreadPool.h"
+#include "BinarySnapshot.h"
+#include "GpaKernels.h"
+#include "StudentFormatter.h"
 #include <iostream>
 #include <algorithm>
 #include <iomanip>
+#include <cstring>
+#include <cstdio>
 #include <sstream>
+#include <chrono>
+#include <limits>
+#include <cmath>
+#include <climits>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+    // 墓碑数达到该值且超过总槽位一半时自动压缩
+    const size_t COMPACT_MIN_DEAD = 1024;
+    
+    bool endsWith(const std::string& s, const std::string& suffix) {
+        return s.size() >= suffix.size() && s.compare(s.size() - suffix.size(), suffix.size(), suffix) == 0;
+    }
+    
+    // 以 .bin 或 .snap 结尾的文件默认使用二进制快照格式
+    bool isSnapshotPath(const std::string& path) {
+        return endsWith(path, ".bin") || endsWith(path, ".snap");
+    }
+    
+    bool fileExists(const std::string& path) {
+        return ::access(path.c_str(), F_OK) == 0;
+    }
+    
+    // 文件大小，无法读取时为 0
+    uint64_t fileSize(const std::string& path) {
+        struct stat info;
+        return ::stat(path.c_str(), &info) == 0 ? static_cast<uint64_t>(info.st_size) : 0;
+    }
+    
+    // 把文件（或目录）内容刷到磁盘
+    bool fsyncPath(const std::string& path) {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return false;
+        }
+        bool ok = ::fsync(fd) == 0;
+        ::close(fd);
+        return ok;
+    }
+    
+    std::string directoryOf(const std::string& path) {
+        std::string::size_type slash = path.rfind('/');
+        if (slash == std::string::npos) return ".";
+        if (slash == 0) return "/";
+        return path.substr(0, slash);
+    }
+    
+    // 按指定格式、按 rows 给出的行号顺序写出学生，失败时返回 false 并填写 error
+    bool writeStudents(const std::string& path, StorageFormat format,
+                       const StudentTable& students, const std::vector<size_t>& rows,
+                       std::string& error) {
+        if (format == FORMAT_AUTO) {
+            format = isSnapshotPath(path) ? FORMAT_BINARY : FORMAT_TEXT;
+        }
+        
+        if (format == FORMAT_BINARY) {
+            return BinarySnapshot::save(path, students, rows, error);
+        }
+        
+        std::ofstream file(path);
+        if (!file.is_open()) {
+            error = "无法打开文件 " + path + " 进行写入";
+            return false;
+        }
+        
+        for (size_t i = 0; i < rows.size(); ++i) {
+            StudentRef student = students.at(rows[i]);
+            file << student.getId() << "," 
+                 << student.getNameView() << "," 
+                 << student.getAge() << "," 
+                 << student.getGender() << "," 
+                 << student.getMajor() << "," 
+                 << student.getGpa() << "\n";
+        }
+        file.close();
+        if (!file) {
+            error = "写入文件 " + path + " 失败";
+            return false;
+        }
+        return true;
+    }
+    
+    // 先写临时文件并 fsync，再改名替换数据文件：任何一步失败都保留旧数据文件。返回错误信息，成功时为空
+    std::string replaceDataFile(const std::string& path, StorageFormat format,
+                                const StudentTable& students, const std::vector<size_t>& rows) {
+        if (format == FORMAT_AUTO) {
+            format = isSnapshotPath(path) ? FORMAT_BINARY : FORMAT_TEXT;
+        }
+        std::string tmp = path + ".tmp";
+        std::string error;
+        if (!writeStudents(tmp, format, students, rows, error)) {
+            std::remove(tmp.c_str());
+            return error;
+        }
+        if (!fsyncPath(tmp) || std::rename(tmp.c_str(), path.c_str()) != 0) {
+            std::remove(tmp.c_str());
+            return "无法替换数据文件 " + path;
+        }
+        fsyncPath(directoryOf(path));
+        return std::string();
+    }
+    
+    // 把保存结果交给等待的 future 与回调（不为空时）
+    void notifySaved(const std::shared_ptr<std::promise<bool> >& result, const SaveCallback& done, bool saved) {
+        if (result) {
+            result->set_value(saved);
+        }
+        if (done) {
+            done(saved);
+        }
+    }
+    
+    // 检查点：按 rows 的顺序写出快照、替换数据文件后删除已并入快照的日志段（sealedLog 不为空时）。
+    // 替换失败时保留旧数据文件和日志段，下次加载时重放即可恢复。返回错误信息，成功时为空
+    std::string writeCheckpoint(std::string path, StorageFormat format, std::string sealedLog,
+                                std::shared_ptr<StudentTable> students, std::vector<size_t> rows,
+                                std::shared_ptr<std::promise<bool> > result, SaveCallback done) {
+        std::string error = replaceDataFile(path, format, *students, rows);
+        if (error.empty() && !sealedLog.empty()) {
+            std::remove(sealedLog.c_str());
+        }
+        notifySaved(result, done, error.empty());
+        return error;
+    }
+    
+    // 按分页参数筛选逐个产生的匹配结果：跳过前 offset 条，把之后的交给回调，取满 limit 条即停
+    class PageFilter {
+    private:
+        const StudentVisitor& visit;
+        size_t skip;                   // 还要跳过的条数
+        size_t remaining;              // 还能交出的条数（limit 为 0 时不使用）
+        bool unlimited;
+        size_t emitted;                // 已交出的条数
+        
+    public:
+        PageFilter(const StudentVisitor& visit, const QueryPage& page)
+            : visit(visit), skip(page.offset), remaining(page.limit), unlimited(page.limit == 0), emitted(0) {}
+        
+        // 提交一条匹配结果，返回 false 表示应停止扫描
+        bool offer(const StudentRef& student) {
+            if (skip > 0) {
+                --skip;
+                return true;
+            }
+            ++emitted;
+            if (!visit(student)) {
+                return false;
+            }
+            return unlimited || --remaining > 0;
+        }
+        
+        size_t count() const { return emitted; }
+    };
+    
+    // 把流式查询的结果收集到 out
+    StudentVisitor appendTo(std::vector<StudentRef>& out) {
+        return [&out](const StudentRef& student) {
+            out.push_back(student);
+            return true;
+        };
+    }
+    
+    // 组合查询估计条件命中率时最多抽样的行数
+    const size_t QUERY_SAMPLE_ROWS = 512;
+    
+    // 通过有序索引或姓名索引取候选行时，每行的开销相对顺序扫描的倍数（树上遍历 + 随机访问各列）
+    const double INDEX_ROW_COST = 3.0;
+    
+    // 结果排序时每次比较的开销（同上单位）
+    const double COMPARE_COST = 1.0;
+    
+    // 绑定到表上的查询条件：列指针预先取好，性别、专业的等值比较换成字典编码
+    struct BoundCondition {
+        QueryCondition condition;
+        const int* ints;               // 学号或年龄列
+        const double* gpas;            // 绩点列
+        const StringView* names;       // 姓名列
+        const StringDictionary::Code* codes; // 性别或专业编码列
+        const StringDictionary* dictionary;
+        int code;                      // =、!= 比较的字典编码，-1 表示字典中没有该取值
+        double selectivity;            // 抽样估计的命中率
+        int cost;                      // 相对求值开销：数值与编码比较为 1，字符串比较为 4
+    };
+    
+    BoundCondition bindCondition(const StudentTable& table, const QueryCondition& condition) {
+        BoundCondition bound;
+        bound.condition = condition;
+        bound.ints = nullptr;
+        bound.gpas = nullptr;
+        bound.names = nullptr;
+        bound.codes = nullptr;
+        bound.dictionary = nullptr;
+        bound.code = -1;
+        bound.selectivity = 1.0;
+        bound.cost = 1;
+        switch (condition.field) {
+            case FIELD_ID:
+                bound.ints = table.idColumn().data();
+                break;
+            case FIELD_AGE:
+                bound.ints = table.ageColumn().data();
+                break;
+            case FIELD_GPA:
+                bound.gpas = table.gpaColumn().data();
+                break;
+            case FIELD_NAME:
+                bound.names = table.nameColumn().data();
+                bound.cost = 4;
+                break;
+            default: {
+                bool gender = condition.field == FIELD_GENDER;
+                bound.codes = gender ? table.genderColumn().data() : table.majorColumn().data();
+                bound.dictionary = gender ? &table.genderDictionary() : &table.majorDictionary();
+                if (condition.op == OP_EQ || condition.op == OP_NE) {
+                    bound.code = bound.dictionary->find(condition.text);
+                } else {
+                    bound.cost = 4;
+                }
+                break;
+            }
+        }
+        return bound;
+    }
+    
+    bool compareNumber(double value, QueryOp op, double operand) {
+        switch (op) {
+            case OP_EQ: return value == operand;
+            case OP_NE: return value != operand;
+            case OP_LT: return value < operand;
+            case OP_LE: return value <= operand;
+            case OP_GT: return value > operand;
+            case OP_GE: return value >= operand;
+            default: return false;
+        }
+    }
+    
+    bool compareText(StringView value, QueryOp op, StringView operand) {
+        switch (op) {
+            case OP_CONTAINS: return value.find(operand) != StringView::npos;
+            case OP_PREFIX: return value.startsWith(operand);
+            default: return compareNumber(value.compare(operand), op, 0);
+        }
+    }
+    
+    bool evaluate(const BoundCondition& bound, size_t row) {
+        const QueryCondition& condition = bound.condition;
+        if (bound.ints) return compareNumber(bound.ints[row], condition.op, condition.number);
+        if (bound.gpas) return compareNumber(bound.gpas[row], condition.op, condition.number);
+        if (bound.names) return compareText(bound.names[row], condition.op, condition.text);
+        if (condition.op == OP_EQ) return bound.code != -1 && bound.codes[row] == bound.code;
+        if (condition.op == OP_NE) return bound.code == -1 || bound.codes[row] != bound.code;
+        return compareText(bound.dictionary->lookup(bound.codes[row]), condition.op, condition.text);
+    }
+    
+    // 在候选行号 rows[0..count) 上逐个检查 test(column[row])，把满足的行号依次前移，返回保留的个数
+    template <typename Value, typename Test>
+    size_t keepIf(size_t* rows, size_t count, const Value* column, Test test) {
+        size_t kept = 0;
+        for (size_t i = 0; i < count; ++i) {
+            size_t row = rows[i];
+            rows[kept] = row;
+            kept += test(column[row]) ? 1 : 0;
+        }
+        return kept;
+    }
+    
+    template <typename Value>
+    size_t keepCompare(size_t* rows, size_t count, const Value* column, QueryOp op, double operand) {
+        switch (op) {
+            case OP_EQ: return keepIf(rows, count, column, [operand](Value v) { return v == operand; });
+            case OP_NE: return keepIf(rows, count, column, [operand](Value v) { return v != operand; });
+            case OP_LT: return keepIf(rows, count, column, [operand](Value v) { return v < operand; });
+            case OP_LE: return keepIf(rows, count, column, [operand](Value v) { return v <= operand; });
+            case OP_GT: return keepIf(rows, count, column, [operand](Value v) { return v > operand; });
+            case OP_GE: return keepIf(rows, count, column, [operand](Value v) { return v >= operand; });
+            default: return 0;
+        }
+    }
+    
+    // 对一批候选行求值一个条件（一次只读一列），返回保留的个数
+    size_t filterRows(const BoundCondition& bound, size_t* rows, size_t count) {
+        const QueryCondition& condition = bound.condition;
+        if (bound.ints) return keepCompare(rows, count, bound.ints, condition.op, condition.number);
+        if (bound.gpas) return keepCompare(rows, count, bound.gpas, condition.op, condition.number);
+        if (bound.codes && (condition.op == OP_EQ || condition.op == OP_NE)) {
+            if (bound.code == -1) return condition.op == OP_EQ ? 0 : count;
+            StringDictionary::Code code = static_cast<StringDictionary::Code>(bound.code);
+            if (condition.op == OP_EQ) {
+                return keepIf(rows, count, bound.codes, [code](StringDictionary::Code v) { return v == code; });
+            }
+            return keepIf(rows, count, bound.codes, [code](StringDictionary::Code v) { return v != code; });
+        }
+        size_t kept = 0;
+        for (size_t i = 0; i < count; ++i) {
+            rows[kept] = rows[i];
+            kept += evaluate(bound, rows[i]) ? 1 : 0;
+        }
+        return kept;
+    }
+    
+    // 查询结果的排列顺序：按某个字段（相同时按行号），或只按行号（存储顺序）。
+    // 绩点为 NaN 的行无论升序降序都排在最后，与绩点有序索引一致
+    class RowOrder {
+    private:
+        const StudentTable& table;
+        const int* ids;
+        const int* ages;
+        const double* gpas;
+        const StringView* names;
+        bool byRow;
+        QueryField field;
+        bool descending;
+        
+        static int sign(double a, double b) { return a < b ? -1 : (b < a ? 1 : 0); }
+        
+        int compareField(size_t a, size_t b) const {
+            switch (field) {
+                case FIELD_ID: return sign(ids[a], ids[b]);
+                case FIELD_AGE: return sign(ages[a], ages[b]);
+                case FIELD_GPA: return sign(gpas[a], gpas[b]);
+                case FIELD_NAME: return names[a].compare(names[b]);
+                case FIELD_GENDER: return table.genderOf(a).compare(table.genderOf(b));
+                default: return table.majorOf(a).compare(table.majorOf(b));
+            }
+        }
+        
+    public:
+        RowOrder(const StudentTable& table, bool byRow, QueryField field, bool descending)
+            : table(table), ids(table.idColumn().data()), ages(table.ageColumn().data()),
+              gpas(table.gpaColumn().data()), names(table.nameColumn().data()),
+              byRow(byRow), field(field), descending(descending) {}
+        
+        bool operator()(size_t a, size_t b) const {
+            if (!byRow) {
+                if (field == FIELD_GPA) {
+                    bool nanA = std::isnan(gpas[a]), nanB = std::isnan(gpas[b]);
+                    if (nanA != nanB) return nanB;
+                }
+                int c = compareField(a, b);
+                if (c != 0) return descending ? c > 0 : c < 0;
+            }
+            return a < b;
+        }
+    };
+    
+    // 组合查询的访问路径
+    enum AccessKind {
+        ACCESS_SCAN,                   // 按存储顺序扫描全表
+        ACCESS_ID_LOOKUP,              // 学号哈希索引查找
+        ACCESS_ID_RANGE,               // 学号有序索引上的区间
+        ACCESS_NAME_PREFIX,            // 姓名有序索引上的前缀区间
+        ACCESS_NAME_SEARCH,            // 姓名 n-gram 索引
+        ACCESS_GPA_RANGE,              // 绩点有序索引上的区间
+        ACCESS_INDEX_ORDER             // 按结果顺序遍历整个有序索引
+    };
+    
+    struct AccessPath {
+        AccessKind kind;
+        double fraction;               // 候选行占存活行的比例（估计）
+        double rows;                   // 估计要检查的行数
+        double cost;                   // 估计开销（以顺序扫描一行为单位）
+        bool ordered;                  // 候选行是否已按结果顺序排列
+        std::string description;
+        int minId, maxId;
+        double minGpa, maxGpa;
+        std::string text;              // 姓名前缀或关键字
+        SortKey key;                   // ACCESS_INDEX_ORDER 遍历的索引
+    };
+    
+    std::string percent(double fraction) {
+        std::ostringstream text;
+        text << std::fixed << std::setprecision(fraction < 0.01 ? 2 : 1) << fraction * 100 << "%";
+        return text.str();
+    }
+}
 
 // 构造函数
-StudentManager::StudentManager(const std::string& filename) : filename(filename) {
-    loadFromFile();
+StudentManager::StudentManager(const std::string& filename, const ManagerOptions& options)
+    : deadCount(0), filename(filename), options(options), sortedIndexes(students), nameIndex(students), statistics(students),
+      sortOrder(SORT_NONE), inTransaction(false), sortOrderBeforeTransaction(SORT_NONE), changeCount(0), savingChangeCount(0),
+      savedChangeCount(UINT64_MAX), lastSaveStarted(std::chrono::steady_clock::now()) {
+    if (!filename.empty()) {
+        loadFromFile();
+    }
 }
 
-// 析构函数
+// 析构函数：启用日志时只需把剩余日志写盘，否则整体保存（后台保存已包含全部修改时不再重写）
 StudentManager::~StudentManager() {
-    saveToFile();
+    if (inTransaction) {
+        // 未提交的事务直接丢弃：期间的修改没有写日志，也不保存
+        rollbackTransaction(false);
+        return;
+    }
+    waitForCheckpoint();
+    if (wal) {
+        if (!wal->sync()) {
+            // 日志写不进去，改为把全部数据写成新快照（成功后日志被清空）
+            report("错误：写入日志失败，改为整体保存数据文件！");
+            saveToFile();
+        }
+        wal.reset();
+    } else if (!filename.empty() && savedChangeCount != changeCount) {
+        saveToFile();
+    }
 }
 
 // 检查学号是否有效（不重复）
@@ -21,259 +425,1806 @@ bool StudentManager::isValidId(int id) const {
 
 // 根据学号查找学生索引
 int StudentManager::findStudentIndex(int id) const {
+    return idIndex.find(id);
+}
+
+// 重建学号索引（压缩、排序等改变元素位置的操作之后调用）
+void StudentManager::rebuildIndex() {
+    idIndex.clear();
+    idIndex.reserve(students.size());
     for (size_t i = 0; i < students.size(); ++i) {
-        if (students[i].getId() == id) {
-            return static_cast<int>(i);
+        if (alive[i]) {
+            idIndex.insert(students.idColumn()[i], static_cast<int>(i));
         }
     }
-    return -1;
+}
+
+// 追加一条记录，调用方保证学号不重复
+void StudentManager::insertRecord(const Student& student) {
+    students.append(student);
+    alive.push_back(1);
+    idIndex.insert(student.getId(), static_cast<int>(students.size() - 1));
+    sortedIndexes.insert(static_cast<int>(students.size() - 1));
+    nameIndex.insert(static_cast<int>(students.size() - 1));
+    statistics.add(students.size() - 1);
+}
+
+// 删除记录：只打墓碑标记，不移动后面的元素；姓名占用的字符串池空间在重排时回收
+void StudentManager::removeRecord(int index) {
+    idIndex.erase(students.idColumn()[index]);
+    sortedIndexes.erase(index);
+    nameIndex.erase(index);
+    statistics.remove(index);
+    students.release(index);
+    alive[index] = 0;
+    ++deadCount;
+    maybeCompact();
+}
+
+// 原位覆盖记录，调用方保证新学号不与其他学生重复
+void StudentManager::replaceRecord(int index, const Student& student) {
+    if (students.idColumn()[index] != student.getId()) {
+        idIndex.erase(students.idColumn()[index]);
+        idIndex.insert(student.getId(), index);
+    }
+    sortedIndexes.erase(index);
+    nameIndex.erase(index);
+    statistics.remove(index);
+    students.assign(index, student);
+    sortedIndexes.insert(index);
+    nameIndex.insert(index);
+    statistics.add(index);
 }
 
 // 添加学生
 bool StudentManager::addStudent(const Student& student) {
+    OperationTimer timer(metrics, METRIC_ADD);
     if (!isValidId(student.getId())) {
-        std::cout << "错误：学号 " << student.getId() << " 已存在！" << std::endl;
+        report("错误：学号 " + std::to_string(student.getId()) + " 已存在！");
         return false;
     }
     
-    students.push_back(student);
-    std::cout << "学生添加成功！" << std::endl;
+    insertRecord(student);
+    bool logged = !wal || checkLogged(wal->appendPut(student));
+    noteChanges(1);
+    if (!logged) {
+        return false;
+    }
+    report("学生添加成功！");
     return true;
 }
 
 // 删除学生
 bool StudentManager::deleteStudent(int id) {
+    OperationTimer timer(metrics, METRIC_DELETE);
     int index = findStudentIndex(id);
     if (index == -1) {
-        std::cout << "错误：未找到学号为 " << id << " 的学生！" << std::endl;
+        report("错误：未找到学号为 " + std::to_string(id) + " 的学生！");
         return false;
     }
     
-    students.erase(students.begin() + index);
-    std::cout << "学生删除成功！" << std::endl;
+    removeRecord(index);
+    bool logged = !wal || checkLogged(wal->appendDelete(id));
+    noteChanges(1);
+    if (!logged) {
+        return false;
+    }
+    report("学生删除成功！");
     return true;
 }
 
 // 更新学生信息
 bool StudentManager::updateStudent(int id, const Student& newInfo) {
+    OperationTimer timer(metrics, METRIC_UPDATE);
     int index = findStudentIndex(id);
     if (index == -1) {
-        std::cout << "错误：未找到学号为 " << id << " 的学生！" << std::endl;
+        report("错误：未找到学号为 " + std::to_string(id) + " 的学生！");
+        return false;
+    }
+    
+    if (newInfo.getId() != id && !isValidId(newInfo.getId())) {
+        report("错误：学号 " + std::to_string(newInfo.getId()) + " 已存在！");
         return false;
     }
     
-    students[index] = newInfo;
-    std::cout << "学生信息更新成功！" << std::endl;
+    replaceRecord(index, newInfo);
+    bool logged = !wal || checkLogged(wal->appendUpdate(id, newInfo));
+    noteChanges(1);
+    if (!logged) {
+        return false;
+    }
+    report("学生信息更新成功！");
     return true;
 }
 
 // 查找学生
-Student* StudentManager::findStudent(int id) {
+StudentRef StudentManager::findStudent(int id) const {
+    OperationTimer timer(metrics, METRIC_FIND);
     int index = findStudentIndex(id);
     if (index == -1) {
-        return nullptr;
+        return StudentRef();
     }
-    return &students[index];
+    return students.at(index);
 }
 
-// 显示所有学生
-void StudentManager::displayAllStudents() const {
-    if (students.empty()) {
-        std::cout << "暂无学生信息！" << std::endl;
-        return;
-    }
-    
-    std::cout << "\n========== 所有学生信息 ==========" << std::endl;
-    std::cout << std::string(80, '-') << std::endl;
-    for (const auto& student : students) {
-        student.display();
-    }
-    std::cout << std::string(80, '-') << std::endl;
-    std::cout << "总计：" << students.size() << " 名学生" << std::endl;
+// 按显示顺序列出所有学生
+std::vector<StudentRef> StudentManager::getAllStudents(const QueryPage& page) const {
+    std::vector<StudentRef> result;
+    size_t total = static_cast<size_t>(getTotalStudents());
+    result.reserve(page.offset >= total ? 0 : std::min(total - page.offset, page.limit != 0 ? page.limit : total));
+    scanStudents(appendTo(result), page);
+    return result;
 }
 
-// 按专业显示学生
-void StudentManager::displayStudentsByMajor(const std::string& major) const {
-    std::cout << "\n========== 专业：" << major << " ==========" << std::endl;
-    bool found = false;
-    for (const auto& student : students) {
-        if (student.getMajor() == major) {
-            student.display();
-            found = true;
-        }
-    }
-    if (!found) {
-        std::cout << "未找到该专业的学生！" << std::endl;
-    }
+// 按显示顺序逐个访问学生，不生成列表
+void StudentManager::forEachStudent(const std::function<void(const StudentRef&)>& visit) const {
+    OperationTimer timer(metrics, METRIC_LIST);
+    forEachRow([&](size_t row) {
+        visit(students.at(row));
+    });
 }
 
-// 按绩点显示学生
-void StudentManager::displayStudentsByGpa(double minGpa) const {
-    std::cout << "\n========== 绩点 >= " << minGpa << " 的学生 ==========" << std::endl;
-    bool found = false;
-    for (const auto& student : students) {
-        if (student.getGpa() >= minGpa) {
-            student.display();
-            found = true;
-        }
-    }
-    if (!found) {
-        std::cout << "未找到符合条件的学生！" << std::endl;
-    }
+// 按专业筛选（按显示顺序）
+std::vector<StudentRef> StudentManager::getStudentsByMajor(const std::string& major, const QueryPage& page) const {
+    std::vector<StudentRef> result;
+    scanByMajor(major, appendTo(result), page);
+    return result;
 }
 
-// 获取学生总数
-int StudentManager::getTotalStudents() const {
-    return static_cast<int>(students.size());
+// 绩点不低于 minGpa 的学生（按显示顺序）
+std::vector<StudentRef> StudentManager::getStudentsByMinGpa(double minGpa, const QueryPage& page) const {
+    std::vector<StudentRef> result;
+    scanByMinGpa(minGpa, appendTo(result), page);
+    return result;
 }
 
-// 获取平均绩点
-double StudentManager::getAverageGpa() const {
-    if (students.empty()) {
-        return 0.0;
-    }
-    
-    double total = 0.0;
-    for (const auto& student : students) {
-        total += student.getGpa();
-    }
-    return total / students.size();
+// 流式列出所有学生
+size_t StudentManager::scanStudents(const StudentVisitor& visit, const QueryPage& page) const {
+    OperationTimer timer(metrics, METRIC_LIST);
+    PageFilter filter(visit, page);
+    scanRows([&](size_t row) {
+        return filter.offer(students.at(row));
+    });
+    return filter.count();
 }
 
-// 显示统计信息
-void StudentManager::getStatistics() const {
-    std::cout << "\n========== 统计信息 ==========" << std::endl;
-    std::cout << "学生总数：" << getTotalStudents() << std::endl;
-    std::cout << "平均绩点：" << std::fixed << std::setprecision(2) << getAverageGpa() << std::endl;
-    
-    if (!students.empty()) {
-        auto maxGpa = std::max_element(students.begin(), students.end(),
-            [](const Student& a, const Student& b) {
-                return a.getGpa() < b.getGpa();
-            });
-        auto minGpa = std::min_element(students.begin(), students.end(),
-            [](const Student& a, const Student& b) {
-                return a.getGpa() < b.getGpa();
-            });
-        
-        std::cout << "最高绩点：" << maxGpa->getGpa() << " (" << maxGpa->getName() << ")" << std::endl;
-        std::cout << "最低绩点：" << minGpa->getGpa() << " (" << minGpa->getName() << ")" << std::endl;
+// 流式按专业筛选
+size_t StudentManager::scanByMajor(const std::string& major, const StudentVisitor& visit,
+                                   const QueryPage& page) const {
+    OperationTimer timer(metrics, METRIC_SEARCH_MAJOR);
+    // 专业按字典编码存储：先把查询的专业换成编码，扫描时只比较 2 字节整数
+    int code = students.majorDictionary().find(major);
+    if (code == -1) {
+        return 0;
     }
+    const std::vector<StringDictionary::Code>& majors = students.majorColumn();
+    PageFilter filter(visit, page);
+    scanRows([&](size_t row) {
+        return majors[row] != code || filter.offer(students.at(row));
+    });
+    return filter.count();
 }
 
-// 按学号排序
-void StudentManager::sortById() {
-    std::sort(students.begin(), students.end(),
-        [](const Student& a, const Student& b) {
-            return a.getId() < b.getId();
+// 流式按最低绩点筛选
+size_t StudentManager::scanByMinGpa(double minGpa, const StudentVisitor& visit, const QueryPage& page) const {
+    OperationTimer timer(metrics, METRIC_FILTER_GPA);
+    PageFilter filter(visit, page);
+    auto offer = [&](size_t row) {
+        return filter.offer(students.at(row));
+    };
+    
+    // 已按绩点排序时直接在有序索引上取区间
+    if (sortOrder == SORT_BY_GPA) {
+        ensureSorted(SORT_BY_GPA).visitGpaRange(minGpa, std::numeric_limits<double>::infinity(), offer);
+        return filter.count();
+    }
+    
+    // 只取一页时逐行比较，取满即停；取全部结果时先用 SIMD 内核生成整列的筛选位图
+    const std::vector<double>& gpas = students.gpaColumn();
+    if (page.limit != 0) {
+        scanRows([&](size_t row) {
+            return !(gpas[row] >= minGpa) || offer(row);
         });
-    std::cout << "已按学号排序！" << std::endl;
+        return filter.count();
+    }
+    std::vector<uint64_t> bitmap;
+    if (scanGpa(minGpa, &bitmap).count == 0) {
+        return 0;
+    }
+    if (sortOrder == SORT_NONE) {
+        for (size_t word = 0; word < bitmap.size(); ++word) {
+            for (uint64_t bits = bitmap[word]; bits != 0; bits &= bits - 1) {
+                if (!offer(word * 64 + __builtin_ctzll(bits))) {
+                    return filter.count();
+                }
+            }
+        }
+        return filter.count();
+    }
+    scanRows([&](size_t row) {
+        return !(bitmap[row / 64] & (1ULL << (row % 64))) || offer(row);
+    });
+    return filter.count();
 }
 
-// 按姓名排序
-void StudentManager::sortByName() {
-    std::sort(students.begin(), students.end(),
-        [](const Student& a, const Student& b) {
-            return a.getName() < b.getName();
-        });
-    std::cout << "已按姓名排序！" << std::endl;
+// 流式按姓名搜索：在姓名索引上取出全部匹配的行号，按显示顺序排列后只访问请求的一页
+size_t StudentManager::scanByName(const std::string& name, const StudentVisitor& visit,
+                                  const QueryPage& page) const {
+    if (name.empty()) {
+        return scanStudents(visit, page);
+    }
+    OperationTimer timer(metrics, METRIC_SEARCH_NAME);
+    std::vector<size_t> rows;
+    ensureNameIndex().search(name, 0, rows);
+    sortByDisplayOrder(rows);
+    return scanPage(rows, visit, page);
 }
 
-// 按绩点排序
-void StudentManager::sortByGpa() {
-    std::sort(students.begin(), students.end(),
-        [](const Student& a, const Student& b) {
-            return a.getGpa() > b.getGpa();
-        });
-    std::cout << "已按绩点排序（从高到低）！" << std::endl;
+// 访问 rows 中 page 指定的一页
+size_t StudentManager::scanPage(const std::vector<size_t>& rows, const StudentVisitor& visit,
+                                const QueryPage& page) const {
+    PageFilter filter(visit, QueryPage(0, page.limit));
+    for (size_t i = page.offset; i < rows.size(); ++i) {
+        if (!filter.offer(students.at(rows[i]))) {
+            break;
+        }
+    }
+    return filter.count();
 }
 
-// 保存到文件
-bool StudentManager::saveToFile() const {
-    std::ofstream file(filename);
-    if (!file.is_open()) {
-        std::cout << "错误：无法打开文件 " << filename << " 进行写入！" << std::endl;
-        return false;
+// 组合查询：抽样估计命中率 → 选择访问路径 → 按命中率从低到高求值条件 → 排序/取前 k 条
+QueryResult StudentManager::query(const StudentQuery& spec) const {
+    OperationTimer timer(metrics, METRIC_QUERY);
+    QueryResult result;
+    const size_t total = static_cast<size_t>(getTotalStudents());
+    
+    // 1. 绑定条件，在等间隔抽取的存活行上估计每个条件及全部条件的命中率
+    std::vector<BoundCondition> conditions;
+    for (size_t i = 0; i < spec.getConditions().size(); ++i) {
+        conditions.push_back(bindCondition(students, spec.getConditions()[i]));
     }
+    std::vector<size_t> sample;
+    size_t step = std::max<size_t>(1, students.size() / QUERY_SAMPLE_ROWS);
+    for (size_t i = 0; i < students.size(); i += step) {
+        if (alive[i]) sample.push_back(i);
+    }
+    std::vector<char> sampleMatches(sample.size(), 1);
+    for (size_t c = 0; c < conditions.size(); ++c) {
+        BoundCondition& condition = conditions[c];
+        if (condition.codes && condition.condition.op == OP_EQ && condition.code == -1) {
+            // 字典中没有该取值，不可能命中
+            result.plan = StudentQuery::describe(condition.condition) + "：该取值不存在，结果为空";
+            return result;
+        }
+        size_t hits = 0;
+        for (size_t j = 0; j < sample.size(); ++j) {
+            if (evaluate(condition, sample[j])) {
+                ++hits;
+            } else {
+                sampleMatches[j] = 0;
+            }
+        }
+        condition.selectivity = (hits + 0.5) / (sample.size() + 1.0);
+    }
+    double combined = (std::count(sampleMatches.begin(), sampleMatches.end(), 1) + 0.5) / (sample.size() + 1.0);
+    std::stable_sort(conditions.begin(), conditions.end(), [](const BoundCondition& a, const BoundCondition& b) {
+        return a.selectivity < b.selectivity || (a.selectivity == b.selectivity && a.cost < b.cost);
+    });
+    
+    // 某个字段上可以用 usable 运算符表示的条件同时成立的比例（抽样估计）
+    auto fieldFraction = [&](QueryField field, bool (*usable)(QueryOp)) {
+        size_t hits = 0;
+        for (size_t j = 0; j < sample.size(); ++j) {
+            bool ok = true;
+            for (size_t c = 0; c < conditions.size() && ok; ++c) {
+                if (conditions[c].condition.field == field && usable(conditions[c].condition.op)) {
+                    ok = evaluate(conditions[c], sample[j]);
+                }
+            }
+            hits += ok;
+        }
+        return (hits + 0.5) / (sample.size() + 1.0);
+    };
+    auto isBound = [](QueryOp op) {
+        return op == OP_EQ || op == OP_LT || op == OP_LE || op == OP_GT || op == OP_GE;
+    };
     
-    for (const auto& student : students) {
-        file << student.getId() << "," 
-             << student.getName() << "," 
-             << student.getAge() << "," 
-             << student.getGender() << "," 
-             << student.getMajor() << "," 
-             << student.getGpa() << std::endl;
+    // 2. 结果顺序：指定了排序字段时按该字段，否则按当前显示顺序
+    bool byRow = false;
+    QueryField orderField = spec.getOrderField();
+    bool descending = spec.isDescending();
+    if (!spec.isOrdered()) {
+        switch (sortOrder) {
+            case SORT_BY_ID: orderField = FIELD_ID; descending = false; break;
+            case SORT_BY_NAME: orderField = FIELD_NAME; descending = false; break;
+            case SORT_BY_GPA: orderField = FIELD_GPA; descending = true; break;
+            default: byRow = true; break;
+        }
     }
+    RowOrder order(students, byRow, orderField, descending);
+    // 与结果顺序一致的有序索引（学号升序、姓名升序、绩点降序）
+    SortKey orderKey = SORT_NONE;
+    if (!byRow && orderField == FIELD_ID && !descending) orderKey = SORT_BY_ID;
+    if (!byRow && orderField == FIELD_NAME && !descending) orderKey = SORT_BY_NAME;
+    if (!byRow && orderField == FIELD_GPA && descending) orderKey = SORT_BY_GPA;
     
-    file.close();
-    return true;
-}
-
-// 从文件加载
-bool StudentManager::loadFromFile() {
-    std::ifstream file(filename);
-    if (!file.is_open()) {
-        // 文件不存在是正常的，创建新文件
-        return true;
+    size_t need = spec.getLimit() == 0 ? 0 : spec.getOffset() + spec.getLimit();
+    bool canStop = need != 0 && !spec.wantsStatistics();
+    
+    // 3. 列出可用的访问路径，估计各自要检查的行数，选开销最小的
+    std::vector<AccessPath> paths;
+    auto addPath = [&](AccessKind kind, double fraction, bool ordered, double rowCost, const std::string& description) {
+        AccessPath path;
+        path.kind = kind;
+        path.fraction = fraction;
+        path.ordered = ordered;
+        double rows = fraction * total;
+        if (ordered && canStop) {
+            // 候选行已有序：其中满足其余条件的比例为 combined / fraction，取满 need 条即停止
+            rows = std::min(rows, need * fraction / combined);
+        }
+        path.rows = rows;
+        path.cost = rows * rowCost;
+        if (!ordered) {
+            // 候选行无序时还要排序：有 limit 时为堆上 O(m log need)，否则为整体排序 O(m log m)
+            double matches = combined * total;
+            path.cost += matches * std::log2((need != 0 ? need : matches) + 1.0) * COMPARE_COST;
+        }
+        path.description = description;
+        path.minId = INT_MIN;
+        path.maxId = INT_MAX;
+        path.minGpa = -std::numeric_limits<double>::infinity();
+        path.maxGpa = std::numeric_limits<double>::infinity();
+        path.key = SORT_NONE;
+        paths.push_back(path);
+        return &paths.back();
+    };
+    paths.reserve(8);                  // addPath 返回的指针在添加其余路径后仍然有效
+    addPath(ACCESS_SCAN, 1.0, byRow, 1.0, "全表扫描");
+    
+    double idLow = -std::numeric_limits<double>::infinity(), idHigh = std::numeric_limits<double>::infinity();
+    double gpaLow = idLow, gpaHigh = idHigh;
+    bool idBounded = false, gpaBounded = false;
+    const QueryCondition* nameContains = nullptr;
+    const QueryCondition* namePrefix = nullptr;
+    for (size_t c = 0; c < conditions.size(); ++c) {
+        const QueryCondition& condition = conditions[c].condition;
+        if ((condition.field == FIELD_ID || condition.field == FIELD_GPA) && isBound(condition.op)) {
+            double& low = condition.field == FIELD_ID ? idLow : gpaLow;
+            double& high = condition.field == FIELD_ID ? idHigh : gpaHigh;
+            if (condition.op != OP_LT && condition.op != OP_LE) low = std::max(low, condition.number);
+            if (condition.op != OP_GT && condition.op != OP_GE) high = std::min(high, condition.number);
+            (condition.field == FIELD_ID ? idBounded : gpaBounded) = true;
+        }
+        if (condition.field == FIELD_NAME && condition.op == OP_CONTAINS && !condition.text.empty() && !nameContains) {
+            nameContains = &condition;
+        }
+        if (condition.field == FIELD_NAME && (condition.op == OP_PREFIX || condition.op == OP_EQ) && !namePrefix) {
+            namePrefix = &condition;
+        }
     }
     
-    students.clear();
-    std::string line;
-    while (std::getline(file, line)) {
-        if (line.empty()) continue;
-        
-        std::stringstream ss(line);
-        std::string item;
-        std::vector<std::string> tokens;
-        
-        while (std::getline(ss, item, ',')) {
-            tokens.push_back(item);
+    if (idBounded && idLow == idHigh) {
+        AccessPath* path = addPath(ACCESS_ID_LOOKUP, 0.0, true, 1.0, "学号哈希索引查找");
+        path->rows = path->cost = 1.0;
+        if (idLow >= INT_MIN && idLow <= INT_MAX && idLow == std::floor(idLow)) {
+            path->minId = path->maxId = static_cast<int>(idLow);
+        } else {
+            path->minId = 0;           // 不是 int 范围内的整数，不会命中
+            path->maxId = -1;
         }
-        
-        if (tokens.size() == 6) {
-            try {
-                int id = std::stoi(tokens[0]);
-                std::string name = tokens[1];
-                int age = std::stoi(tokens[2]);
-                std::string gender = tokens[3];
-                std::string major = tokens[4];
-                double gpa = std::stod(tokens[5]);
-                
-                students.emplace_back(id, name, age, gender, major, gpa);
-            } catch (const std::exception& e) {
-                std::cout << "警告：读取文件时跳过无效行：" << line << std::endl;
+    } else if (idBounded && sortedIndexes.isBuilt(SORT_BY_ID)) {
+        AccessPath* path = addPath(ACCESS_ID_RANGE, fieldFraction(FIELD_ID, isBound), orderKey == SORT_BY_ID,
+                                   INDEX_ROW_COST, "学号有序索引区间");
+        if (idLow > INT_MAX || idHigh < INT_MIN || idLow > idHigh) {
+            path->minId = 0;           // 区间为空
+            path->maxId = -1;
+        } else {
+            path->minId = idLow < INT_MIN ? INT_MIN : static_cast<int>(std::ceil(idLow));
+            path->maxId = idHigh > INT_MAX ? INT_MAX : static_cast<int>(std::floor(idHigh));
+        }
+    }
+    if (gpaBounded && sortedIndexes.isBuilt(SORT_BY_GPA)) {
+        AccessPath* path = addPath(ACCESS_GPA_RANGE, fieldFraction(FIELD_GPA, isBound), orderKey == SORT_BY_GPA,
+                                   INDEX_ROW_COST, "绩点有序索引区间");
+        path->minGpa = gpaLow;
+        path->maxGpa = gpaHigh;
+    }
+    if (namePrefix && sortedIndexes.isBuilt(SORT_BY_NAME)) {
+        AccessPath* path = addPath(ACCESS_NAME_PREFIX, fieldFraction(FIELD_NAME, [](QueryOp op) {
+            return op == OP_PREFIX || op == OP_EQ;
+        }), orderKey == SORT_BY_NAME, INDEX_ROW_COST, "姓名有序索引前缀 “" + namePrefix->text + "”");
+        path->text = namePrefix->text;
+    }
+    if (nameContains && nameIndex.isBuilt()) {
+        // 取出全部候选行号后才开始求值，不能提前停止
+        AccessPath* path = addPath(ACCESS_NAME_SEARCH, fieldFraction(FIELD_NAME, [](QueryOp op) {
+            return op == OP_CONTAINS;
+        }), false, INDEX_ROW_COST, "姓名 n-gram 索引 “" + nameContains->text + "”");
+        path->text = nameContains->text;
+    }
+    if (orderKey != SORT_NONE && sortedIndexes.isBuilt(orderKey)) {
+        AccessPath* path = addPath(ACCESS_INDEX_ORDER, 1.0, true, INDEX_ROW_COST,
+                                   std::string("按") + StudentQuery::fieldName(orderField) + "有序索引顺序遍历");
+        path->key = orderKey;
+    }
+    const AccessPath* chosen = &paths[0];
+    for (size_t i = 1; i < paths.size(); ++i) {
+        if (paths[i].cost < chosen->cost) chosen = &paths[i];
+    }
+    const AccessPath& path = *chosen;
+    
+    // 4. 执行：候选行逐个求值全部条件（最可能不满足的先求值）；
+    //    候选行有序时直接收集，否则有 limit 时维护大小为 need 的堆，没有 limit 时最后整体排序
+    bool useHeap = !path.ordered && need != 0;
+    bool wantStats = spec.wantsStatistics();
+    std::vector<size_t> kept;
+    size_t highestRow = 0, lowestRow = 0;
+    bool stopped = false;
+    const std::vector<double>& gpas = students.gpaColumn();
+    auto accept = [&](size_t row) {
+        ++result.matched;
+        if (wantStats) {
+            ++result.stats.count;
+        }
+        if (wantStats && !std::isnan(gpas[row])) {
+            GpaStatistics& stats = result.stats;
+            if (stats.graded == 0 || gpas[row] > gpas[highestRow] || (gpas[row] == gpas[highestRow] && row < highestRow)) {
+                highestRow = row;
+            }
+            if (stats.graded == 0 || gpas[row] < gpas[lowestRow] || (gpas[row] == gpas[lowestRow] && row < lowestRow)) {
+                lowestRow = row;
+            }
+            ++stats.graded;
+            stats.sum += gpas[row];
+        }
+        if (useHeap) {
+            if (kept.size() < need) {
+                kept.push_back(row);
+                std::push_heap(kept.begin(), kept.end(), order);
+            } else if (order(row, kept.front())) {
+                std::pop_heap(kept.begin(), kept.end(), order);
+                kept.back() = row;
+                std::push_heap(kept.begin(), kept.end(), order);
+            }
+        } else if (need == 0 || kept.size() < need) {
+            kept.push_back(row);
+            if (canStop && path.ordered && kept.size() == need) {
+                stopped = true;
+                return false;
+            }
+        }
+        return true;
+    };
+    auto visit = [&](size_t row) {
+        if (!alive[row]) return true;
+        for (size_t c = 0; c < conditions.size(); ++c) {
+            if (!evaluate(conditions[c], row)) return true;
+        }
+        return accept(row);
+    };
+    
+    switch (path.kind) {
+        case ACCESS_ID_LOOKUP: {
+            int index = path.minId <= path.maxId ? findStudentIndex(path.minId) : -1;
+            if (index != -1) visit(static_cast<size_t>(index));
+            break;
+        }
+        case ACCESS_ID_RANGE:
+            sortedIndexes.visitIdRange(path.minId, path.maxId, visit);
+            break;
+        case ACCESS_GPA_RANGE:
+            sortedIndexes.visitGpaRange(path.minGpa, path.maxGpa, visit);
+            break;
+        case ACCESS_NAME_PREFIX:
+            sortedIndexes.visitNamePrefix(path.text, visit);
+            break;
+        case ACCESS_NAME_SEARCH: {
+            std::vector<size_t> rows;
+            nameIndex.search(path.text, 0, rows);
+            for (size_t i = 0; i < rows.size() && visit(rows[i]); ++i) {}
+            break;
+        }
+        case ACCESS_INDEX_ORDER:
+            sortedIndexes.visitInOrder(path.key, visit);
+            break;
+        default: {
+            // 全表扫描按块进行：每块先列出存活行，再逐个条件在整块上筛选（每次只读一列），最后处理剩下的行
+            const size_t BLOCK_ROWS = 1024;
+            std::vector<size_t> block(BLOCK_ROWS);
+            const size_t rowCount = students.size();
+            for (size_t base = 0; base < rowCount && !stopped; base += BLOCK_ROWS) {
+                size_t limit = std::min(rowCount, base + BLOCK_ROWS);
+                size_t count = 0;
+                for (size_t row = base; row < limit; ++row) {
+                    block[count] = row;
+                    count += alive[row] ? 1 : 0;
+                }
+                for (size_t c = 0; c < conditions.size() && count > 0; ++c) {
+                    count = filterRows(conditions[c], &block[0], count);
+                }
+                for (size_t i = 0; i < count && accept(block[i]); ++i) {}
             }
+            break;
         }
     }
+    if (useHeap) {
+        std::sort_heap(kept.begin(), kept.end(), order);
+    } else if (!path.ordered) {
+        std::sort(kept.begin(), kept.end(), order);
+    }
+    result.complete = !stopped;
+    if (wantStats && result.stats.graded > 0) {
+        result.stats.highest = students.at(highestRow);
+        result.stats.lowest = students.at(lowestRow);
+    }
     
-    file.close();
-    return true;
+    // 5. 取出请求的一页，写出执行计划
+    size_t begin = std::min(spec.getOffset(), kept.size());
+    size_t end = spec.getLimit() == 0 ? kept.size() : std::min(kept.size(), begin + spec.getLimit());
+    result.rows.reserve(end - begin);
+    for (size_t i = begin; i < end; ++i) {
+        result.rows.push_back(students.at(kept[i]));
+    }
+    
+    std::ostringstream plan;
+    plan << "访问路径：" << path.description << "（估计检查 " << static_cast<size_t>(path.rows + 0.5) << " 行）；条件顺序：";
+    if (conditions.empty()) {
+        plan << "无";
+    }
+    for (size_t c = 0; c < conditions.size(); ++c) {
+        plan << (c ? " → " : "") << StudentQuery::describe(conditions[c].condition)
+             << "（约 " << percent(conditions[c].selectivity) << "）";
+    }
+    plan << "；排序：";
+    if (byRow) {
+        plan << "按存储顺序";
+    } else {
+        plan << "按" << StudentQuery::fieldName(orderField) << (descending ? "降序" : "升序");
+    }
+    if (path.ordered) {
+        plan << (canStop ? "，候选行已有序，取满 " + std::to_string(need) + " 条即停止" : "，候选行已有序");
+    } else if (useHeap) {
+        plan << "，堆取前 " << need << " 条";
+    } else {
+        plan << "，全部排序";
+    }
+    result.plan = plan.str();
+    return result;
 }
 
-// 按姓名搜索
-std::vector<Student> StudentManager::searchByName(const std::string& name) const {
-    std::vector<Student> result;
-    for (const auto& student : students) {
-        if (student.getName().find(name) != std::string::npos) {
-            result.push_back(student);
-        }
+// 执行组合查询并以表格显示结果、匹配数、统计信息与执行计划
+void StudentManager::displayQuery(const StudentQuery& spec, std::ostream& out) const {
+    QueryResult result = query(spec);
+    StudentFormatter table(out);
+    table.line("\n========== 查询结果 ==========");
+    for (size_t i = 0; i < result.rows.size(); ++i) {
+        table.row(result.rows[i]);
     }
-    return result;
+    
+    std::ostringstream summary;
+    if (result.rows.empty()) {
+        summary << "未找到符合条件的学生！";
+    } else {
+        summary << "显示第 " << spec.getOffset() + 1 << "~" << spec.getOffset() + result.rows.size() << " 条";
+    }
+    if (result.complete) {
+        summary << "（共 " << result.matched << " 名学生符合条件）";
+    } else {
+        summary << "（已取满一页，提前结束扫描）";
+    }
+    table.line(summary.str());
+    if (spec.wantsStatistics()) {
+        std::ostringstream stats;
+        formatStatistics(result.stats, stats);
+        std::string text = stats.str();
+        table.line(text.substr(0, text.size() - 1));
+    }
+    table.line("执行计划：" + result.plan);
 }
 
-// 按专业搜索
-std::vector<Student> StudentManager::searchByMajor(const std::string& major) const {
-    std::vector<Student> result;
-    for (const auto& student : students) {
-        if (student.getMajor() == major) {
-            result.push_back(student);
-        }
+// 显示所有学生
+void StudentManager::displayAllStudents(std::ostream& out) const {
+    OperationTimer timer(metrics, METRIC_LIST);
+    StudentFormatter table(out);
+    if (getTotalStudents() == 0) {
+        table.line("暂无学生信息！");
+        return;
     }
-    return result;
+    
+    table.line("\n========== 所有学生信息 ==========");
+    table.line(std::string(80, '-'));
+    forEachRow([&](size_t row) {
+        table.row(students.at(row));
+    });
+    table.line(std::string(80, '-'));
+    table.line("总计：" + std::to_string(getTotalStudents()) + " 名学生");
 }
 
-// 清空所有学生数据
-void StudentManager::clearAllStudents() {
-    students.clear();
-    std::cout << "所有学生数据已清空！" << std::endl;
-}
\ No newline at end of file
+// 按专业显示学生
+void StudentManager::displayStudentsByMajor(const std::string& major, std::ostream& out) const {
+    StudentFormatter table(out);
+    table.line("\n========== 专业：" + major + " ==========");
+    size_t count = scanByMajor(major, [&table](const StudentRef& student) {
+        table.row(student);
+        return true;
+    });
+    if (count == 0) {
+        table.line("未找到该专业的学生！");
+    }
+}
+
+// 按绩点显示学生
+void StudentManager::displayStudentsByGpa(double minGpa, std::ostream& out) const {
+    StudentFormatter table(out);
+    std::ostringstream title;
+    title << "\n========== 绩点 >= " << minGpa << " 的学生 ==========";
+    table.line(title.str());
+    size_t count = scanByMinGpa(minGpa, [&table](const StudentRef& student) {
+        table.row(student);
+        return true;
+    });
+    if (count == 0) {
+        table.line("未找到符合条件的学生！");
+    }
+}
+
+// 获取学生总数
+int StudentManager::getTotalStudents() const {
+    return static_cast<int>(students.size() - deadCount);
+}
+
+// 扫描绩点列（已删除的行绩点为 NaN，不会满足条件）；bitmap 不为空时同时得到筛选位图
+GpaSummary StudentManager::scanGpa(double minGpa, std::vector<uint64_t>* bitmap) const {
+    const std::vector<double>& gpas = students.gpaColumn();
+    GpaSummary summary;
+    if (bitmap != nullptr) {
+        bitmap->assign((gpas.size() + 63) / 64, 0);
+    }
+    if (!gpas.empty()) {
+        GpaKernels::scan(&gpas[0], gpas.size(), minGpa,
+                         bitmap != nullptr ? &(*bitmap)[0] : nullptr, summary);
+    }
+    return summary;
+}
+
+// 获取平均绩点
+double StudentManager::getAverageGpa() const {
+    checkStatistics();
+    return statistics.total().averageGpa();
+}
+
+// 显示统计信息：人数与绩点总和取自增量统计，最值取自最值树，都不扫描全表
+void StudentManager::getStatistics(std::ostream& out) const {
+    formatStatistics(getGpaStatistics(), out);
+}
+
+// 按 getStatistics 的格式输出一组统计结果（先拼好再一次写出，不改变 out 的格式状态）
+void StudentManager::formatStatistics(const GpaStatistics& stats, std::ostream& out) {
+    double average = stats.graded == 0 ? 0.0 : stats.sum / stats.graded;
+    
+    std::ostringstream text;
+    text << "\n========== 统计信息 ==========\n";
+    text << "学生总数：" << stats.count << "\n";
+    text << "平均绩点：" << std::fixed << std::setprecision(2) << average << "\n";
+    
+    if (stats.graded > 0) {
+        text << "最高绩点：" << stats.highest.getGpa() << " (" << stats.highest.getName() << ")\n";
+        text << "最低绩点：" << stats.lowest.getGpa() << " (" << stats.lowest.getName() << ")\n";
+    }
+    out << text.str();
+}
+
+// 绩点统计：人数与总和取自增量统计，最值取自最值树
+GpaStatistics StudentManager::getGpaStatistics() const {
+    OperationTimer timer(metrics, METRIC_STATISTICS);
+    checkStatistics();
+    GroupStatistics total = statistics.total();
+    GpaStatistics stats;
+    stats.count = total.count;
+    stats.graded = total.graded;
+    stats.sum = total.gpaSum;
+    if (stats.graded == 0) {
+        return stats;
+    }
+    // 最值树在加载或重排后第一次读取时建立，之后随修改维护，删除最值所在的行不需要重新扫描
+    size_t highest, lowest;
+    if (!statistics.extremes(highest, lowest)) {
+        std::lock_guard<std::mutex> guard(lazyIndexMutex);
+        if (!statistics.extremes(highest, lowest)) {
+            OperationTimer build(metrics, METRIC_INDEX_BUILD);
+            statistics.buildExtremes();
+            statistics.extremes(highest, lowest);
+        }
+    }
+    stats.highest = students.at(highest);
+    stats.lowest = students.at(lowest);
+    return stats;
+}
+
+// 各专业的人数与绩点
+std::map<std::string, GroupStatistics> StudentManager::getStatisticsByMajor() const {
+    OperationTimer timer(metrics, METRIC_STATISTICS);
+    checkStatistics();
+    return statistics.majors();
+}
+
+// 各年龄的人数与绩点
+std::map<int, GroupStatistics> StudentManager::getStatisticsByAge() const {
+    OperationTimer timer(metrics, METRIC_STATISTICS);
+    checkStatistics();
+    return statistics.ages();
+}
+
+// 第 percent 百分位的绩点
+double StudentManager::getGpaPercentile(double percent) const {
+    OperationTimer timer(metrics, METRIC_STATISTICS);
+    checkStatistics();
+    return statistics.gpaDistribution().percentile(percent);
+}
+
+// 学生的百分位排名：绩点低于他的人数加上与他相同的人数的一半，占有效绩点人数的比例
+double StudentManager::getGpaPercentileRank(int id) const {
+    OperationTimer timer(metrics, METRIC_STATISTICS);
+    checkStatistics();
+    int index = findStudentIndex(id);
+    if (index == -1) {
+        return -1.0;
+    }
+    double gpa = students.gpaColumn()[index];
+    const GpaDistribution& distribution = statistics.gpaDistribution();
+    if (std::isnan(gpa) || distribution.size() == 0) {
+        return -1.0;
+    }
+    size_t lower = distribution.countBelow(gpa);
+    size_t equal = distribution.countAtMost(gpa) - lower;
+    return (lower + equal / 2.0) * 100.0 / distribution.size();
+}
+
+// 按绩点区间分组的人数
+std::vector<GpaBin> StudentManager::getGpaHistogram(double low, double high, double width) const {
+    OperationTimer timer(metrics, METRIC_STATISTICS);
+    checkStatistics();
+    return statistics.gpaDistribution().histogram(low, high, width);
+}
+
+// 显示绩点分位数与 [0, 4] 按 0.5 分组的直方图
+void StudentManager::displayGpaDistribution(std::ostream& out) const {
+    checkStatistics();
+    static const double PERCENTS[] = { 10, 25, 50, 75, 90 };
+    const int BAR_WIDTH = 40;
+    const GpaDistribution& distribution = statistics.gpaDistribution();
+
+    std::ostringstream text;
+    text << "\n========== 绩点分布 ==========\n";
+    if (distribution.size() == 0) {
+        text << "暂无绩点数据！\n";
+        out << text.str();
+        return;
+    }
+    text << std::fixed << std::setprecision(2) << "分位数：";
+    for (size_t i = 0; i < sizeof(PERCENTS) / sizeof(PERCENTS[0]); ++i) {
+        text << " P" << static_cast<int>(PERCENTS[i]) << " " << distribution.percentile(PERCENTS[i]);
+    }
+    text << "\n";
+
+    std::vector<GpaBin> bins = distribution.histogram(0.0, 4.0, 0.5);
+    size_t largest = 0, shown = 0;
+    for (size_t i = 0; i < bins.size(); ++i) {
+        largest = std::max(largest, bins[i].count);
+        shown += bins[i].count;
+    }
+    for (size_t i = 0; i < bins.size(); ++i) {
+        bool last = i + 1 == bins.size();
+        text << "[" << bins[i].lower << ", " << bins[i].upper << (last ? "] " : ") ")
+             << std::setw(8) << bins[i].count << " "
+             << std::string(largest == 0 ? 0 : bins[i].count * BAR_WIDTH / largest, '#') << "\n";
+    }
+    if (shown < distribution.size()) {
+        text << "超出 [0, 4] 的绩点：" << distribution.size() - shown << " 人\n";
+    }
+    out << text.str();
+}
+
+// 把增量统计与全表扫描的结果逐项核对（人数精确相等，绩点总和允许累加顺序带来的舍入误差，
+// 最值所在行必须与扫描内核的结果相同）
+bool StudentManager::verifyStatistics(std::string& error) const {
+    RunningStatistics expected(students);
+    expected.rebuild(liveRows());
+    GpaSummary summary = scanGpa(-std::numeric_limits<double>::infinity(), nullptr);
+    
+    auto sameGroup = [](const GroupStatistics& a, const GroupStatistics& b) {
+        double tolerance = 1e-9 * std::max(1.0, std::fabs(b.gpaSum));
+        return a.count == b.count && a.graded == b.graded && std::fabs(a.gpaSum - b.gpaSum) <= tolerance;
+    };
+    auto describe = [](const GroupStatistics& stats) {
+        std::ostringstream text;
+        text << std::setprecision(17) << stats.count << " 人 / " << stats.graded << " 个有效绩点 / 总和 " << stats.gpaSum;
+        return text.str();
+    };
+    
+    GroupStatistics total = statistics.total();
+    if (!sameGroup(total, expected.total()) || total.graded != summary.count) {
+        error = "总体统计不一致：增量 " + describe(total) + "，扫描 " + describe(expected.total());
+        return false;
+    }
+    if (static_cast<size_t>(getTotalStudents()) != total.count) {
+        error = "学生总数不一致";
+        return false;
+    }
+    std::map<std::string, GroupStatistics> majors = statistics.majors(), expectedMajors = expected.majors();
+    if (majors.size() != expectedMajors.size()) {
+        error = "专业分组数不一致";
+        return false;
+    }
+    for (std::map<std::string, GroupStatistics>::const_iterator it = expectedMajors.begin(); it != expectedMajors.end(); ++it) {
+        if (!majors.count(it->first) || !sameGroup(majors[it->first], it->second)) {
+            error = "专业 " + it->first + " 的统计不一致：扫描 " + describe(it->second);
+            return false;
+        }
+    }
+    std::map<int, GroupStatistics> ages = statistics.ages(), expectedAges = expected.ages();
+    if (ages.size() != expectedAges.size()) {
+        error = "年龄分组数不一致";
+        return false;
+    }
+    for (std::map<int, GroupStatistics>::const_iterator it = expectedAges.begin(); it != expectedAges.end(); ++it) {
+        if (!ages.count(it->first) || !sameGroup(ages[it->first], it->second)) {
+            error = "年龄 " + std::to_string(it->first) + " 的统计不一致：扫描 " + describe(it->second);
+            return false;
+        }
+    }
+    size_t highest, lowest;
+    if (statistics.extremes(highest, lowest) && (highest != summary.maxRow || lowest != summary.minRow)) {
+        error = "最值树的最高或最低绩点所在行与全表扫描不一致";
+        return false;
+    }
+    
+    // 绩点分布与排好序的绩点逐个比较排名与取值
+    std::vector<double> sorted;
+    std::vector<size_t> rows = liveRows();
+    for (size_t i = 0; i < rows.size(); ++i) {
+        double gpa = students.gpaColumn()[rows[i]];
+        if (!std::isnan(gpa)) sorted.push_back(gpa);
+    }
+    std::sort(sorted.begin(), sorted.end());
+    const GpaDistribution& distribution = statistics.gpaDistribution();
+    if (distribution.size() != sorted.size()) {
+        error = "绩点分布的人数与全表不一致";
+        return false;
+    }
+    size_t step = std::max<size_t>(1, sorted.size() / 64);
+    for (size_t k = 0; k < sorted.size(); k += step) {
+        size_t lower = std::lower_bound(sorted.begin(), sorted.end(), sorted[k]) - sorted.begin();
+        size_t upper = std::upper_bound(sorted.begin(), sorted.end(), sorted[k]) - sorted.begin();
+        if (distribution.select(k) != sorted[k] || distribution.countBelow(sorted[k]) != lower ||
+            distribution.countAtMost(sorted[k]) != upper) {
+            error = "绩点分布的第 " + std::to_string(k) + " 名与排序结果不一致";
+            return false;
+        }
+    }
+    return true;
+}
+
+// 启用 ManagerOptions::verifyStatistics 时，每次读取统计前核对一次
+void StudentManager::checkStatistics() const {
+    std::string error;
+    if (options.verifyStatistics && !verifyStatistics(error)) {
+        throw std::logic_error("增量统计与全表扫描不一致：" + error);
+    }
+}
+
+// 按学号排序
+void StudentManager::sortById() {
+    setSortOrder(SORT_BY_ID);
+    report("已按学号排序！");
+}
+
+// 按姓名排序
+void StudentManager::sortByName() {
+    setSortOrder(SORT_BY_NAME);
+    report("已按姓名排序！");
+}
+
+// 按绩点排序
+void StudentManager::sortByGpa() {
+    setSortOrder(SORT_BY_GPA);
+    report("已按绩点排序（从高到低）！");
+}
+
+// 保存到文件：启用日志时写一次检查点，否则整体重写
+bool StudentManager::saveToFile() const {
+    OperationTimer timer(metrics, METRIC_SAVE);
+    if (inTransaction) {
+        report("错误：事务进行中，请用 commitTransaction 保存！");
+        return false;
+    }
+    bool saved;
+    if (wal) {
+        saved = checkpoint(false);
+    } else {
+        waitForCheckpoint();           // 不能与后台保存同时写数据文件
+        lastSaveStarted = std::chrono::steady_clock::now();
+        savingChangeCount = changeCount;
+        saved = exportTo(filename, options.format);
+        if (saved) {
+            savedChangeCount = changeCount;
+        }
+    }
+    if (saved && Metrics::enabled()) {
+        metrics.addBytesWritten(fileSize(filename));
+    }
+    return saved;
+}
+
+// 开始事务：之后的修改只在内存中进行，不写日志，直到提交或回滚
+bool StudentManager::beginTransaction() {
+    if (filename.empty() || inTransaction) {
+        report(inTransaction ? "错误：已有进行中的事务！" : "错误：没有数据文件，不能使用事务！");
+        return false;
+    }
+    waitForCheckpoint();               // 提交时要写数据文件，不能与后台保存同时进行
+    if (wal && !checkLogged(wal->sync())) {
+        // 事务之前的修改先写盘，回滚时从数据文件和日志恢复；写不进去时回滚会丢掉它们
+        return false;
+    }
+    suspendedWal = std::move(wal);
+    sortOrderBeforeTransaction = sortOrder;
+    inTransaction = true;
+    return true;
+}
+
+// 提交事务：整体写一次数据文件（先写临时文件再改名），启用日志时同时截断日志
+bool StudentManager::commitTransaction() {
+    if (!inTransaction) {
+        report("错误：没有进行中的事务！");
+        return false;
+    }
+    inTransaction = false;
+    wal = std::move(suspendedWal);
+    if (wal) {
+        return saveToFile();
+    }
+    OperationTimer timer(metrics, METRIC_SAVE);
+    std::string error = replaceDataFile(filename, options.format, students, orderedRows());
+    if (!error.empty()) {
+        report("错误：" + error + "！");
+        return false;
+    }
+    savingChangeCount = savedChangeCount = changeCount;
+    lastSaveStarted = std::chrono::steady_clock::now();
+    metrics.addBytesWritten(fileSize(filename));
+    return true;
+}
+
+// 回滚事务：丢弃内存中的全部修改，重新加载数据文件（启用日志时再重放日志）
+bool StudentManager::rollbackTransaction() {
+    if (!inTransaction) {
+        report("错误：没有进行中的事务！");
+        return false;
+    }
+    return rollbackTransaction(true);
+}
+
+bool StudentManager::rollbackTransaction(bool reload) {
+    inTransaction = false;
+    wal = std::move(suspendedWal);
+    if (!reload) {
+        return true;
+    }
+    sortOrder = sortOrderBeforeTransaction;
+    resetStorage();
+    return loadFromFile();
+}
+
+// 是否有进行中的事务
+bool StudentManager::isInTransaction() const {
+    return inTransaction;
+}
+
+// 立即把日志中尚未写盘的修改写盘
+bool StudentManager::syncLog() {
+    return !wal || wal->sync();
+}
+
+// 启用日志且最近一次写盘失败
+bool StudentManager::hasLogFailure() const {
+    return wal && wal->hasFailed();
+}
+
+// 另存为指定文件，FORMAT_AUTO 时按扩展名选择格式
+bool StudentManager::exportTo(const std::string& path, StorageFormat format) const {
+    std::string error;
+    if (!writeStudents(path, format, students, orderedRows(), error)) {
+        report("错误：" + error + "！");
+        return false;
+    }
+    return true;
+}
+
+// 在文本与快照格式间转换，目标格式由扩展名决定
+bool StudentManager::convertFile(const std::string& source, const std::string& target) {
+    StudentManager manager("");
+    if (!manager.loadFrom(source, FORMAT_AUTO)) {
+        return false;
+    }
+    return manager.exportTo(target, FORMAT_AUTO);
+}
+
+// 单线程加载时逐行接收解析结果
+class StudentManager::LoadSink : public StudentRowSink {
+private:
+    StudentManager& manager;
+
+public:
+    explicit LoadSink(StudentManager& manager) : manager(manager) {}
+
+    void onRow(size_t lineNumber, Student& student, const char* begin, const char* end) {
+        manager.appendLoaded(lineNumber, student, begin, end);
+    }
+
+    void onSkip(size_t lineNumber, SkippedLine::Reason reason, const char* begin, const char* end) {
+        SkippedLine skipped = { lineNumber, reason, std::string(begin, end) };
+        manager.lastLoadReport.skipped.push_back(skipped);
+    }
+};
+
+namespace {
+    // 多线程加载时每个数据块的解析结果，行号均为块内行号（从 0 开始）
+    struct LoadChunk {
+        const char* begin;
+        const char* end;
+        size_t lines;                          // 块内行数
+        std::vector<Student> rows;             // 解析成功的记录
+        std::vector<size_t> rowLines;          // 每条记录的块内行号
+        std::vector<const char*> rowStarts;    // 每条记录在文件中的起始位置
+        std::vector<SkippedLine> skipped;      // 块内的无效行
+    };
+
+    class ChunkSink : public StudentRowSink {
+    private:
+        LoadChunk& chunk;
+
+    public:
+        explicit ChunkSink(LoadChunk& chunk) : chunk(chunk) {}
+
+        void onRow(size_t lineNumber, Student& student, const char* begin, const char*) {
+            chunk.rows.push_back(std::move(student));
+            chunk.rowLines.push_back(lineNumber);
+            chunk.rowStarts.push_back(begin);
+        }
+
+        void onSkip(size_t lineNumber, SkippedLine::Reason reason, const char* begin, const char* end) {
+            SkippedLine skipped = { lineNumber, reason, std::string(begin, end) };
+            chunk.skipped.push_back(skipped);
+        }
+    };
+
+    void parseChunk(LoadChunk* chunk) {
+        size_t lines = CsvLoader::countLines(chunk->begin, chunk->end);
+        chunk->rows.reserve(lines);
+        chunk->rowLines.reserve(lines);
+        chunk->rowStarts.reserve(lines);
+        ChunkSink sink(*chunk);
+        chunk->lines = CsvLoader::parse(chunk->begin, chunk->end, 0, sink);
+    }
+
+    // 按块读完整个流（逐字符的 istreambuf_iterator 太慢）
+    std::string readAll(std::istream& in) {
+        std::string text;
+        char block[1 << 16];
+        while (in.read(block, sizeof(block)) || in.gcount() > 0) {
+            text.append(block, static_cast<size_t>(in.gcount()));
+        }
+        return text;
+    }
+
+    bool byLineNumber(const SkippedLine& a, const SkippedLine& b) {
+        return a.lineNumber < b.lineNumber;
+    }
+
+    // 小于该大小的文件不值得多线程加载
+    const size_t PARALLEL_LOAD_MIN_BYTES = 1 << 20;
+}
+
+// 加载时追加一条记录：学号与之前的行重复时记入报告并返回 false。
+// line 为该行起始位置，limit 为搜索行尾的上限
+bool StudentManager::appendLoaded(size_t lineNumber, Student& student,
+                                  const char* line, const char* limit) {
+    if (!idIndex.insert(student.getId(), static_cast<int>(students.size()))) {
+        SkippedLine skipped = { lineNumber, SkippedLine::DUPLICATE_ID, "" };
+        const void* newline = std::memchr(line, '\n', static_cast<size_t>(limit - line));
+        skipped.text.assign(line, newline ? static_cast<const char*>(newline) : limit);
+        lastLoadReport.skipped.push_back(skipped);
+        return false;
+    }
+    students.append(student);
+    alive.push_back(1);
+    statistics.add(students.size() - 1);
+    ++lastLoadReport.loadedRows;
+    return true;
+}
+
+// 快照已整批追加到表中，一次遍历建立学号索引和统计。
+// 重复的学号保留先出现的一行，之后的行直接记为已删除，与逐条 appendLoaded 的结果一致
+void StudentManager::indexSnapshotRows() {
+    const std::vector<int>& ids = students.idColumn();
+    alive.assign(ids.size(), 1);
+    idIndex.reserve(ids.size());
+    for (size_t row = 0; row < ids.size(); ++row) {
+        if (!idIndex.insert(ids[row], static_cast<int>(row))) {
+            // 快照格式没有原始文本，只记录学号
+            std::ostringstream text;
+            text << ids[row];
+            SkippedLine skipped = { row + 1, SkippedLine::DUPLICATE_ID, text.str() };
+            lastLoadReport.skipped.push_back(skipped);
+            students.release(row);
+            alive[row] = 0;
+            ++deadCount;
+            continue;
+        }
+        statistics.add(row);
+    }
+    lastLoadReport.loadedRows = ids.size() - deadCount;
+}
+
+// 多线程分块加载：按换行符切分数据块并行解析，再按文件顺序合并。
+// 合并阶段串行查重，因此重复学号的处理与逐行 addStudent 完全一致（先出现的保留）
+void StudentManager::loadChunksInParallel(const char* begin, const char* end, size_t threads) {
+    std::vector<LoadChunk> chunks(threads);
+    size_t chunkSize = static_cast<size_t>(end - begin) / threads;
+    const char* p = begin;
+    for (size_t i = 0; i < threads; ++i) {
+        const char* chunkEnd = end;
+        if (i + 1 < threads && p + chunkSize < end) {
+            const void* newline = std::memchr(p + chunkSize, '\n', static_cast<size_t>(end - p - chunkSize));
+            chunkEnd = newline ? static_cast<const char*>(newline) + 1 : end;
+        }
+        chunks[i].begin = p;
+        chunks[i].end = chunkEnd;
+        chunks[i].lines = 0;
+        p = chunkEnd;
+    }
+    
+    {
+        ThreadPool pool(threads);
+        std::vector<std::future<void> > done;
+        for (size_t i = 0; i < threads; ++i) {
+            done.push_back(pool.submit(std::bind(parseChunk, &chunks[i])));
+        }
+        for (size_t i = 0; i < done.size(); ++i) {
+            done[i].get();
+        }
+    }
+    
+    size_t total = 0;
+    for (size_t i = 0; i < chunks.size(); ++i) {
+        total += chunks[i].rows.size();
+    }
+    students.reserve(total);
+    alive.reserve(total);
+    idIndex.reserve(total);
+    
+    size_t firstLine = 1;
+    for (size_t i = 0; i < chunks.size(); ++i) {
+        LoadChunk& chunk = chunks[i];
+        for (size_t r = 0; r < chunk.rows.size(); ++r) {
+            appendLoaded(firstLine + chunk.rowLines[r], chunk.rows[r], chunk.rowStarts[r], chunk.end);
+        }
+        for (size_t s = 0; s < chunk.skipped.size(); ++s) {
+            chunk.skipped[s].lineNumber += firstLine;
+            lastLoadReport.skipped.push_back(chunk.skipped[s]);
+        }
+        firstLine += chunk.lines;
+        std::vector<Student>().swap(chunk.rows);
+    }
+    std::sort(lastLoadReport.skipped.begin(), lastLoadReport.skipped.end(), byLineNumber);
+}
+
+// 从文件加载：先读数据文件，再按顺序重放日志段和当前日志
+bool StudentManager::loadFromFile() {
+    OperationTimer timer(metrics, METRIC_LOAD);
+    if (wal) {
+        waitForCheckpoint();
+        if (!checkLogged(wal->sync())) {
+            return false;              // 未写盘的修改不在文件中，重新加载会丢掉它们
+        }
+    }
+    if (!loadFrom(filename, options.format)) {
+        return false;
+    }
+    if (options.writeAheadLog) {
+        replayLogs();
+    }
+    return true;
+}
+
+// 重放日志时直接修改内存数据，不再写日志
+class StudentManager::LogReplay : public WalApplier {
+private:
+    StudentManager& manager;
+
+public:
+    explicit LogReplay(StudentManager& manager) : manager(manager) {}
+
+    void applyPut(const Student& student) {
+        int index = manager.findStudentIndex(student.getId());
+        if (index == -1) {
+            manager.insertRecord(student);
+        } else {
+            manager.replaceRecord(index, student);
+        }
+    }
+
+    void applyUpdate(int oldId, const Student& student) {
+        int index = manager.findStudentIndex(oldId);
+        if (index != -1 && (student.getId() == oldId || manager.isValidId(student.getId()))) {
+            manager.replaceRecord(index, student);
+            return;
+        }
+        if (index != -1) {
+            manager.removeRecord(index);
+        }
+        applyPut(student);
+    }
+
+    void applyDelete(int id) {
+        int index = manager.findStudentIndex(id);
+        if (index != -1) {
+            manager.removeRecord(index);
+        }
+    }
+
+    void applyClear() {
+        manager.resetStorage();
+    }
+
+    void applySortOrder(int key) {
+        if (key >= SORT_NONE && key <= SORT_BY_GPA) {
+            manager.sortOrder = static_cast<SortKey>(key);
+        }
+    }
+};
+
+void StudentManager::replayLogs() {
+    LogReplay replay(*this);
+    size_t sealedRecords = 0, records = 0;
+    WriteAheadLog::replay(filename + ".wal.1", replay, sealedRecords);
+    uint64_t validBytes = WriteAheadLog::replay(filename + ".wal", replay, records);
+    if (sealedRecords + records > 0) {
+        report("已从日志恢复 " + std::to_string(sealedRecords + records) + " 条修改。");
+    }
+    
+    if (!wal) {
+        std::unique_ptr<WriteAheadLog> log(new WriteAheadLog(filename + ".wal", options.walSyncIntervalMs));
+        if (!log->open(validBytes)) {
+            report("错误：无法打开日志文件 " + filename + ".wal，修改将在退出时整体保存！");
+            return;
+        }
+        wal = std::move(log);
+    }
+}
+
+// 写检查点。后台模式下在调用线程复制一份数据（见 StudentTable 的复制构造，姓名不逐个复制）、
+// 记下显示顺序，由后台线程写快照；启用日志时先把当前日志封存为 .wal.1，之后的修改照常追加到新日志。
+// 前台模式直接写快照，启用日志时再清空日志。result 与 done 不为空时以是否写成功通知
+bool StudentManager::checkpoint(bool background, const std::shared_ptr<std::promise<bool> >& result,
+                                const SaveCallback& done) const {
+    waitForCheckpoint();
+    std::string sealed = wal ? filename + ".wal.1" : std::string();
+    lastSaveStarted = std::chrono::steady_clock::now();
+    savingChangeCount = changeCount;
+    
+    // 上次检查点失败留下的日志段还在时不能再封存（会覆盖它），改为前台写
+    if (background && (!wal || (!fileExists(sealed) && wal->rotate(sealed)))) {
+        std::shared_ptr<StudentTable> snapshot(new StudentTable(students));
+        checkpointTask = std::async(std::launch::async, writeCheckpoint, filename, options.format,
+                                    sealed, snapshot, orderedRows(), result, done);
+        return true;
+    }
+    
+    std::string error = replaceDataFile(filename, options.format, students, orderedRows());
+    bool saved = error.empty();
+    if (!saved) {
+        report("错误：" + error + "！");
+    } else if (wal) {
+        std::remove(sealed.c_str());
+        saved = wal->reset();
+    }
+    if (saved) {
+        savedChangeCount = savingChangeCount;
+    }
+    notifySaved(result, done, saved);
+    return saved;
+}
+
+// 等待后台保存完成，失败时报告错误（日志段保留，数据不会丢失；未启用日志时析构会再整体保存）
+void StudentManager::waitForCheckpoint() const {
+    if (!checkpointTask.valid()) {
+        return;
+    }
+    std::string error = checkpointTask.get();
+    if (!error.empty()) {
+        report("错误：后台保存失败：" + error + "！");
+        return;
+    }
+    savedChangeCount = savingChangeCount;
+}
+
+// 日志超过阈值且没有正在进行的检查点时，启动后台检查点
+void StudentManager::maybeCheckpoint() {
+    if (wal->size() < options.walCheckpointBytes) {
+        return;
+    }
+    if (checkpointTask.valid() &&
+        checkpointTask.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+        return;
+    }
+    checkpoint(true);
+}
+
+// 日志写入结果：失败时提示。修改已在内存中生效，记录留在日志缓冲区中，之后写盘成功或退出时整体保存
+bool StudentManager::checkLogged(bool written) const {
+    if (!written) {
+        report("错误：写入日志失败（磁盘已满或 I/O 错误），修改尚未写盘！");
+    }
+    return written;
+}
+
+// 修改之后调用：启用日志时检查日志大小，再按保存策略检查
+void StudentManager::noteChanges(size_t count) {
+    changeCount += count;
+    if (wal) {
+        maybeCheckpoint();
+    }
+    maybeAutoSave();
+}
+
+// 距上次保存的修改次数或时长达到保存策略的要求、且没有正在进行的后台保存时，启动后台保存
+void StudentManager::maybeAutoSave() {
+    if ((options.autoSaveChanges == 0 && options.autoSaveIntervalMs == 0) || filename.empty() || inTransaction) {
+        return;
+    }
+    uint64_t unsaved = changeCount - savingChangeCount;
+    if (unsaved == 0) {
+        return;
+    }
+    bool due = options.autoSaveChanges != 0 && unsaved >= options.autoSaveChanges;
+    if (!due && options.autoSaveIntervalMs != 0) {
+        due = std::chrono::steady_clock::now() - lastSaveStarted >=
+              std::chrono::milliseconds(options.autoSaveIntervalMs);
+    }
+    if (!due || (checkpointTask.valid() &&
+                 checkpointTask.wait_for(std::chrono::seconds(0)) != std::future_status::ready)) {
+        return;
+    }
+    checkpoint(true);
+}
+
+// 后台保存：快照在调用线程中取得，写文件在后台线程中进行
+std::future<bool> StudentManager::saveAsync(const SaveCallback& done) const {
+    std::shared_ptr<std::promise<bool> > result(new std::promise<bool>());
+    std::future<bool> future = result->get_future();
+    if (filename.empty() || inTransaction) {
+        report(inTransaction ? "错误：事务进行中，请用 commitTransaction 保存！" : "错误：没有数据文件！");
+        notifySaved(result, done, false);
+        return future;
+    }
+    checkpoint(true, result, done);
+    return future;
+}
+
+// 从指定文件加载：内存映射整个文件，文本格式原地切分字段解析，快照格式直接读取各列
+bool StudentManager::loadFrom(const std::string& path, StorageFormat format) {
+    MappedFile file;
+    if (!file.open(path)) {
+        // 文件不存在是正常的，创建新文件
+        return true;
+    }
+    
+    resetStorage();
+    lastLoadReport = LoadReport();
+    lastLoadReport.bytesRead = file.size();
+    metrics.addBytesRead(file.size());
+    
+    if (format == FORMAT_AUTO) {
+        format = BinarySnapshot::isSnapshot(file.begin(), file.end()) ? FORMAT_BINARY : FORMAT_TEXT;
+    }
+    
+    size_t threads = options.loadThreads == 0 ? ThreadPool::hardwareThreads() : options.loadThreads;
+    if (format == FORMAT_BINARY) {
+        std::string error;
+        if (!BinarySnapshot::load(file.begin(), file.end(), students, error)) {
+            report("错误：无法加载快照文件 " + path + "：" + error + "！");
+            return false;
+        }
+        indexSnapshotRows();
+    } else if (threads > 1 && file.size() >= PARALLEL_LOAD_MIN_BYTES) {
+        loadChunksInParallel(file.begin(), file.end(), threads);
+    } else {
+        // 先数一遍行数，一次性预留容量
+        size_t lines = CsvLoader::countLines(file.begin(), file.end());
+        students.reserve(lines);
+        alive.reserve(lines);
+        idIndex.reserve(lines);
+        
+        LoadSink sink(*this);
+        CsvLoader::parse(file.begin(), file.end(), 1, sink);
+    }
+    
+    for (size_t i = 0; i < lastLoadReport.skipped.size(); ++i) {
+        const SkippedLine& skipped = lastLoadReport.skipped[i];
+        if (skipped.reason == SkippedLine::BAD_NUMBER) {
+            report("警告：读取文件时跳过无效行：" + skipped.text);
+        } else if (skipped.reason == SkippedLine::DUPLICATE_ID) {
+            report("警告：读取文件时跳过重复学号：" + skipped.text);
+        }
+    }
+    return true;
+}
+
+// 获取最近一次加载的报告
+const LoadReport& StudentManager::getLastLoadReport() const {
+    return lastLoadReport;
+}
+
+// 批量导入前一次性预留容量。导入的行数超过现有记录时，逐条维护有序索引和姓名索引
+// 不如之后整体重建，直接丢弃它们
+void StudentManager::reserveForBatch(size_t rows) {
+    if (rows > students.size()) {
+        sortedIndexes.reset();
+        nameIndex.reset();
+    }
+    students.reserve(students.size() + rows);
+    alive.reserve(alive.size() + rows);
+    idIndex.reserve(idIndex.size() + rows);
+}
+
+// 导入一条记录：学号已存在时返回 false
+bool StudentManager::importRecord(const Student& student) {
+    int row = static_cast<int>(students.size());
+    if (!idIndex.insert(student.getId(), row)) {
+        return false;
+    }
+    students.append(student);
+    alive.push_back(1);
+    sortedIndexes.insert(row);
+    nameIndex.insert(row);
+    statistics.add(row);
+    if (wal) {
+        wal->appendPut(student);
+    }
+    return true;
+}
+
+// 批量添加学生
+LoadReport StudentManager::addStudents(const std::vector<Student>& batch) {
+    OperationTimer timer(metrics, METRIC_IMPORT);
+    LoadReport report;
+    reserveForBatch(batch.size());
+    for (size_t i = 0; i < batch.size(); ++i) {
+        if (importRecord(batch[i])) {
+            ++report.loadedRows;
+        } else {
+            SkippedLine skipped = { i + 1, SkippedLine::DUPLICATE_ID, std::to_string(batch[i].getId()) };
+            report.skipped.push_back(skipped);
+        }
+    }
+    if (wal) {
+        checkLogged(!wal->hasFailed());
+    }
+    noteChanges(report.loadedRows);
+    return report;
+}
+
+// 从流中批量导入（格式与文本数据文件相同），先整体解析再一次性导入
+LoadReport StudentManager::importFrom(std::istream& in) {
+    OperationTimer timer(metrics, METRIC_IMPORT);
+    std::string text = readAll(in);
+    LoadChunk chunk;
+    chunk.begin = text.data();
+    chunk.end = text.data() + text.size();
+    parseChunk(&chunk);
+
+    LoadReport report;
+    report.bytesRead = text.size();
+    report.skipped.swap(chunk.skipped);
+    for (size_t s = 0; s < report.skipped.size(); ++s) {
+        ++report.skipped[s].lineNumber;
+    }
+    
+    reserveForBatch(chunk.rows.size());
+    bool duplicates = false;
+    for (size_t r = 0; r < chunk.rows.size(); ++r) {
+        if (importRecord(chunk.rows[r])) {
+            ++report.loadedRows;
+            continue;
+        }
+        const char* line = chunk.rowStarts[r];
+        const void* newline = std::memchr(line, '\n', static_cast<size_t>(chunk.end - line));
+        SkippedLine skipped = { chunk.rowLines[r] + 1, SkippedLine::DUPLICATE_ID,
+                                std::string(line, newline ? static_cast<const char*>(newline) : chunk.end) };
+        report.skipped.push_back(skipped);
+        duplicates = true;
+    }
+    if (duplicates) {
+        std::stable_sort(report.skipped.begin(), report.skipped.end(), byLineNumber);
+    }
+    if (wal) {
+        checkLogged(!wal->hasFailed());
+    }
+    noteChanges(report.loadedRows);
+    return report;
+}
+
+// 按姓名搜索
+std::vector<StudentRef> StudentManager::searchByName(const std::string& name, size_t limit) const {
+    OperationTimer timer(metrics, METRIC_SEARCH_NAME);
+    std::vector<size_t> rows;
+    if (name.empty()) {
+        // 空关键字匹配所有学生
+        rows = orderedRows();
+        if (limit != 0 && rows.size() > limit) {
+            rows.resize(limit);
+        }
+        return toRefs(rows);
+    }
+    ensureNameIndex().search(name, limit, rows);
+    if (limit == 0) {
+        sortByDisplayOrder(rows);
+    }
+    return toRefs(rows);
+}
+
+// 按姓名搜索，按显示顺序只取 page 指定的一页
+std::vector<StudentRef> StudentManager::searchByName(const std::string& name, const QueryPage& page) const {
+    std::vector<StudentRef> result;
+    scanByName(name, appendTo(result), page);
+    return result;
+}
+
+// 输出一条提示或错误信息（未设置输出目标时忽略）
+void StudentManager::report(const std::string& text) const {
+    if (options.messages) {
+        *options.messages << text << '\n';
+    }
+}
+
+// 设置提示与错误信息的输出目标
+void StudentManager::setMessageStream(std::ostream* out) {
+    options.messages = out;
+}
+
+// 按专业搜索
+std::vector<StudentRef> StudentManager::searchByMajor(const std::string& major, const QueryPage& page) const {
+    return getStudentsByMajor(major, page);
+}
+
+// 清空所有学生数据
+void StudentManager::clearAllStudents() {
+    resetStorage();
+    bool logged = !wal || checkLogged(wal->appendClear());
+    noteChanges(1);
+    if (logged) {
+        report("所有学生数据已清空！");
+    }
+}
+
+// 墓碑过多时自动压缩，使删除的均摊开销保持 O(1)
+void StudentManager::maybeCompact() {
+    if (deadCount >= COMPACT_MIN_DEAD && deadCount * 2 > students.size()) {
+        compact();
+    }
+}
+
+// 压缩：按原有相对顺序移走已删除的槽位，并重建学号索引
+void StudentManager::compact() {
+    if (deadCount == 0) {
+        return;
+    }
+    applyOrder(liveRows());
+}
+
+// 按原有顺序列出存活的行
+std::vector<size_t> StudentManager::liveRows() const {
+    std::vector<size_t> rows;
+    rows.reserve(students.size() - deadCount);
+    for (size_t i = 0; i < students.size(); ++i) {
+        if (alive[i]) rows.push_back(i);
+    }
+    return rows;
+}
+
+// 按 order 重排表（未列出的行被丢弃），并重建学号索引
+void StudentManager::applyOrder(const std::vector<size_t>& order) {
+    students.permute(order);
+    alive.assign(order.size(), 1);
+    deadCount = 0;
+    rebuildIndex();
+    sortedIndexes.reset();             // 行号全部改变，有序索引与姓名索引下次使用时重建
+    nameIndex.reset();
+    statistics.invalidateExtremes();   // 分组汇总与行号无关，只有最值行需要重新求出
+}
+
+// 清空所有数据与索引
+void StudentManager::resetStorage() {
+    students.clear();
+    alive.clear();
+    deadCount = 0;
+    idIndex.clear();
+    sortedIndexes.reset();
+    nameIndex.reset();
+    statistics.clear();
+}
+
+// 取得指定的有序索引，尚未建立时先建立
+// 只读操作可能在多个线程中同时执行（见 ConcurrentStudentManager），按需建立时加锁并再检查一次
+const SortedIndexes& StudentManager::ensureSorted(SortKey key) const {
+    if (!sortedIndexes.isBuilt(key)) {
+        std::lock_guard<std::mutex> guard(lazyIndexMutex);
+        if (!sortedIndexes.isBuilt(key)) {
+            OperationTimer timer(metrics, METRIC_INDEX_BUILD);
+            sortedIndexes.build(key, liveRows());
+        }
+    }
+    return sortedIndexes;
+}
+
+// 取得姓名索引，尚未建立时先建立
+const NameIndex& StudentManager::ensureNameIndex() const {
+    if (!nameIndex.isBuilt()) {
+        std::lock_guard<std::mutex> guard(lazyIndexMutex);
+        if (!nameIndex.isBuilt()) {
+            OperationTimer timer(metrics, METRIC_INDEX_BUILD);
+            nameIndex.build(liveRows());
+        }
+    }
+    return nameIndex;
+}
+
+// 按当前显示顺序列出存活的行
+std::vector<size_t> StudentManager::orderedRows() const {
+    if (sortOrder == SORT_NONE) {
+        return liveRows();
+    }
+    std::vector<size_t> rows;
+    ensureSorted(sortOrder).rowsInOrder(sortOrder, rows);
+    return rows;
+}
+
+// 按当前显示顺序访问每个存活的行
+void StudentManager::forEachRow(const std::function<void(size_t)>& visit) const {
+    scanRows([&visit](size_t row) {
+        visit(row);
+        return true;
+    });
+}
+
+// 按当前显示顺序访问存活的行（在有序索引上直接遍历，不生成行号列表），visit 返回 false 时提前结束
+bool StudentManager::scanRows(const std::function<bool(size_t)>& visit) const {
+    if (sortOrder == SORT_NONE) {
+        for (size_t i = 0; i < students.size(); ++i) {
+            if (alive[i] && !visit(i)) return false;
+        }
+        return true;
+    }
+    return ensureSorted(sortOrder).visitInOrder(sortOrder, visit);
+}
+
+// 设置显示顺序。不移动存储中的数据，只在第一次使用某个顺序时建立索引
+void StudentManager::setSortOrder(SortKey key) {
+    OperationTimer timer(metrics, METRIC_SORT);
+    sortOrder = key;
+    ensureSorted(key);
+    // 数据文件按显示顺序保存：启用日志时记一条顺序记录，重放后恢复显示顺序，之后的检查点按新顺序写出
+    if (wal) {
+        checkLogged(wal->appendSortOrder(key));
+    }
+    noteChanges(1);
+}
+
+// 获取当前显示顺序
+SortKey StudentManager::getSortOrder() const {
+    return sortOrder;
+}
+
+// 按学号区间查询（从小到大），O(log n + k)
+std::vector<StudentRef> StudentManager::getStudentsByIdRange(int minId, int maxId) const {
+    OperationTimer timer(metrics, METRIC_RANGE);
+    std::vector<size_t> rows;
+    ensureSorted(SORT_BY_ID).idRange(minId, maxId, rows);
+    return toRefs(rows);
+}
+
+// 按姓名前缀查询（字典序），O(log n + k)
+std::vector<StudentRef> StudentManager::getStudentsByNamePrefix(const std::string& prefix) const {
+    OperationTimer timer(metrics, METRIC_RANGE);
+    std::vector<size_t> rows;
+    ensureSorted(SORT_BY_NAME).namePrefix(prefix, rows);
+    return toRefs(rows);
+}
+
+// 按绩点区间查询（从高到低），O(log n + k)
+std::vector<StudentRef> StudentManager::getStudentsByGpaRange(double minGpa, double maxGpa) const {
+    OperationTimer timer(metrics, METRIC_RANGE);
+    std::vector<size_t> rows;
+    ensureSorted(SORT_BY_GPA).gpaRange(minGpa, maxGpa, rows);
+    return toRefs(rows);
+}
+
+// 绩点最高的 k 名学生（从高到低），O(log n + k)
+std::vector<StudentRef> StudentManager::getTopStudentsByGpa(size_t k) const {
+    OperationTimer timer(metrics, METRIC_RANGE);
+    std::vector<size_t> rows;
+    ensureSorted(SORT_BY_GPA).topGpa(k, rows);
+    return toRefs(rows);
+}
+
+// 把一组行按当前显示顺序排列
+void StudentManager::sortByDisplayOrder(std::vector<size_t>& rows) const {
+    const std::vector<int>& ids = students.idColumn();
+    const std::vector<StringView>& names = students.nameColumn();
+    const std::vector<double>& gpas = students.gpaColumn();
+    switch (sortOrder) {
+        case SORT_BY_ID:
+            std::sort(rows.begin(), rows.end(), [&ids](size_t a, size_t b) {
+                return ids[a] < ids[b];
+            });
+            break;
+        case SORT_BY_NAME:
+            std::sort(rows.begin(), rows.end(), [&names](size_t a, size_t b) {
+                return names[a] < names[b] || (names[a] == names[b] && a < b);
+            });
+            break;
+        case SORT_BY_GPA:
+            std::sort(rows.begin(), rows.end(), [&gpas](size_t a, size_t b) {
+                return gpas[a] > gpas[b] || (gpas[a] == gpas[b] && a < b);
+            });
+            break;
+        default:
+            std::sort(rows.begin(), rows.end());
+            break;
+    }
+}
+
+std::vector<StudentRef> StudentManager::toRefs(const std::vector<size_t>& rows) const {
+    std::vector<StudentRef> refs;
+    refs.reserve(rows.size());
+    for (size_t i = 0; i < rows.size(); ++i) {
+        refs.push_back(students.at(rows[i]));
+    }
+    return refs;
+}
+
+// 获取等待压缩的已删除槽位数
+size_t StudentManager::getDeletedSlots() const {
+    return deadCount;
+}
+
+// 运行指标
+MetricsSnapshot StudentManager::getMetrics() const {
+    return metrics.snapshot();
+}
+
+// 清零运行指标
+void StudentManager::resetMetrics() {
+    metrics.reset();
+}
+
+// 以 Prometheus 文本格式把运行指标写入文件（先写临时文件再改名，抓取方不会读到半个文件）
+bool StudentManager::exportMetrics(const std::string& path) const {
+    std::string tmp = path + ".tmp";
+    std::ofstream file(tmp);
+    if (!file.is_open()) {
+        report("错误：无法打开文件 " + tmp + " 进行写入！");
+        return false;
+    }
+    getMetrics().writePrometheus(file);
+    file.close();
+    if (!file || std::rename(tmp.c_str(), path.c_str()) != 0) {
+        std::remove(tmp.c_str());
+        report("错误：写入文件 " + path + " 失败！");
+        return false;
+    }
+    return true;
+}
@@ -2,55 +2,281 @@
 #define STUDENTMANAGER_H
 
 #include "Student.h"
+#include "StudentTable.h"
+#include "IdIndex.h"
+#include "CsvLoader.h"
+#include "WriteAheadLog.h"
+#include "GpaKernels.h"
+#include "SortedIndexes.h"
+#include "NameIndex.h"
+#include "StudentQuery.h"
+#include "RunningStatistics.h"
+#include "Metrics.h"
 #include <vector>
 #include <string>
 #include <fstream>
+#include <istream>
+#include <iostream>
+#include <memory>
+#include <future>
+#include <functional>
+#include <mutex>
+#include <map>
+#include <chrono>
+#include <cstdint>
+
+// 数据文件格式
+enum StorageFormat {
+    FORMAT_AUTO,                       // 保存时按扩展名（.bin/.snap 为二进制快照），加载时按文件头识别
+    FORMAT_TEXT,                       // 逗号分隔的文本格式
+    FORMAT_BINARY                      // 二进制快照格式，见 BinarySnapshot.h
+};
+
+// StudentManager 的可选配置
+struct ManagerOptions {
+    unsigned loadThreads;              // 加载数据文件的线程数：1 为单线程，0 为使用全部硬件线程
+    StorageFormat format;              // 数据文件格式
+    bool writeAheadLog;                // 修改写入预写日志（数据文件名 + ".wal"），不再在退出时整体重写
+    unsigned walSyncIntervalMs;        // 日志组提交间隔（毫秒），0 表示每次修改都同步写盘
+    size_t walCheckpointBytes;         // 日志超过该大小时在后台写新快照并截断日志
+    std::ostream* messages;            // 提示与错误信息（“学生添加成功！”等）的输出目标，为空时不输出
+    bool verifyStatistics;             // 每次读取统计时都与全表扫描的结果核对，不一致时抛出 std::logic_error（用于测试）
+    size_t autoSaveChanges;            // 自动保存：距上次保存累计这么多次修改后在后台保存，0 表示不按次数
+    unsigned autoSaveIntervalMs;       // 自动保存：有未保存的修改且距上次保存超过该时长（毫秒）时在后台保存，0 表示不按时间
+
+    ManagerOptions()
+        : loadThreads(1), format(FORMAT_AUTO), writeAheadLog(true), walSyncIntervalMs(10),
+          walCheckpointBytes(16 << 20), messages(&std::cout), verifyStatistics(false),
+          autoSaveChanges(0), autoSaveIntervalMs(0) {}
+};
+
+// 绩点统计结果（见 getGpaStatistics）
+struct GpaStatistics {
+    size_t count;                      // 学生人数（含绩点为 NaN 的学生）
+    size_t graded;                     // 绩点有效（不是 NaN）的人数，平均绩点的分母
+    double sum;                        // 有效绩点之和
+    StudentRef highest;                // 绩点最高的学生（相同时取靠前的），没有有效绩点时为空视图
+    StudentRef lowest;                 // 绩点最低的学生
+
+    GpaStatistics() : count(0), graded(0), sum(0.0) {}
+};
+
+// 组合查询的结果（见 StudentManager::query）
+struct QueryResult {
+    std::vector<StudentRef> rows;      // 排序、分页后的一页，视图在下一次修改前有效
+    size_t matched;                    // 满足条件的学生数；complete 为 false 时只统计到停止扫描为止
+    bool complete;                     // 是否检查了全部候选行（按有序索引取满一页后会提前停止）
+    GpaStatistics stats;               // 全部匹配学生的人数与绩点（查询调用了 withStatistics 时）
+    std::string plan;                  // 执行计划：访问路径、条件求值顺序、排序方式
+
+    QueryResult() : matched(0), complete(true) {}
+};
+
+// 分页参数：跳过前 offset 条匹配结果，最多取 limit 条（limit 为 0 表示不限）
+struct QueryPage {
+    size_t offset;
+    size_t limit;
+
+    QueryPage() : offset(0), limit(0) {}
+    QueryPage(size_t offset, size_t limit) : offset(offset), limit(limit) {}
+};
+
+// 流式查询的回调：返回 false 时停止扫描
+typedef std::function<bool(const StudentRef&)> StudentVisitor;
+
+// 后台保存完成时的回调，参数为是否保存成功（见 StudentManager::saveAsync）
+typedef std::function<void(bool)> SaveCallback;
 
 class StudentManager {
 private:
-    std::vector<Student> students;     // 存储学生信息的容器
-    std::string filename;              // 数据文件名
+    StudentTable students;             // 按列存储的学生信息
+    std::vector<char> alive;           // 每个槽位是否有效（删除时只打墓碑标记）
+    size_t deadCount;                  // 墓碑槽位数
+    std::string filename;              // 数据文件名（为空时不读写文件）
+    ManagerOptions options;            // 配置
+    IdIndex idIndex;                   // 学号 -> 容器下标 的哈希索引
+    LoadReport lastLoadReport;         // 最近一次加载的结果
+    std::unique_ptr<WriteAheadLog> wal; // 预写日志（未启用时为空）
+    mutable std::future<std::string> checkpointTask; // 正在后台进行的保存或检查点（结果为错误信息）
+    mutable SortedIndexes sortedIndexes; // 学号、姓名、绩点有序索引（按需建立）
+    mutable NameIndex nameIndex;       // 姓名子串索引（按需建立）
+    RunningStatistics statistics;      // 随增删改增量维护的人数与绩点汇总
+    mutable std::mutex lazyIndexMutex; // 多个读者同时触发按需建立索引时只让一个去建立
+    mutable Metrics metrics;           // 各操作的调用次数与耗时
+    SortKey sortOrder;                 // 当前显示顺序
+    bool inTransaction;                // beginTransaction 之后、提交或回滚之前
+    SortKey sortOrderBeforeTransaction; // 事务开始时的显示顺序，回滚时恢复（事务期间日志暂停，排序不记日志）
+    std::unique_ptr<WriteAheadLog> suspendedWal; // 事务期间暂停使用的日志
+    uint64_t changeCount;              // 累计修改次数
+    mutable uint64_t savingChangeCount; // 最近一次开始保存时的 changeCount
+    mutable uint64_t savedChangeCount; // 最近一次保存成功时的 changeCount（从未保存过时为 UINT64_MAX）
+    mutable std::chrono::steady_clock::time_point lastSaveStarted; // 最近一次开始保存的时刻
+    
+    class LoadSink;                    // 加载时逐行接收解析结果
+    class LogReplay;                   // 重放预写日志
     
     // 私有辅助方法
     bool isValidId(int id) const;      // 检查学号是否有效
+    void report(const std::string& text) const; // 输出一条提示或错误信息
+    void checkStatistics() const;      // 启用 verifyStatistics 时核对增量统计
     int findStudentIndex(int id) const; // 根据学号查找学生索引
+    void rebuildIndex();               // 重建学号索引
+    void maybeCompact();               // 墓碑过多时自动压缩
+    std::vector<size_t> liveRows() const; // 按顺序列出存活的行
+    GpaSummary scanGpa(double minGpa, std::vector<uint64_t>* bitmap) const; // 单次扫描绩点列
+    void applyOrder(const std::vector<size_t>& order); // 按行号列表重排并重建索引
+    void resetStorage();               // 清空所有数据与索引
+    const SortedIndexes& ensureSorted(SortKey key) const; // 取得有序索引，必要时先建立
+    const NameIndex& ensureNameIndex() const; // 取得姓名索引，必要时先建立
+    std::vector<size_t> orderedRows() const; // 按显示顺序列出存活的行
+    void forEachRow(const std::function<void(size_t)>& visit) const; // 按显示顺序访问存活的行
+    bool scanRows(const std::function<bool(size_t)>& visit) const; // 同上，visit 返回 false 时提前结束
+    size_t scanPage(const std::vector<size_t>& rows, const StudentVisitor& visit, const QueryPage& page) const;
+    void setSortOrder(SortKey key);    // 切换显示顺序
+    void sortByDisplayOrder(std::vector<size_t>& rows) const; // 把一组行按显示顺序排列
+    std::vector<StudentRef> toRefs(const std::vector<size_t>& rows) const;
+    void insertRecord(const Student& student);        // 追加一条记录（不检查重复）
+    void removeRecord(int index);                     // 删除指定槽位的记录
+    void replaceRecord(int index, const Student& student); // 覆盖指定槽位的记录
+    void replayLogs();                 // 重放预写日志并打开日志供后续追加
+    bool checkpoint(bool background, const std::shared_ptr<std::promise<bool> >& result = nullptr,
+                    const SaveCallback& done = SaveCallback()) const; // 写新快照（启用日志时并截断日志）
+    void waitForCheckpoint() const;    // 等待后台保存或检查点完成
+    void maybeCheckpoint();            // 日志过大时启动后台检查点
+    bool checkLogged(bool written) const; // 日志写入失败时提示，返回 written
+    void noteChanges(size_t count);    // 修改之后调用：计数，并按日志大小与保存策略决定是否后台保存
+    void reserveForBatch(size_t rows); // 批量导入前一次性预留容量
+    bool importRecord(const Student& student); // 查重并追加一条记录、写日志（不输出）
+    bool appendLoaded(size_t lineNumber, Student& student,
+                      const char* line, const char* limit); // 加载时查重并追加一条记录
+    void indexSnapshotRows();          // 快照整批追加之后一次遍历建立学号索引和统计，重复学号的行记为已删除
+    void loadChunksInParallel(const char* begin, const char* end, size_t threads); // 多线程分块加载
+    bool loadFrom(const std::string& path, StorageFormat format); // 从指定文件加载
+    bool rollbackTransaction(bool reload); // 结束事务，reload 为 false 时不恢复内存中的数据（析构时）
     
 public:
     // 构造函数和析构函数
-    StudentManager(const std::string& filename = "students.txt");
+    StudentManager(const std::string& filename = "students.txt",
+                   const ManagerOptions& options = ManagerOptions());
     ~StudentManager();
     
-    // 基本操作
+    // 基本操作。启用日志时写日志失败也返回 false（并提示）：修改已在内存中生效，
+    // 记录留在日志缓冲区中，之后写盘成功即补上，退出时仍写不进去则整体保存数据文件
     bool addStudent(const Student& student);           // 添加学生
     bool deleteStudent(int id);                        // 删除学生
     bool updateStudent(int id, const Student& newInfo); // 更新学生信息
-    Student* findStudent(int id);                      // 查找学生
     
-    // 显示操作
-    void displayAllStudents() const;                  // 显示所有学生
-    void displayStudentsByMajor(const std::string& major) const; // 按专业显示
-    void displayStudentsByGpa(double minGpa) const;   // 按绩点显示
+    // 批量导入：一次性预留容量，逐条用哈希索引查重，不输出任何信息。
+    // 返回的报告中 loadedRows 为导入条数，skipped 列出未导入的行（行号从 1 开始）
+    LoadReport addStudents(const std::vector<Student>& batch);  // 行号为在 batch 中的位置
+    LoadReport importFrom(std::istream& in);                     // 按数据文件的文本格式读取整个流
+    StudentRef findStudent(int id) const;              // 查找学生，未找到时返回空视图（修改请使用 updateStudent）
+    
+    // 查询操作（按当前显示顺序，只返回 page 指定的一页，返回的视图在下一次修改前有效）
+    std::vector<StudentRef> getAllStudents(const QueryPage& page = QueryPage()) const;  // 所有学生
+    std::vector<StudentRef> getStudentsByMajor(const std::string& major,
+                                               const QueryPage& page = QueryPage()) const; // 指定专业的学生
+    std::vector<StudentRef> getStudentsByMinGpa(double minGpa,
+                                                const QueryPage& page = QueryPage()) const; // 绩点 >= minGpa 的学生
+    void forEachStudent(const std::function<void(const StudentRef&)>& visit) const; // 逐个访问，不生成列表
+    
+    // 流式查询：按当前显示顺序把 page 内的匹配结果逐个交给 visit，不复制记录也不生成列表；
+    // 取满一页或 visit 返回 false 时立即停止扫描。返回交给 visit 的条数
+    size_t scanStudents(const StudentVisitor& visit, const QueryPage& page = QueryPage()) const;
+    size_t scanByMajor(const std::string& major, const StudentVisitor& visit,
+                       const QueryPage& page = QueryPage()) const;
+    size_t scanByMinGpa(double minGpa, const StudentVisitor& visit, const QueryPage& page = QueryPage()) const;
+    size_t scanByName(const std::string& name, const StudentVisitor& visit,
+                      const QueryPage& page = QueryPage()) const; // 匹配规则同 searchByName
+    
+    // 组合查询：先用抽样估计每个条件的命中率，在已建立的索引（学号哈希、学号/姓名/绩点有序索引、
+    // 姓名 n-gram 索引）与全表扫描中选检查行数最少的访问路径，再按命中率从低到高求值其余条件；
+    // 有 limit 时用大小为 offset + limit 的堆取前 k 条，访问路径本身有序时取满一页即停止
+    QueryResult query(const StudentQuery& query) const;
+    void displayQuery(const StudentQuery& query, std::ostream& out = std::cout) const; // 执行并以表格显示
     
-    // 统计操作
-    int getTotalStudents() const;                     // 获取学生总数
-    double getAverageGpa() const;                     // 获取平均绩点
-    void getStatistics() const;                      // 显示统计信息
+    // 显示操作：由 StudentFormatter 渲染成表格，整块写到 out
+    void displayAllStudents(std::ostream& out = std::cout) const;                // 显示所有学生
+    void displayStudentsByMajor(const std::string& major, std::ostream& out = std::cout) const; // 按专业显示
+    void displayStudentsByGpa(double minGpa, std::ostream& out = std::cout) const; // 按绩点显示
     
-    // 排序操作
+    // 统计操作：人数与绩点总和随增删改增量维护，读取不扫描全表
+    int getTotalStudents() const;                     // 获取学生总数，O(1)
+    double getAverageGpa() const;                     // 获取平均绩点，O(1)
+    void getStatistics(std::ostream& out = std::cout) const; // 显示统计信息
+    static void formatStatistics(const GpaStatistics& stats, std::ostream& out); // 按 getStatistics 的格式输出
+    GpaStatistics getGpaStatistics() const;          // 人数、绩点总和与最值（不输出），视图在下一次修改前有效。
+                                                     // 最值由最值树给出，第一次读取时 O(n) 建立，之后 O(1)
+    std::map<std::string, GroupStatistics> getStatisticsByMajor() const; // 各专业的人数与绩点
+    std::map<int, GroupStatistics> getStatisticsByAge() const;           // 各年龄的人数与绩点
+    // 绩点分布：随增删改增量维护，查询 O(log n)，不需要排序
+    double getGpaPercentile(double percent) const;    // 第 percent（0~100）百分位的绩点，没有有效绩点时返回 NaN
+    double getGpaPercentileRank(int id) const;        // 学生的百分位排名（绩点更低者加相同者的一半所占比例，0~100），
+                                                     // 找不到或绩点无效时返回 -1
+    std::vector<GpaBin> getGpaHistogram(double low, double high, double width) const; // [low, high] 按 width 分组的人数
+    void displayGpaDistribution(std::ostream& out = std::cout) const; // 显示分位数与直方图
+    bool verifyStatistics(std::string& error) const; // 与全表扫描的结果核对，不一致时返回 false 并说明
+    
+    // 排序操作（只切换显示顺序，不移动存储中的数据）
     void sortById();                                  // 按学号排序
     void sortByName();                               // 按姓名排序
     void sortByGpa();                                // 按绩点排序
+    SortKey getSortOrder() const;                    // 当前显示顺序
+    
+    // 有序索引上的区间查询，O(log n + k)；返回的视图在下一次修改前有效
+    std::vector<StudentRef> getStudentsByIdRange(int minId, int maxId) const;              // 学号在 [minId, maxId]
+    std::vector<StudentRef> getStudentsByNamePrefix(const std::string& prefix) const;      // 姓名以 prefix 开头
+    std::vector<StudentRef> getStudentsByGpaRange(double minGpa, double maxGpa) const;     // 绩点在 [minGpa, maxGpa]，从高到低
+    std::vector<StudentRef> getTopStudentsByGpa(size_t k) const;                           // 绩点最高的 k 名
     
     // 文件操作
-    bool saveToFile() const;                         // 保存到文件
+    bool saveToFile() const;                         // 保存到文件（启用日志时写新快照并截断日志）
+    // 后台保存：在调用线程取一份时点快照（数值列按列复制，姓名与原表共享只读的字符串池大块，不逐条复制），
+    // 由后台线程写数据文件（先写临时文件再改名；启用日志时即后台检查点），返回后可以照常修改。
+    // 返回的 future 在写完后得到是否成功；done 不为空时在后台线程中以同样的结果调用，回调中不能调用本对象的方法。
+    // 上一次后台保存尚未完成时先等待它；事务进行中或没有数据文件时立即以 false 完成
+    std::future<bool> saveAsync(const SaveCallback& done = SaveCallback()) const;
+    // 按保存策略（ManagerOptions::autoSaveChanges / autoSaveIntervalMs）检查，需要时启动后台保存。
+    // 每次修改后自动调用；修改停止后要满足时间条件，可由空闲的调用者（如事件循环）定期调用
+    void maybeAutoSave();
+    bool syncLog();                                  // 立即把日志中的修改写盘
+    bool hasLogFailure() const;                      // 启用日志且最近一次写盘失败（修改仍在内存与日志缓冲区中）
+    
+    // 事务（需要数据文件）：begin 之后的修改只在内存中进行、不写日志，saveToFile 被拒绝；
+    // commit 整体写一次数据文件（先写临时文件再改名，启用日志时同时截断日志），
+    // rollback 丢弃期间的全部修改并重新加载。对象析构时未提交的事务自动回滚
+    bool beginTransaction();
+    bool commitTransaction();
+    bool rollbackTransaction();
+    bool isInTransaction() const;
     bool loadFromFile();                             // 从文件加载
+    const LoadReport& getLastLoadReport() const;     // 最近一次加载的报告（含跳过的行）
+    bool exportTo(const std::string& path, StorageFormat format = FORMAT_AUTO) const; // 另存为指定文件
+    static bool convertFile(const std::string& source, const std::string& target); // 在文本与快照格式间转换
     
     // 搜索操作
-    std::vector<Student> searchByName(const std::string& name) const; // 按姓名搜索
-    std::vector<Student> searchByMajor(const std::string& major) const; // 按专业搜索
+    // 按姓名关键字搜索（按 UTF-8 字符匹配），返回的视图在下一次修改前有效。
+    // limit 为 0 时返回全部结果并按显示顺序排列；否则找到 limit 条即返回（适合输入联想），不保证顺序
+    std::vector<StudentRef> searchByName(const std::string& name, size_t limit = 0) const;
+    std::vector<StudentRef> searchByName(const std::string& name, const QueryPage& page) const; // 按显示顺序取一页
+    std::vector<StudentRef> searchByMajor(const std::string& major,
+                                          const QueryPage& page = QueryPage()) const; // 按专业搜索（同 getStudentsByMajor）
     
     // 清空数据
     void clearAllStudents();
+    
+    // 提示与错误信息的输出目标，为空时不输出（见 ManagerOptions::messages）
+    void setMessageStream(std::ostream* out);
+    
+    // 存储维护
+    void compact();                                   // 清除已删除槽位，保持现有顺序
+    size_t getDeletedSlots() const;                   // 等待压缩的已删除槽位数
+    
+    // 运行指标：各类操作的调用次数与耗时分布、数据文件读写字节数。
+    // 按线程分槽记录、读取时合并；编译时定义 STUDENT_NO_METRICS（make METRICS=0）后不记录，开销为零
+    MetricsSnapshot getMetrics() const;
+    void resetMetrics();
+    bool exportMetrics(const std::string& path) const; // 以 Prometheus 文本格式写入文件
 };
 
 #endif // STUDENTMANAGER_H
\ No newline at end of file
@@ -0,0 +1,355 @@
+#include "StudentQuery.h"
+#include <sstream>
+#include <iomanip>
+#include <cstdlib>
+#include <cstring>
+#include <cctype>
+
+namespace {
+    // 词法单元
+    struct Token {
+        std::string text;
+        bool quoted;                   // 引号括起的字符串（不会被当作关键字或运算符）
+        bool isOperator;
+    };
+
+    bool isOperatorChar(char c) {
+        return c != '\0' && std::strchr("=!<>~^", c) != nullptr;
+    }
+
+    // 切分查询语句：空白分隔；运算符可以与字段名、取值相连（gpa>=3.5）；引号内可以包含空格
+    bool tokenize(const std::string& text, std::vector<Token>& tokens, std::string& error) {
+        size_t i = 0;
+        while (i < text.size()) {
+            unsigned char c = static_cast<unsigned char>(text[i]);
+            if (std::isspace(c)) {
+                ++i;
+                continue;
+            }
+            Token token;
+            token.quoted = false;
+            token.isOperator = false;
+            if (c == '"' || c == '\'') {
+                size_t close = text.find(static_cast<char>(c), i + 1);
+                if (close == std::string::npos) {
+                    error = "引号没有闭合";
+                    return false;
+                }
+                token.text = text.substr(i + 1, close - i - 1);
+                token.quoted = true;
+                i = close + 1;
+            } else if (isOperatorChar(text[i])) {
+                size_t end = i;
+                while (end < text.size() && isOperatorChar(text[end])) ++end;
+                token.text = text.substr(i, end - i);
+                token.isOperator = true;
+                i = end;
+            } else {
+                size_t end = i;
+                while (end < text.size() && !std::isspace(static_cast<unsigned char>(text[end])) &&
+                       !isOperatorChar(text[end]) && text[end] != '"' && text[end] != '\'') {
+                    ++end;
+                }
+                token.text = text.substr(i, end - i);
+                i = end;
+            }
+            tokens.push_back(token);
+        }
+        return true;
+    }
+
+    std::string lower(const std::string& s) {
+        std::string result = s;
+        for (size_t i = 0; i < result.size(); ++i) {
+            result[i] = static_cast<char>(std::tolower(static_cast<unsigned char>(result[i])));
+        }
+        return result;
+    }
+
+    bool parseField(const std::string& word, QueryField& field) {
+        static const struct { const char* english; const char* chinese; QueryField field; } FIELDS[] = {
+            { "id", "学号", FIELD_ID }, { "name", "姓名", FIELD_NAME }, { "age", "年龄", FIELD_AGE },
+            { "gender", "性别", FIELD_GENDER }, { "major", "专业", FIELD_MAJOR }, { "gpa", "绩点", FIELD_GPA }
+        };
+        std::string key = lower(word);
+        for (size_t i = 0; i < sizeof(FIELDS) / sizeof(FIELDS[0]); ++i) {
+            if (key == FIELDS[i].english || word == FIELDS[i].chinese) {
+                field = FIELDS[i].field;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool parseOp(const std::string& text, QueryOp& op) {
+        static const struct { const char* text; QueryOp op; } OPS[] = {
+            { "=", OP_EQ }, { "==", OP_EQ }, { "!=", OP_NE }, { "<>", OP_NE }, { "<", OP_LT }, { "<=", OP_LE },
+            { ">", OP_GT }, { ">=", OP_GE }, { "~", OP_CONTAINS }, { "^=", OP_PREFIX }
+        };
+        for (size_t i = 0; i < sizeof(OPS) / sizeof(OPS[0]); ++i) {
+            if (text == OPS[i].text) {
+                op = OPS[i].op;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool parseNumber(const std::string& text, double& value) {
+        if (text.empty()) return false;
+        char* end = nullptr;
+        value = std::strtod(text.c_str(), &end);
+        return *end == '\0';
+    }
+
+    bool parseCount(const std::string& text, size_t& value) {
+        if (text.empty() || text.find_first_not_of("0123456789") != std::string::npos) return false;
+        value = static_cast<size_t>(std::strtoull(text.c_str(), nullptr, 10));
+        return true;
+    }
+
+    // 按 token 顺序读取的解析器
+    class Parser {
+    private:
+        const std::vector<Token>& tokens;
+        size_t pos;
+
+    public:
+        std::string error;
+
+        explicit Parser(const std::vector<Token>& tokens) : tokens(tokens), pos(0) {}
+
+        bool atEnd() const { return pos >= tokens.size(); }
+
+        // 下一个 token 是否为关键字 word（不区分大小写）
+        bool peekKeyword(const char* word) const {
+            return !atEnd() && !tokens[pos].quoted && !tokens[pos].isOperator && lower(tokens[pos].text) == word;
+        }
+
+        bool acceptKeyword(const char* word) {
+            if (!peekKeyword(word)) return false;
+            ++pos;
+            return true;
+        }
+
+        bool next(std::string& text, const char* expected) {
+            if (atEnd()) {
+                error = std::string("语句不完整，缺少") + expected;
+                return false;
+            }
+            text = tokens[pos++].text;
+            return true;
+        }
+
+        bool readField(QueryField& field) {
+            std::string word;
+            if (!next(word, "字段名")) return false;
+            if (!parseField(word, field)) {
+                error = "未知字段：" + word;
+                return false;
+            }
+            return true;
+        }
+
+        bool readCount(size_t& value, const char* what) {
+            std::string word;
+            if (!next(word, what)) return false;
+            if (!parseCount(word, value)) {
+                error = std::string(what) + "应为非负整数：" + word;
+                return false;
+            }
+            return true;
+        }
+
+        bool readValue(QueryField field, QueryCondition& condition) {
+            std::string word;
+            if (!next(word, "取值")) return false;
+            condition.text = word;
+            if (StudentQuery::isNumeric(field) && !parseNumber(word, condition.number)) {
+                error = std::string(StudentQuery::fieldName(field)) + "的取值应为数字：" + word;
+                return false;
+            }
+            return true;
+        }
+
+        bool readCondition(StudentQuery& query) {
+            QueryField field;
+            if (!readField(field)) return false;
+
+            if (acceptKeyword("between")) {
+                QueryCondition low, high;
+                if (!readValue(field, low)) return false;
+                if (!acceptKeyword("and")) {
+                    error = "between 之后应为 “下限 and 上限”";
+                    return false;
+                }
+                if (!readValue(field, high)) return false;
+                if (StudentQuery::isNumeric(field)) {
+                    query.between(field, low.number, high.number);
+                } else {
+                    query.where(field, OP_GE, low.text).where(field, OP_LE, high.text);
+                }
+                return true;
+            }
+
+            std::string opText;
+            QueryOp op;
+            if (!next(opText, "运算符")) return false;
+            if (!parseOp(opText, op)) {
+                error = "未知运算符：" + opText;
+                return false;
+            }
+            if ((op == OP_CONTAINS || op == OP_PREFIX) && StudentQuery::isNumeric(field)) {
+                error = std::string("运算符 ") + opText + " 只能用于姓名、性别、专业";
+                return false;
+            }
+            QueryCondition condition;
+            if (!readValue(field, condition)) return false;
+            if (StudentQuery::isNumeric(field)) {
+                query.where(field, op, condition.number);
+            } else {
+                query.where(field, op, condition.text);
+            }
+            return true;
+        }
+
+        // 查询语句：[where] 条件 {and 条件} [order by 字段 [asc|desc]] [limit N] [offset M] [stats]
+        bool parse(StudentQuery& query) {
+            acceptKeyword("where");
+            if (!atEnd() && !peekKeyword("order") && !peekKeyword("limit") &&
+                !peekKeyword("offset") && !peekKeyword("stats")) {
+                do {
+                    if (!readCondition(query)) return false;
+                } while (acceptKeyword("and"));
+            }
+
+            size_t offset = 0, limit = 0;
+            while (!atEnd()) {
+                if (acceptKeyword("order")) {
+                    if (!acceptKeyword("by")) {
+                        error = "order 之后应为 by";
+                        return false;
+                    }
+                    QueryField field;
+                    if (!readField(field)) return false;
+                    bool descending = acceptKeyword("desc");
+                    if (!descending) acceptKeyword("asc");
+                    query.orderBy(field, descending);
+                } else if (acceptKeyword("limit")) {
+                    if (!readCount(limit, "limit")) return false;
+                } else if (acceptKeyword("offset")) {
+                    if (!readCount(offset, "offset")) return false;
+                } else if (acceptKeyword("stats")) {
+                    query.withStatistics();
+                } else {
+                    error = "无法识别：" + tokens[pos].text;
+                    return false;
+                }
+            }
+            query.page(offset, limit);
+            return true;
+        }
+    };
+}
+
+StudentQuery::StudentQuery()
+    : ordered(false), orderField(FIELD_ID), descending(false), offset(0), limit(0), statistics(false) {}
+
+StudentQuery& StudentQuery::where(QueryField field, QueryOp op, double value) {
+    QueryCondition condition;
+    condition.field = field;
+    condition.op = op;
+    condition.number = value;
+    std::ostringstream text;
+    text << std::setprecision(15) << value;
+    condition.text = text.str();
+    conditions.push_back(condition);
+    return *this;
+}
+
+StudentQuery& StudentQuery::where(QueryField field, QueryOp op, const std::string& value) {
+    QueryCondition condition;
+    condition.field = field;
+    condition.op = op;
+    condition.number = std::strtod(value.c_str(), nullptr);
+    condition.text = value;
+    conditions.push_back(condition);
+    return *this;
+}
+
+StudentQuery& StudentQuery::between(QueryField field, double low, double high) {
+    return where(field, OP_GE, low).where(field, OP_LE, high);
+}
+
+StudentQuery& StudentQuery::orderBy(QueryField field, bool descending) {
+    ordered = true;
+    orderField = field;
+    this->descending = descending;
+    return *this;
+}
+
+StudentQuery& StudentQuery::page(size_t offset, size_t limit) {
+    this->offset = offset;
+    this->limit = limit;
+    return *this;
+}
+
+StudentQuery& StudentQuery::withStatistics() {
+    statistics = true;
+    return *this;
+}
+
+bool StudentQuery::parse(const std::string& text, StudentQuery& out, std::string& error) {
+    std::vector<Token> tokens;
+    if (!tokenize(text, tokens, error)) {
+        return false;
+    }
+    StudentQuery query;
+    Parser parser(tokens);
+    if (!parser.parse(query)) {
+        error = parser.error;
+        return false;
+    }
+    out = query;
+    return true;
+}
+
+const std::vector<QueryCondition>& StudentQuery::getConditions() const { return conditions; }
+bool StudentQuery::isOrdered() const { return ordered; }
+QueryField StudentQuery::getOrderField() const { return orderField; }
+bool StudentQuery::isDescending() const { return descending; }
+size_t StudentQuery::getOffset() const { return offset; }
+size_t StudentQuery::getLimit() const { return limit; }
+bool StudentQuery::wantsStatistics() const { return statistics; }
+
+bool StudentQuery::isNumeric(QueryField field) {
+    return field == FIELD_ID || field == FIELD_AGE || field == FIELD_GPA;
+}
+
+const char* StudentQuery::fieldName(QueryField field) {
+    switch (field) {
+        case FIELD_ID: return "学号";
+        case FIELD_NAME: return "姓名";
+        case FIELD_AGE: return "年龄";
+        case FIELD_GENDER: return "性别";
+        case FIELD_MAJOR: return "专业";
+        default: return "绩点";
+    }
+}
+
+const char* StudentQuery::opName(QueryOp op) {
+    switch (op) {
+        case OP_EQ: return "=";
+        case OP_NE: return "!=";
+        case OP_LT: return "<";
+        case OP_LE: return "<=";
+        case OP_GT: return ">";
+        case OP_GE: return ">=";
+        case OP_CONTAINS: return "~";
+        default: return "^=";
+    }
+}
+
+std::string StudentQuery::describe(const QueryCondition& condition) {
+    return std::string(fieldName(condition.field)) + " " + opName(condition.op) + " " + condition.text;
+}
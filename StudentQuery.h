@@ -0,0 +1,82 @@
+#ifndef STUDENTQUERY_H
+#define STUDENTQUERY_H
+
+#include <vector>
+#include <string>
+#include <cstddef>
+
+// 可查询的字段
+enum QueryField {
+    FIELD_ID,                          // 学号
+    FIELD_NAME,                        // 姓名
+    FIELD_AGE,                         // 年龄
+    FIELD_GENDER,                      // 性别
+    FIELD_MAJOR,                       // 专业
+    FIELD_GPA                          // 绩点
+};
+
+// 比较运算。字符串字段按字节序比较；包含、前缀只用于字符串字段
+enum QueryOp {
+    OP_EQ,                             // =
+    OP_NE,                             // !=
+    OP_LT,                             // <
+    OP_LE,                             // <=
+    OP_GT,                             // >
+    OP_GE,                             // >=
+    OP_CONTAINS,                       // ~   包含子串
+    OP_PREFIX                          // ^=  以 ... 开头
+};
+
+// 一个过滤条件：field op value。数值字段使用 number，字符串字段使用 text
+struct QueryCondition {
+    QueryField field;
+    QueryOp op;
+    double number;
+    std::string text;
+
+    QueryCondition() : field(FIELD_ID), op(OP_EQ), number(0.0) {}
+};
+
+// 组合查询：若干条件同时成立（AND）、可选的排序字段、分页与绩点统计，由 StudentManager::query 执行。
+// 可以用方法链构造，也可以用 parse 解析查询语句，例如
+//   major = 计算机科学 and age between 20 and 22 and gpa >= 3.5 order by gpa desc limit 100
+// 字段名可以写英文（id name age gender major gpa）或中文（学号 姓名 年龄 性别 专业 绩点）
+class StudentQuery {
+private:
+    std::vector<QueryCondition> conditions;
+    bool ordered;                      // 是否指定了排序字段（未指定时按当前显示顺序）
+    QueryField orderField;
+    bool descending;
+    size_t offset;                     // 跳过的结果数
+    size_t limit;                      // 最多返回的结果数，0 表示不限
+    bool statistics;                   // 是否统计所有匹配学生的绩点
+
+public:
+    StudentQuery();
+
+    // 构造查询。数值字段（学号、年龄、绩点）用 double 版本，字符串字段用 string 版本
+    StudentQuery& where(QueryField field, QueryOp op, double value);
+    StudentQuery& where(QueryField field, QueryOp op, const std::string& value);
+    StudentQuery& between(QueryField field, double low, double high); // low <= field <= high
+    StudentQuery& orderBy(QueryField field, bool descending = false);
+    StudentQuery& page(size_t offset, size_t limit);
+    StudentQuery& withStatistics();    // 统计全部匹配学生（不只是返回的一页）的人数与绩点
+
+    // 解析查询语句，失败时返回 false 并填写 error（out 不变）
+    static bool parse(const std::string& text, StudentQuery& out, std::string& error);
+
+    const std::vector<QueryCondition>& getConditions() const;
+    bool isOrdered() const;
+    QueryField getOrderField() const;
+    bool isDescending() const;
+    size_t getOffset() const;
+    size_t getLimit() const;
+    bool wantsStatistics() const;
+
+    static bool isNumeric(QueryField field);
+    static const char* fieldName(QueryField field); // 中文字段名
+    static const char* opName(QueryOp op);          // 运算符写法
+    static std::string describe(const QueryCondition& condition); // 如 "绩点 >= 3.5"
+};
+
+#endif // STUDENTQUERY_H
@@ -0,0 +1,367 @@
+#include "StudentServer.h"
+#include <cstring>
+#include <cerrno>
+
+#ifdef __linux__
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    const size_t READ_CHUNK = 64 * 1024;         // 每次 read 的大小
+    const size_t READ_BUDGET = 1 << 20;          // 一次可读事件中最多读取的字节数，避免一个连接占住事件循环
+    const size_t MAX_PENDING_OUTPUT = 4 << 20;   // 积压的响应超过该大小时暂停读取请求
+    const size_t MAX_LINE = 1 << 20;             // 单条请求的最大长度，超过时断开连接
+    const int MAX_EVENTS = 256;
+
+    // 把响应头 "+<行数>\n" 和结果追加到 out
+    void appendResponse(std::string& out, const std::string& body) {
+        size_t lines = 0;
+        for (const char* p = body.data(), *end = p + body.size();
+             (p = static_cast<const char*>(std::memchr(p, '\n', static_cast<size_t>(end - p)))) != nullptr; ++p) {
+            ++lines;
+        }
+        out += '+';
+        out += std::to_string(lines);
+        out += '\n';
+        out += body;
+    }
+}
+
+// 一个客户端连接：未处理的请求与未写出的响应
+struct StudentServer::Connection {
+    int fd;
+    std::string input;                 // 读到但尚未执行的请求
+    std::string output;                // 尚未写出的响应
+    size_t written;                    // output 中已写出的字节数
+    bool peerClosed;                   // 对方已关闭写端：处理完剩余请求、写完响应后关闭
+    bool readPaused;                   // 积压过多，暂停读取
+    uint32_t interest;                 // 当前在 epoll 中注册的事件
+
+    explicit Connection(int fd)
+        : fd(fd), written(0), peerClosed(false), readPaused(false), interest(0) {}
+
+    size_t pending() const { return output.size() - written; }
+};
+
+#ifdef __linux__
+
+StudentServer::StudentServer(StudentManager& manager)
+    : manager(manager), interpreter(manager), epollFd(::epoll_create1(EPOLL_CLOEXEC)),
+      wakeFd(::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)), requests(0), accepted(0) {
+    epoll_event event;
+    event.events = EPOLLIN;
+    event.data.fd = wakeFd;
+    ::epoll_ctl(epollFd, EPOLL_CTL_ADD, wakeFd, &event);
+}
+
+StudentServer::~StudentServer() {
+    while (!connections.empty()) {
+        close(*connections.begin()->second);
+    }
+    for (size_t i = 0; i < listeners.size(); ++i) {
+        ::close(listeners[i]);
+    }
+    if (!unixPath.empty()) {
+        ::unlink(unixPath.c_str());
+    }
+    ::close(wakeFd);
+    ::close(epollFd);
+}
+
+bool StudentServer::addListener(int fd, std::string& error) {
+    if (::listen(fd, SOMAXCONN) != 0) {
+        error = std::string("listen 失败：") + std::strerror(errno);
+        ::close(fd);
+        return false;
+    }
+    epoll_event event;
+    event.events = EPOLLIN;
+    event.data.fd = fd;
+    ::epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event);
+    listeners.push_back(fd);
+    return true;
+}
+
+bool StudentServer::listenUnix(const std::string& path, std::string& error) {
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (path.empty() || path.size() >= sizeof(address.sun_path)) {
+        error = "套接字路径为空或过长：" + path;
+        return false;
+    }
+    std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+
+    // 上次没有正常退出时会留下套接字文件，只删除套接字，不动普通文件
+    struct stat info;
+    if (::stat(path.c_str(), &info) == 0 && S_ISSOCK(info.st_mode)) {
+        ::unlink(path.c_str());
+    }
+    int fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0 || ::bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+        error = "无法绑定 " + path + "：" + std::strerror(errno);
+        if (fd >= 0) ::close(fd);
+        return false;
+    }
+    if (!addListener(fd, error)) {
+        ::unlink(path.c_str());
+        return false;
+    }
+    unixPath = path;
+    return true;
+}
+
+bool StudentServer::listenTcp(int port, std::string& error) {
+    sockaddr_in address;
+    std::memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_port = htons(static_cast<uint16_t>(port));
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    int fd = ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    int on = 1;
+    if (fd >= 0) {
+        ::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+    }
+    if (fd < 0 || ::bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+        error = "无法绑定 127.0.0.1:" + std::to_string(port) + "：" + std::strerror(errno);
+        if (fd >= 0) ::close(fd);
+        return false;
+    }
+    return addListener(fd, error);
+}
+
+void StudentServer::stop() {
+    uint64_t one = 1;
+    ssize_t ignored = ::write(wakeFd, &one, sizeof(one));
+    (void)ignored;
+}
+
+void StudentServer::run() {
+    epoll_event events[MAX_EVENTS];
+    while (true) {
+        int count = ::epoll_wait(epollFd, events, MAX_EVENTS, -1);
+        if (count < 0) {
+            if (errno == EINTR) continue;
+            return;
+        }
+        for (int i = 0; i < count; ++i) {
+            int fd = events[i].data.fd;
+            if (fd == wakeFd) {
+                return;
+            }
+            bool listener = false;
+            for (size_t l = 0; l < listeners.size(); ++l) {
+                listener = listener || listeners[l] == fd;
+            }
+            if (listener) {
+                acceptAll(fd);
+                continue;
+            }
+            std::unordered_map<int, std::unique_ptr<Connection> >::iterator it = connections.find(fd);
+            if (it == connections.end()) {
+                continue;
+            }
+            Connection& connection = *it->second;
+            if (events[i].events & (EPOLLERR | EPOLLHUP) && !(events[i].events & EPOLLIN)) {
+                close(connection);
+                continue;
+            }
+            if (events[i].events & EPOLLOUT) {
+                if (!flush(connection)) {
+                    close(connection);
+                    continue;
+                }
+                if (connection.readPaused && connection.pending() < MAX_PENDING_OUTPUT / 2) {
+                    // 积压的响应已写出大半，继续处理缓存的请求
+                    connection.readPaused = false;
+                    processInput(connection);
+                    if (!flush(connection)) {
+                        close(connection);
+                        continue;
+                    }
+                }
+            }
+            if (events[i].events & EPOLLIN) {
+                onReadable(connection);
+                continue;
+            }
+            if (connection.peerClosed && connection.pending() == 0) {
+                close(connection);
+                continue;
+            }
+            updateInterest(connection);
+        }
+    }
+}
+
+void StudentServer::acceptAll(int listener) {
+    while (true) {
+        int fd = ::accept4(listener, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            return;                    // EAGAIN：已接受完；其他错误（如文件描述符耗尽）留到下次
+        }
+        int on = 1;
+        ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on)); // Unix 域套接字上会失败，忽略
+        std::unique_ptr<Connection> connection(new Connection(fd));
+        Connection& added = *connection;
+        connections[fd] = std::move(connection);
+        ++accepted;
+        updateInterest(added);
+    }
+}
+
+// 读取请求（受 READ_BUDGET 限制，剩下的由水平触发的下一次事件继续读），执行后一次写出全部响应
+void StudentServer::onReadable(Connection& connection) {
+    size_t budget = READ_BUDGET;
+    while (budget > 0 && !connection.readPaused) {
+        size_t old = connection.input.size();
+        connection.input.resize(old + READ_CHUNK);
+        ssize_t n = ::read(connection.fd, &connection.input[old], READ_CHUNK);
+        connection.input.resize(old + (n > 0 ? static_cast<size_t>(n) : 0));
+        if (n > 0) {
+            budget -= std::min(budget, static_cast<size_t>(n));
+            processInput(connection);
+            continue;
+        }
+        if (n == 0) {
+            connection.peerClosed = true;
+        } else if (errno == EINTR) {
+            continue;
+        } else if (errno != EAGAIN && errno != EWOULDBLOCK) {
+            close(connection);
+            return;
+        }
+        break;
+    }
+    if (connection.input.size() > MAX_LINE) {
+        close(connection);             // 一行请求过长
+        return;
+    }
+    if (!flush(connection)) {
+        close(connection);
+        return;
+    }
+    if (connection.peerClosed && connection.pending() == 0) {
+        close(connection);
+        return;
+    }
+    updateInterest(connection);
+}
+
+// 执行 input 中所有完整的请求行，响应追加到 output；积压过多时停下
+void StudentServer::processInput(Connection& connection) {
+    const char* begin = connection.input.data();
+    const char* end = begin + connection.input.size();
+    const char* p = begin;
+    while (p < end) {
+        if (connection.pending() >= MAX_PENDING_OUTPUT) {
+            connection.readPaused = true;
+            break;
+        }
+        const char* newline = static_cast<const char*>(std::memchr(p, '\n', static_cast<size_t>(end - p)));
+        if (newline == nullptr) {
+            break;
+        }
+        scratch.clear();
+        if (interpreter.execute(p, newline, scratch, commandError)) {
+            appendResponse(connection.output, scratch);
+        } else {
+            connection.output += '-';
+            connection.output += commandError;
+            connection.output += '\n';
+        }
+        ++requests;
+        p = newline + 1;
+    }
+    connection.input.erase(0, static_cast<size_t>(p - begin));
+}
+
+bool StudentServer::flush(Connection& connection) {
+    while (connection.pending() > 0) {
+        ssize_t n = ::send(connection.fd, connection.output.data() + connection.written,
+                           connection.pending(), MSG_NOSIGNAL);
+        if (n > 0) {
+            connection.written += static_cast<size_t>(n);
+        } else if (n < 0 && errno == EINTR) {
+            continue;
+        } else if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            break;
+        } else {
+            return false;
+        }
+    }
+    if (connection.pending() == 0) {
+        connection.output.clear();
+        connection.written = 0;
+    } else if (connection.written >= MAX_PENDING_OUTPUT) {
+        // 已写出的前缀较大时才挪动剩余部分
+        connection.output.erase(0, connection.written);
+        connection.written = 0;
+    }
+    return true;
+}
+
+// 有积压的响应时关注可写事件；暂停读取或对方已关闭时不再关注可读事件
+void StudentServer::updateInterest(Connection& connection) {
+    uint32_t wanted = 0;
+    if (!connection.readPaused && !connection.peerClosed) {
+        wanted |= EPOLLIN;
+    }
+    if (connection.pending() > 0) {
+        wanted |= EPOLLOUT;
+    }
+    if (wanted == connection.interest) {
+        return;
+    }
+    epoll_event event;
+    event.events = wanted;
+    event.data.fd = connection.fd;
+    ::epoll_ctl(epollFd, connection.interest == 0 ? EPOLL_CTL_ADD : EPOLL_CTL_MOD, connection.fd, &event);
+    connection.interest = wanted;
+}
+
+void StudentServer::close(Connection& connection) {
+    int fd = connection.fd;
+    ::epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr);
+    ::close(fd);
+    connections.erase(fd);
+}
+
+#else // 非 Linux 平台没有 epoll
+
+StudentServer::StudentServer(StudentManager& manager)
+    : manager(manager), interpreter(manager), epollFd(-1), wakeFd(-1), requests(0), accepted(0) {}
+
+StudentServer::~StudentServer() {}
+
+bool StudentServer::listenUnix(const std::string&, std::string& error) {
+    error = "服务模式只支持 Linux";
+    return false;
+}
+
+bool StudentServer::listenTcp(int, std::string& error) {
+    error = "服务模式只支持 Linux";
+    return false;
+}
+
+void StudentServer::run() {}
+void StudentServer::stop() {}
+
+#endif // __linux__
+
+uint64_t StudentServer::requestCount() const {
+    return requests;
+}
+
+uint64_t StudentServer::connectionCount() const {
+    return accepted;
+}
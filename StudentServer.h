@@ -0,0 +1,59 @@
+#ifndef STUDENTSERVER_H
+#define STUDENTSERVER_H
+
+#include "StudentManager.h"
+#include "CommandInterpreter.h"
+#include <string>
+#include <vector>
+#include <memory>
+#include <unordered_map>
+#include <cstddef>
+#include <cstdint>
+
+// 本地套接字服务：在 Unix 域套接字或 127.0.0.1 的 TCP 端口上接受连接，按行读取命令，
+// 用 CommandInterpreter 对同一个 StudentManager 执行（命令格式同批处理模式）。
+// 每条请求对应一条响应：成功时为 "+<行数>\n" 后接这么多行结果，失败时为 "-<原因>\n"。
+// 客户端可以连续发送多条请求而不等待响应（流水线），服务端按顺序执行，
+// 一次读到的全部请求的响应攒在一起只写一次。
+// 单线程 epoll 事件循环，非阻塞读写；某个连接积压的响应过多时暂停读取它的请求，直到对方读走。
+// 只在 Linux 上可用，其他平台 listen 返回 false
+class StudentServer {
+private:
+    struct Connection;
+
+    StudentManager& manager;
+    CommandInterpreter interpreter;
+    int epollFd;
+    int wakeFd;                        // stop() 写入后事件循环退出
+    std::vector<int> listeners;
+    std::string unixPath;              // 监听的 Unix 域套接字路径，退出时删除
+    std::unordered_map<int, std::unique_ptr<Connection> > connections;
+    std::string scratch, commandError; // 执行单条命令的临时缓冲区
+    uint64_t requests;                 // 已处理的请求数
+    uint64_t accepted;                 // 已接受的连接数
+
+    StudentServer(const StudentServer&);
+    StudentServer& operator=(const StudentServer&);
+
+    bool addListener(int fd, std::string& error);
+    void acceptAll(int listener);
+    void onReadable(Connection& connection);
+    void processInput(Connection& connection);
+    bool flush(Connection& connection); // 尽量写出积压的响应，连接出错时返回 false
+    void updateInterest(Connection& connection);
+    void close(Connection& connection);
+
+public:
+    explicit StudentServer(StudentManager& manager);
+    ~StudentServer();
+
+    bool listenUnix(const std::string& path, std::string& error); // 已有同名的套接字文件时先删除
+    bool listenTcp(int port, std::string& error);                  // 只监听 127.0.0.1
+    void run();                        // 处理请求，直到 stop() 被调用
+    void stop();                       // 可以在信号处理函数或其他线程中调用
+
+    uint64_t requestCount() const;
+    uint64_t connectionCount() const;
+};
+
+#endif // STUDENTSERVER_H
@@ -0,0 +1,247 @@
+#include "StudentTable.h"
+#include <cstring>
+#include <limits>
+
+// ========== StudentRef ==========
+
+StudentRef::StudentRef() : table(nullptr), row(0) {}
+
+StudentRef::StudentRef(const StudentTable* table, size_t row) : table(table), row(row) {}
+
+StudentRef::operator bool() const {
+    return table != nullptr;
+}
+
+const StudentRef* StudentRef::operator->() const {
+    return this;
+}
+
+int StudentRef::getId() const {
+    return table->idColumn()[row];
+}
+
+std::string StudentRef::getName() const {
+    return table->nameColumn()[row].str();
+}
+
+int StudentRef::getAge() const {
+    return table->ageColumn()[row];
+}
+
+const std::string& StudentRef::getGender() const {
+    return table->genderOf(row);
+}
+
+const std::string& StudentRef::getMajor() const {
+    return table->majorOf(row);
+}
+
+double StudentRef::getGpa() const {
+    return table->gpaColumn()[row];
+}
+
+StringView StudentRef::getNameView() const {
+    return table->nameColumn()[row];
+}
+
+StringView StudentRef::getGenderView() const {
+    return table->genderOf(row);
+}
+
+StringView StudentRef::getMajorView() const {
+    return table->majorOf(row);
+}
+
+Student StudentRef::toStudent() const {
+    return table->get(row);
+}
+
+void StudentRef::display() const {
+    Student::display(getId(), getNameView(), getAge(), getGenderView(), getMajorView(), getGpa());
+}
+
+// ========== StudentTable ==========
+
+namespace {
+    // 字符串池中废弃的字节少于该值时不重排
+    const size_t REPACK_MIN_BYTES = 1 << 20;
+}
+
+StudentTable::StudentTable() {}
+
+StudentTable::StudentTable(const StudentTable& other)
+    : ids(other.ids), ages(other.ages), gpas(other.gpas), names(other.names), genders(other.genders),
+      majors(other.majors), genderDict(other.genderDict), majorDict(other.majorDict) {
+    namePool.shareFrom(other.namePool);
+}
+
+size_t StudentTable::size() const {
+    return ids.size();
+}
+
+void StudentTable::reserve(size_t n) {
+    ids.reserve(n);
+    ages.reserve(n);
+    gpas.reserve(n);
+    names.reserve(n);
+    genders.reserve(n);
+    majors.reserve(n);
+}
+
+void StudentTable::clear() {
+    ids.clear();
+    ages.clear();
+    gpas.clear();
+    names.clear();
+    namePool.clear();
+    genders.clear();
+    majors.clear();
+    genderDict.clear();
+    majorDict.clear();
+}
+
+void StudentTable::append(const Student& student) {
+    ids.push_back(student.getId());
+    ages.push_back(student.getAge());
+    gpas.push_back(student.getGpa());
+    names.push_back(namePool.store(student.getName()));
+    genders.push_back(genderDict.intern(student.getGender()));
+    majors.push_back(majorDict.intern(student.getMajor()));
+}
+
+void StudentTable::appendColumns(const char* idBytes, const char* ageBytes, const char* gpaBytes, size_t count) {
+    if (count == 0) {
+        return;
+    }
+    size_t first = ids.size();
+    ids.resize(first + count);
+    ages.resize(first + count);
+    gpas.resize(first + count);
+    names.resize(first + count);
+    genders.resize(first + count);
+    majors.resize(first + count);
+    std::memcpy(&ids[first], idBytes, count * sizeof(int));
+    std::memcpy(&ages[first], ageBytes, count * sizeof(int));
+    std::memcpy(&gpas[first], gpaBytes, count * sizeof(double));
+}
+
+void StudentTable::setText(size_t row, StringView name, StringView gender, StringView major) {
+    names[row] = namePool.store(name);
+    genders[row] = genderDict.intern(gender);
+    majors[row] = majorDict.intern(major);
+}
+
+void StudentTable::assign(size_t row, const Student& student) {
+    ids[row] = student.getId();
+    ages[row] = student.getAge();
+    gpas[row] = student.getGpa();
+    namePool.discard(names[row]);
+    names[row] = namePool.store(student.getName());
+    genders[row] = genderDict.intern(student.getGender());
+    majors[row] = majorDict.intern(student.getMajor());
+    maybeRepackNames();
+}
+
+void StudentTable::release(size_t row) {
+    // 绩点置为 NaN，绩点扫描内核不必再读存活标记就能跳过已删除的行
+    gpas[row] = std::numeric_limits<double>::quiet_NaN();
+    namePool.discard(names[row]);
+    names[row] = StringView();
+    maybeRepackNames();
+}
+
+void StudentTable::maybeRepackNames() {
+    if (namePool.bytesWasted() >= REPACK_MIN_BYTES && namePool.bytesWasted() > namePool.bytesLive()) {
+        std::vector<size_t> order(names.size());
+        for (size_t i = 0; i < order.size(); ++i) {
+            order[i] = i;
+        }
+        repackNames(order);
+    }
+}
+
+// 重排后姓名按行的顺序连续存放，同时丢弃废弃的字节
+void StudentTable::repackNames(const std::vector<size_t>& order) {
+    StringPool packed;
+    std::vector<StringView> result;
+    result.reserve(order.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+        result.push_back(packed.store(names[order[i]]));
+    }
+    names.swap(result);
+    namePool.swap(packed);
+}
+
+Student StudentTable::get(size_t row) const {
+    return Student(ids[row], names[row].str(), ages[row], genderOf(row), majorOf(row), gpas[row]);
+}
+
+StudentRef StudentTable::at(size_t row) const {
+    return StudentRef(this, row);
+}
+
+namespace {
+    template <typename T>
+    void permuteColumn(std::vector<T>& column, const std::vector<size_t>& order) {
+        std::vector<T> result;
+        result.reserve(order.size());
+        for (size_t i = 0; i < order.size(); ++i) {
+            result.push_back(std::move(column[order[i]]));
+        }
+        column.swap(result);
+    }
+}
+
+// 逐列重排，每次只有一列的临时副本；姓名复制到新的字符串池，被丢弃的行不再占用空间
+void StudentTable::permute(const std::vector<size_t>& order) {
+    permuteColumn(ids, order);
+    permuteColumn(ages, order);
+    permuteColumn(gpas, order);
+    repackNames(order);
+    permuteColumn(genders, order);
+    permuteColumn(majors, order);
+}
+
+const std::vector<int>& StudentTable::idColumn() const {
+    return ids;
+}
+
+const std::vector<int>& StudentTable::ageColumn() const {
+    return ages;
+}
+
+const std::vector<double>& StudentTable::gpaColumn() const {
+    return gpas;
+}
+
+const std::vector<StringView>& StudentTable::nameColumn() const {
+    return names;
+}
+
+const std::vector<StringDictionary::Code>& StudentTable::genderColumn() const {
+    return genders;
+}
+
+const std::vector<StringDictionary::Code>& StudentTable::majorColumn() const {
+    return majors;
+}
+
+const StringDictionary& StudentTable::genderDictionary() const {
+    return genderDict;
+}
+
+const StringDictionary& StudentTable::majorDictionary() const {
+    return majorDict;
+}
+
+const std::string& StudentTable::genderOf(size_t row) const {
+    return genderDict.lookup(genders[row]);
+}
+
+const std::string& StudentTable::majorOf(size_t row) const {
+    return majorDict.lookup(majors[row]);
+}
+
+const StringPool& StudentTable::nameStorage() const {
+    return namePool;
+}
@@ -0,0 +1,99 @@
+#ifndef STUDENTTABLE_H
+#define STUDENTTABLE_H
+
+#include "Student.h"
+#include "StringDictionary.h"
+#include "StringPool.h"
+#include <vector>
+#include <string>
+#include <cstddef>
+
+class StudentTable;
+
+// 指向表中一行的只读视图，接口与 Student 的 getter 一致。
+// 与指针一样，表被修改（插入、压缩、排序）后视图失效
+class StudentRef {
+private:
+    const StudentTable* table;         // 所属的表，为空表示“未找到”
+    size_t row;                        // 行号
+
+public:
+    StudentRef();
+    StudentRef(const StudentTable* table, size_t row);
+
+    explicit operator bool() const;    // 是否指向有效的行
+    const StudentRef* operator->() const; // 兼容原来返回指针时的 ref->display() 写法
+
+    int getId() const;
+    std::string getName() const;       // 姓名存放在表的字符串池中，这里返回副本；不需要副本时用 getNameView
+    int getAge() const;
+    const std::string& getGender() const;
+    const std::string& getMajor() const;
+    double getGpa() const;
+
+    // 不复制的字符串访问，视图与 StudentRef 本身同时失效
+    StringView getNameView() const;
+    StringView getGenderView() const;
+    StringView getMajorView() const;
+
+    Student toStudent() const;         // 复制为独立的 Student 对象
+    void display() const;              // 显示学生信息（格式与 Student::display 相同）
+};
+
+// 列式（SoA）存储的学生表：学号、年龄、绩点各自连续存放，
+// 扫描某一数值列时只读取该列，不会把字符串成员一起带进缓存。
+// 性别和专业只有少数几种取值，按字典编码存储，每条记录各占 2 字节；
+// 姓名连续存放在字符串池中，每条记录只保存一个视图，不单独占用堆内存，清空时整块释放
+class StudentTable {
+private:
+    std::vector<int> ids;              // 学号列
+    std::vector<int> ages;             // 年龄列
+    std::vector<double> gpas;          // 绩点列
+    std::vector<StringView> names;     // 姓名列（指向 namePool）
+    StringPool namePool;               // 姓名的存储
+    std::vector<StringDictionary::Code> genders; // 性别编码列
+    std::vector<StringDictionary::Code> majors;  // 专业编码列
+    StringDictionary genderDict;       // 性别字典
+    StringDictionary majorDict;        // 专业字典
+
+    void maybeRepackNames();           // 废弃的姓名字节超过仍在使用的字节时重排字符串池
+    void repackNames(const std::vector<size_t>& order); // 按 order 把姓名复制到新的字符串池
+
+public:
+    StudentTable();
+    StudentTable(const StudentTable& other); // 按列复制；姓名与原表共享字符串池中只读的大块，不逐个复制。
+                                             // 两表之后的修改互不影响
+    StudentTable& operator=(const StudentTable&) = delete;
+
+    size_t size() const;               // 行数
+    void reserve(size_t n);            // 预留 n 行的空间
+    void clear();                      // 清空所有行（字符串池整块释放）
+
+    void append(const Student& student);            // 追加一行
+    // 批量追加 count 行（快照加载）：学号、年龄、绩点三列从 ids、ages、gpas 整段复制（小端序，
+    // 可以不对齐，如内存映射的文件），字符串列先留空，再由 setText 逐行写入
+    void appendColumns(const char* ids, const char* ages, const char* gpas, size_t count);
+    void setText(size_t row, StringView name, StringView gender, StringView major); // 姓名存入字符串池，性别专业查字典
+    void assign(size_t row, const Student& student); // 覆盖一行
+    void release(size_t row);          // 删除时调用：姓名记为废弃，绩点置为 NaN
+    Student get(size_t row) const;     // 取出一行的副本
+    StudentRef at(size_t row) const;   // 取一行的视图
+
+    // 按 order 重排：新表的第 i 行为原表的第 order[i] 行，未列出的行被丢弃
+    void permute(const std::vector<size_t>& order);
+
+    // 列访问
+    const std::vector<int>& idColumn() const;
+    const std::vector<int>& ageColumn() const;
+    const std::vector<double>& gpaColumn() const;
+    const std::vector<StringView>& nameColumn() const;
+    const std::vector<StringDictionary::Code>& genderColumn() const;
+    const std::vector<StringDictionary::Code>& majorColumn() const;
+    const StringDictionary& genderDictionary() const;
+    const StringDictionary& majorDictionary() const;
+    const std::string& genderOf(size_t row) const;  // 解码后的性别
+    const std::string& majorOf(size_t row) const;   // 解码后的专业
+    const StringPool& nameStorage() const;         // 姓名字符串池（用于统计内存占用）
+};
+
+#endif // STUDENTTABLE_H
@@ -0,0 +1,61 @@
+#include "ThreadPool.h"
+
+ThreadPool::ThreadPool(size_t threads) : stopping(false) {
+    if (threads == 0) {
+        threads = hardwareThreads();
+    }
+    workers.reserve(threads);
+    for (size_t i = 0; i < threads; ++i) {
+        workers.push_back(std::thread(&ThreadPool::workerLoop, this));
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    available.notify_all();
+    for (size_t i = 0; i < workers.size(); ++i) {
+        workers[i].join();
+    }
+}
+
+void ThreadPool::workerLoop() {
+    while (true) {
+        std::packaged_task<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            while (!stopping && tasks.empty()) {
+                available.wait(lock);
+            }
+            if (tasks.empty()) {
+                return;
+            }
+            task = std::move(tasks.front());
+            tasks.pop();
+        }
+        // 任务抛出的异常由 packaged_task 保存到 future 中
+        task();
+    }
+}
+
+std::future<void> ThreadPool::submit(const std::function<void()>& task) {
+    std::packaged_task<void()> packaged(task);
+    std::future<void> result = packaged.get_future();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        tasks.push(std::move(packaged));
+    }
+    available.notify_one();
+    return result;
+}
+
+size_t ThreadPool::size() const {
+    return workers.size();
+}
+
+size_t ThreadPool::hardwareThreads() {
+    unsigned n = std::thread::hardware_concurrency();
+    return n == 0 ? 1 : n;
+}
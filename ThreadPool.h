@@ -0,0 +1,36 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <vector>
+#include <queue>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <future>
+
+// 固定大小的线程池：提交的任务按先进先出顺序执行
+class ThreadPool {
+private:
+    std::vector<std::thread> workers;              // 工作线程
+    std::queue<std::packaged_task<void()> > tasks; // 等待执行的任务
+    std::mutex mutex;                              // 保护任务队列
+    std::condition_variable available;             // 有新任务或需要退出时通知
+    bool stopping;                                 // 析构时置位
+
+    ThreadPool(const ThreadPool&);
+    ThreadPool& operator=(const ThreadPool&);
+
+    void workerLoop();
+
+public:
+    explicit ThreadPool(size_t threads);           // threads 为 0 时使用硬件线程数
+    ~ThreadPool();                                 // 执行完已提交的任务后退出
+
+    std::future<void> submit(const std::function<void()>& task); // 提交任务
+    size_t size() const;                           // 工作线程数
+
+    static size_t hardwareThreads();               // 硬件线程数（至少为 1）
+};
+
+#endif // THREADPOOL_H
@@ -0,0 +1,340 @@
+#include "WriteAheadLog.h"
+#include "BinarySnapshot.h"
+#include "CsvLoader.h"
+#include <chrono>
+#include <cstring>
+#include <cstdio>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace {
+    enum OpCode {
+        OP_PUT = 1,
+        OP_UPDATE = 2,
+        OP_DELETE = 3,
+        OP_CLEAR = 4,
+        OP_SORT = 5
+    };
+
+    const size_t RECORD_HEADER = sizeof(uint32_t) + sizeof(uint64_t);
+
+    // 缓冲区超过该大小时提前唤醒后台线程写盘
+    const size_t EAGER_FLUSH_BYTES = 1 << 20;
+
+    template <typename T>
+    void put(std::vector<char>& out, T value) {
+        size_t offset = out.size();
+        out.resize(offset + sizeof(T));
+        std::memcpy(&out[offset], &value, sizeof(T));
+    }
+
+    void putString(std::vector<char>& out, const std::string& s) {
+        put<uint32_t>(out, static_cast<uint32_t>(s.size()));
+        out.insert(out.end(), s.begin(), s.end());
+    }
+
+    void putStudent(std::vector<char>& out, const Student& student) {
+        put<int32_t>(out, student.getId());
+        put<int32_t>(out, student.getAge());
+        put<double>(out, student.getGpa());
+        putString(out, student.getName());
+        putString(out, student.getGender());
+        putString(out, student.getMajor());
+    }
+
+    // 负载解码器，越界时置 ok = false
+    class Reader {
+    private:
+        const char* p;
+        const char* end;
+
+    public:
+        bool ok;
+
+        Reader(const char* begin, const char* end) : p(begin), end(end), ok(true) {}
+
+        template <typename T>
+        T get() {
+            T value = T();
+            if (static_cast<size_t>(end - p) < sizeof(T)) {
+                ok = false;
+                return value;
+            }
+            std::memcpy(&value, p, sizeof(T));
+            p += sizeof(T);
+            return value;
+        }
+
+        std::string getString() {
+            uint32_t length = get<uint32_t>();
+            if (!ok || static_cast<size_t>(end - p) < length) {
+                ok = false;
+                return std::string();
+            }
+            std::string s(p, length);
+            p += length;
+            return s;
+        }
+
+        Student getStudent() {
+            int id = get<int32_t>();
+            int age = get<int32_t>();
+            double gpa = get<double>();
+            std::string name = getString();
+            std::string gender = getString();
+            std::string major = getString();
+            return Student(id, name, age, gender, major, gpa);
+        }
+
+        bool atEnd() const {
+            return p == end;
+        }
+    };
+
+    bool writeAll(int fd, const char* data, size_t size) {
+        while (size > 0) {
+            ssize_t written = ::write(fd, data, size);
+            if (written < 0) {
+                return false;
+            }
+            data += written;
+            size -= static_cast<size_t>(written);
+        }
+        return true;
+    }
+}
+
+WriteAheadLog::WriteAheadLog(const std::string& path, unsigned syncIntervalMs)
+    : path(path), syncIntervalMs(syncIntervalMs), fd(-1), writtenBytes(0), failed(false),
+      stopping(false) {}
+
+WriteAheadLog::~WriteAheadLog() {
+    if (flusher.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_one();
+        flusher.join();
+    }
+    if (fd >= 0) {
+        sync();
+        ::close(fd);
+    }
+}
+
+bool WriteAheadLog::open(uint64_t validBytes) {
+    fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+    if (fd < 0) {
+        return false;
+    }
+    // 截掉上次崩溃时写了一半的记录，之后的追加从完整记录处继续
+    if (ftruncate(fd, static_cast<off_t>(validBytes)) != 0) {
+        return false;
+    }
+    writtenBytes = validBytes;
+    if (syncIntervalMs > 0 && !flusher.joinable()) {
+        flusher = std::thread(&WriteAheadLog::flusherLoop, this);
+    }
+    return true;
+}
+
+bool WriteAheadLog::append(const std::vector<char>& payload) {
+    bool flushNow = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        put<uint32_t>(pending, static_cast<uint32_t>(payload.size()));
+        put<uint64_t>(pending, BinarySnapshot::checksum(&payload[0], payload.size()));
+        pending.insert(pending.end(), payload.begin(), payload.end());
+        flushNow = pending.size() >= EAGER_FLUSH_BYTES;
+    }
+
+    if (syncIntervalMs == 0) {
+        return sync();
+    }
+    if (flushNow) {
+        wake.notify_one();
+    }
+    return !hasFailed();
+}
+
+// 组提交：取走缓冲区中积累的全部记录，一次 write + fdatasync。
+// 写盘期间不持有 mutex，新的追加可以继续进入缓冲区。
+// 失败时把文件截回这批记录之前的长度（不留下半条记录），记录放回缓冲区最前面等待重试
+bool WriteAheadLog::flushHeld() {
+    std::vector<char> batch;
+    uint64_t start;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (pending.empty()) {
+            return !failed;
+        }
+        if (fd < 0) {
+            failed = true;
+            return false;
+        }
+        batch.swap(pending);
+        start = writtenBytes;
+        writtenBytes += batch.size();
+    }
+
+    bool ok = writeAll(fd, &batch[0], batch.size()) && fdatasync(fd) == 0;
+    if (!ok && ftruncate(fd, static_cast<off_t>(start)) != 0) {
+        // 截不回去时之后的记录会跟在残缺记录后面，重放时读不到，只能不再使用这个文件
+        ::close(fd);
+        fd = -1;
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    failed = !ok;
+    if (!ok) {
+        batch.insert(batch.end(), pending.begin(), pending.end());
+        pending.swap(batch);
+        writtenBytes = start;
+    }
+    return ok;
+}
+
+void WriteAheadLog::flusherLoop() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (!stopping) {
+        wake.wait_for(lock, std::chrono::milliseconds(syncIntervalMs));
+        lock.unlock();
+        sync();
+        lock.lock();
+    }
+}
+
+bool WriteAheadLog::appendPut(const Student& student) {
+    std::vector<char> payload;
+    put<uint8_t>(payload, OP_PUT);
+    putStudent(payload, student);
+    return append(payload);
+}
+
+bool WriteAheadLog::appendUpdate(int oldId, const Student& student) {
+    std::vector<char> payload;
+    put<uint8_t>(payload, OP_UPDATE);
+    put<int32_t>(payload, oldId);
+    putStudent(payload, student);
+    return append(payload);
+}
+
+bool WriteAheadLog::appendDelete(int id) {
+    std::vector<char> payload;
+    put<uint8_t>(payload, OP_DELETE);
+    put<int32_t>(payload, id);
+    return append(payload);
+}
+
+bool WriteAheadLog::appendClear() {
+    std::vector<char> payload;
+    put<uint8_t>(payload, OP_CLEAR);
+    return append(payload);
+}
+
+bool WriteAheadLog::appendSortOrder(int key) {
+    std::vector<char> payload;
+    put<uint8_t>(payload, OP_SORT);
+    put<int32_t>(payload, key);
+    return append(payload);
+}
+
+bool WriteAheadLog::sync() {
+    std::lock_guard<std::mutex> io(ioMutex);
+    return flushHeld();
+}
+
+bool WriteAheadLog::hasFailed() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return failed;
+}
+
+uint64_t WriteAheadLog::size() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return writtenBytes + pending.size();
+}
+
+bool WriteAheadLog::rotate(const std::string& sealedPath) {
+    std::lock_guard<std::mutex> io(ioMutex);
+    if (!flushHeld()) {
+        return false;
+    }
+    ::close(fd);
+    fd = -1;
+    std::lock_guard<std::mutex> lock(mutex);
+    if (std::rename(path.c_str(), sealedPath.c_str()) != 0) {
+        // 没有改名成功，继续追加到原来的日志
+        fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+        failed = (fd < 0);
+        return false;
+    }
+    // 改名与重新打开之间到达的记录留在缓冲区中，写入新日志
+    fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_TRUNC, 0644);
+    writtenBytes = 0;
+    failed = (fd < 0);
+    return !failed;
+}
+
+bool WriteAheadLog::reset() {
+    std::lock_guard<std::mutex> io(ioMutex);
+    std::lock_guard<std::mutex> lock(mutex);
+    pending.clear();
+    writtenBytes = 0;
+    // 调用方已把全部数据写进新快照，缓冲区中失败的记录也不再需要
+    if (fd < 0) {
+        fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+    }
+    failed = fd < 0 || ftruncate(fd, 0) != 0;
+    return !failed;
+}
+
+uint64_t WriteAheadLog::replay(const std::string& path, WalApplier& applier, size_t& records) {
+    records = 0;
+    MappedFile file;
+    if (!file.open(path) || file.size() == 0) {
+        return 0;
+    }
+
+    const char* p = file.begin();
+    const char* end = file.end();
+    while (static_cast<size_t>(end - p) >= RECORD_HEADER) {
+        uint32_t length;
+        uint64_t expected;
+        std::memcpy(&length, p, sizeof(length));
+        std::memcpy(&expected, p + sizeof(length), sizeof(expected));
+        const char* payload = p + RECORD_HEADER;
+        if (length == 0 || static_cast<size_t>(end - payload) < length ||
+            BinarySnapshot::checksum(payload, length) != expected) {
+            break;
+        }
+
+        Reader reader(payload, payload + length);
+        uint8_t op = reader.get<uint8_t>();
+        if (op == OP_PUT) {
+            Student student = reader.getStudent();
+            if (!reader.ok || !reader.atEnd()) break;
+            applier.applyPut(student);
+        } else if (op == OP_UPDATE) {
+            int oldId = reader.get<int32_t>();
+            Student student = reader.getStudent();
+            if (!reader.ok || !reader.atEnd()) break;
+            applier.applyUpdate(oldId, student);
+        } else if (op == OP_DELETE) {
+            int id = reader.get<int32_t>();
+            if (!reader.ok || !reader.atEnd()) break;
+            applier.applyDelete(id);
+        } else if (op == OP_CLEAR) {
+            if (!reader.atEnd()) break;
+            applier.applyClear();
+        } else if (op == OP_SORT) {
+            int key = reader.get<int32_t>();
+            if (!reader.ok || !reader.atEnd()) break;
+            applier.applySortOrder(key);
+        } else {
+            break;
+        }
+        ++records;
+        p = payload + length;
+    }
+    return static_cast<uint64_t>(p - file.begin());
+}
@@ -0,0 +1,78 @@
+#ifndef WRITEAHEADLOG_H
+#define WRITEAHEADLOG_H
+
+#include "Student.h"
+#include <string>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <stdint.h>
+
+// 日志重放时接收各条记录
+class WalApplier {
+public:
+    virtual ~WalApplier() {}
+    virtual void applyPut(const Student& student) = 0;              // 插入或覆盖
+    virtual void applyUpdate(int oldId, const Student& student) = 0; // 删除 oldId 后插入或覆盖
+    virtual void applyDelete(int id) = 0;                           // 删除（不存在时忽略）
+    virtual void applyClear() = 0;                                  // 清空
+    virtual void applySortOrder(int key) = 0;                       // 切换显示顺序（SortKey 的取值）
+};
+
+// 追加写的预写日志（WAL）
+//
+// 每条记录为：uint32_t 负载长度 + uint64_t 校验和 + 负载。
+// 记录都是“按学号覆盖”语义，重放已经包含在快照中的日志不会改变结果，
+// 因此检查点只需保证“先写新快照、再删旧日志”的顺序。
+//
+// 组提交：追加的记录先进入内存缓冲区，由后台线程每隔 syncIntervalMs 毫秒
+// 统一写入并 fsync 一次；syncIntervalMs 为 0 时每条记录都同步写盘。
+// 写盘失败（磁盘满、I/O 错误）时截掉写了一半的部分，这批记录放回缓冲区，下次写盘时重试，不会丢弃
+class WriteAheadLog {
+private:
+    std::string path;                  // 日志文件路径
+    unsigned syncIntervalMs;           // 组提交间隔
+    int fd;                            // 日志文件描述符
+    uint64_t writtenBytes;             // 已写入或正在写入文件的字节数
+    std::vector<char> pending;         // 尚未写入文件的记录
+    bool failed;                       // 最近一次写盘失败（失败的记录仍在缓冲区中），写盘成功或清空后复位
+
+    std::mutex ioMutex;                // 串行化文件写入、fsync 与改名
+    std::mutex mutex;                  // 保护缓冲区与计数，写盘期间不持有
+    std::condition_variable wake;      // 通知后台线程
+    std::thread flusher;               // 组提交线程
+    bool stopping;
+
+    WriteAheadLog(const WriteAheadLog&);
+    WriteAheadLog& operator=(const WriteAheadLog&);
+
+    bool append(const std::vector<char>& payload);
+    bool flushHeld();                  // 写入缓冲区并 fsync，调用方持有 ioMutex
+    void flusherLoop();
+
+public:
+    WriteAheadLog(const std::string& path, unsigned syncIntervalMs);
+    ~WriteAheadLog();                  // 写入剩余记录后关闭
+
+    bool open(uint64_t validBytes);    // 打开日志并截掉 validBytes 之后的残缺记录
+
+    // 追加一条记录。同步模式下返回这条记录是否已写盘；组提交模式下返回日志是否正常（最近一次写盘没有失败）。
+    // 返回 false 时记录仍保留在缓冲区中，之后写盘成功即补上
+    bool appendPut(const Student& student);
+    bool appendUpdate(int oldId, const Student& student);
+    bool appendDelete(int id);
+    bool appendClear();
+    bool appendSortOrder(int key);     // 显示顺序决定数据文件中的行序，记一条很小的记录，不必为此写检查点
+
+    bool sync();                       // 立即写入并 fsync，缓冲区中的全部记录都已写盘时返回 true
+    bool hasFailed();                  // 最近一次写盘是否失败
+    uint64_t size();                   // 日志总字节数（含未写入部分）
+    bool rotate(const std::string& sealedPath); // 写盘后改名为 sealedPath，并从空日志重新开始
+    bool reset();                      // 清空日志
+
+    // 重放日志文件，返回完整记录的字节数；遇到残缺或损坏的记录即停止
+    static uint64_t replay(const std::string& path, WalApplier& applier, size_t& records);
+};
+
+#endif // WRITEAHEADLOG_H
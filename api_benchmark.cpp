@@ -0,0 +1,443 @@
+#include "StudentManager.h"
+#include "ThreadPool.h"
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <string>
+#include <random>
+#include <chrono>
+#include <algorithm>
+#include <cstdlib>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+
+// 公开接口的性能回归测试：用合成的学生名册逐项测量 StudentManager 的公开操作，
+// 计时方式与 Google Benchmark 相同（重复执行直到累计时间足够长），结果可输出为 JSON 以便对比不同版本。
+// 用法：./student_api_bench [选项] [记录数 ...]，默认 1K、10K、100K、1M、10M 条记录
+//   --json FILE         把结果写入 FILE（JSON）
+//   --majors K          专业个数（默认 20）
+//   --name-chars A:B    姓名长度在 A 到 B 个字符之间均匀分布（默认 2:4）
+//   --ascii             使用 ASCII 姓名与专业名（默认使用中文，即 UTF-8 多字节字符）
+//   --min-time SEC      每项测量的最短累计时间（默认 0.2 秒）
+//   --filter TEXT       只运行名称包含 TEXT 的测量项
+//   --load-threads N    加载文件时的解析线程数（默认 1）
+//   --seed S            名册的随机种子（默认 42）
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+double elapsedSeconds(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+// ========== 合成名册 ==========
+
+struct RosterOptions {
+    size_t majors;                     // 专业个数
+    size_t minNameChars;               // 姓名最少字符数
+    size_t maxNameChars;               // 姓名最多字符数
+    bool utf8;                         // 中文姓名与专业名
+    unsigned seed;
+
+    RosterOptions() : majors(20), minNameChars(2), maxNameChars(4), utf8(true), seed(42) {}
+};
+
+const char* const SURNAMES[] = { "张", "李", "王", "刘", "陈", "杨", "赵", "黄", "周", "吴",
+                                 "徐", "孙", "胡", "朱", "高", "林", "何", "郭", "马", "罗" };
+
+void appendUtf8(std::string& out, uint32_t cp) {
+    if (cp < 0x80) {
+        out += static_cast<char>(cp);
+    } else if (cp < 0x800) {
+        out += static_cast<char>(0xC0 | (cp >> 6));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+    } else {
+        out += static_cast<char>(0xE0 | (cp >> 12));
+        out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+    }
+}
+
+std::string majorName(size_t index, const RosterOptions& options) {
+    char number[16];
+    std::snprintf(number, sizeof(number), "%03u", static_cast<unsigned>(index));
+    return (options.utf8 ? "专业" : "Major") + std::string(number);
+}
+
+// 中文姓名：常见姓氏加若干个常用汉字（取 U+4E00 起的 3000 个字，3 字节 UTF-8）；
+// ASCII 姓名：首字母大写的随机字母
+std::string makeName(std::mt19937& rng, const RosterOptions& options) {
+    size_t span = options.maxNameChars - options.minNameChars + 1;
+    size_t chars = options.minNameChars + rng() % span;
+    std::string name;
+    if (options.utf8) {
+        name = SURNAMES[rng() % (sizeof(SURNAMES) / sizeof(SURNAMES[0]))];
+        for (size_t i = 1; i < chars; ++i) {
+            appendUtf8(name, 0x4E00 + rng() % 3000);
+        }
+    } else {
+        for (size_t i = 0; i < chars; ++i) {
+            name += static_cast<char>((i == 0 ? 'A' : 'a') + rng() % 26);
+        }
+    }
+    return name;
+}
+
+// 学号为 20000000 起的连续整数，按随机顺序排列
+std::vector<Student> generateRoster(size_t n, const RosterOptions& options) {
+    std::mt19937 rng(options.seed);
+    std::vector<std::string> majors;
+    for (size_t i = 0; i < options.majors; ++i) {
+        majors.push_back(majorName(i, options));
+    }
+    const char* male = options.utf8 ? "男" : "M";
+    const char* female = options.utf8 ? "女" : "F";
+
+    std::vector<Student> roster;
+    roster.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        roster.push_back(Student(20000000 + static_cast<int>(i), makeName(rng, options), 18 + static_cast<int>(rng() % 8),
+                                 (rng() % 2) ? male : female, majors[rng() % majors.size()], (rng() % 401) / 100.0));
+    }
+    std::shuffle(roster.begin(), roster.end(), rng);
+    return roster;
+}
+
+// 姓名中的前 2 个字符（UTF-8 按字符计），作为搜索关键字
+std::string namePrefix(const std::string& name, size_t chars) {
+    size_t end = 0;
+    for (size_t i = 0; i < chars && end < name.size(); ++i) {
+        unsigned char lead = static_cast<unsigned char>(name[end]);
+        end += lead < 0x80 ? 1 : (lead >> 5) == 0x6 ? 2 : (lead >> 4) == 0xE ? 3 : 4;
+    }
+    return name.substr(0, std::min(end, name.size()));
+}
+
+// ========== 计时 ==========
+
+struct Measurement {
+    std::string family;                // 操作名，如 findStudent
+    size_t students;                   // 名册大小
+    size_t iterations;                 // 执行的操作次数
+    double seconds;                    // 总耗时
+};
+
+class Suite {
+private:
+    double minTime;
+    std::string filter;
+    std::vector<Measurement> results;
+
+    void report(const Measurement& m) {
+        results.push_back(m);
+        double perOp = m.seconds / m.iterations;
+        std::ostringstream text;
+        text << std::left << std::setw(32) << (m.family + "/" + std::to_string(m.students)) << std::right
+             << std::fixed << std::setprecision(1) << std::setw(16) << perOp * 1e9 << " ns"
+             << std::setw(14) << m.iterations << " 次"
+             << std::setw(16) << std::setprecision(1) << m.iterations / m.seconds << " 次/s\n";
+        std::cout << text.str() << std::flush;
+    }
+
+public:
+    Suite(double minTime, const std::string& filter) : minTime(minTime), filter(filter) {}
+
+    bool enabled(const std::string& family) const {
+        return filter.empty() || family.find(filter) != std::string::npos;
+    }
+
+    // 重复执行 body(i)（i 从 0 递增），每轮次数按上一轮的耗时放大，直到一轮的耗时不少于 minTime
+    template <typename Body>
+    void run(const std::string& family, size_t students, Body body) {
+        if (!enabled(family)) {
+            return;
+        }
+        size_t iterations = 1;
+        for (;;) {
+            Clock::time_point start = Clock::now();
+            for (size_t i = 0; i < iterations; ++i) {
+                body(i);
+            }
+            double seconds = elapsedSeconds(start);
+            if (seconds >= minTime || iterations >= 1000000000) {
+                Measurement m = { family, students, iterations, seconds };
+                report(m);
+                return;
+            }
+            double scale = seconds > 0.0 ? minTime * 1.4 / seconds : 10.0;
+            iterations = static_cast<size_t>(iterations * std::min(10.0, std::max(scale, 2.0)));
+        }
+    }
+
+    // 只能执行一次的操作（如向空表插入整个名册），iterations 为其中包含的操作数
+    void record(const std::string& family, size_t students, size_t iterations, double seconds) {
+        Measurement m = { family, students, std::max<size_t>(iterations, 1), seconds };
+        report(m);
+    }
+
+    const std::vector<Measurement>& measurements() const { return results; }
+};
+
+// ========== 测量项 ==========
+
+// 对一个名册大小运行全部测量。顺序有讲究：搜索在切换显示顺序之前（结果按存储顺序），
+// 排序在任何有序索引建立之前测冷启动，删除放在最后
+void runSuite(Suite& suite, size_t n, const RosterOptions& roster, unsigned loadThreads) {
+    std::vector<Student> students = generateRoster(n, roster);
+    std::string textPath = "api_bench_" + std::to_string(n) + ".txt";
+    std::string snapshotPath = "api_bench_" + std::to_string(n) + ".bin";
+    std::remove(textPath.c_str());
+    std::remove(snapshotPath.c_str());
+
+    ManagerOptions options;
+    options.writeAheadLog = false;
+    options.messages = nullptr;
+    options.loadThreads = loadThreads;
+    std::ostream discard(nullptr);
+    std::mt19937 rng(roster.seed + 1);
+    {
+        StudentManager manager(textPath, options);
+
+        // 插入：向空表逐个 addStudent
+        Clock::time_point start = Clock::now();
+        for (size_t i = 0; i < n; ++i) {
+            manager.addStudent(students[i]);
+        }
+        if (suite.enabled("addStudent")) {
+            suite.record("addStudent", n, n, elapsedSeconds(start));
+        }
+
+        // 学号查找：命中与未命中
+        std::vector<int> ids(n);
+        for (size_t i = 0; i < n; ++i) {
+            ids[i] = students[(i * 7919) % n].getId();
+        }
+        volatile size_t sink = 0;
+        suite.run("findStudent", n, [&](size_t i) {
+            sink += manager.findStudent(ids[i % n]) ? 1 : 0;
+        });
+        suite.run("findStudent/miss", n, [&](size_t i) {
+            sink += manager.findStudent(10000000 + static_cast<int>(i % n)) ? 1 : 0;
+        });
+
+        // 姓名搜索：关键字为随机学生姓名的前 2 个字；第一次搜索时建立姓名索引
+        std::vector<std::string> nameQueries;
+        for (size_t i = 0; i < 1024; ++i) {
+            nameQueries.push_back(namePrefix(students[rng() % n].getName(), 2));
+        }
+        if (suite.enabled("searchByName")) {
+            start = Clock::now();
+            sink += manager.searchByName(nameQueries[0]).size();
+            suite.record("searchByName/cold", n, 1, elapsedSeconds(start));
+        }
+        suite.run("searchByName", n, [&](size_t i) {
+            sink += manager.searchByName(nameQueries[i % nameQueries.size()]).size();
+        });
+
+        // 专业搜索：返回该专业的全部学生（约 n / 专业数 条）
+        std::vector<std::string> majors;
+        for (size_t i = 0; i < roster.majors; ++i) {
+            majors.push_back(majorName(i, roster));
+        }
+        suite.run("searchByMajor", n, [&](size_t i) {
+            sink += manager.searchByMajor(majors[i % majors.size()]).size();
+        });
+
+        suite.run("getStatistics", n, [&](size_t) {
+            manager.getStatistics(discard);
+        });
+
+        // 排序：第一次调用会建立有序索引（冷），之后的调用直接按索引输出（热）。都取出完整列表
+        const char* const SORTS[] = { "sortById", "sortByName", "sortByGpa" };
+        for (size_t s = 0; s < 3; ++s) {
+            std::string family = SORTS[s];
+            if (!suite.enabled(family)) continue;
+            auto sortAndList = [&](size_t) {
+                if (s == 0) manager.sortById();
+                else if (s == 1) manager.sortByName();
+                else manager.sortByGpa();
+                sink += manager.getAllStudents().size();
+            };
+            start = Clock::now();
+            sortAndList(0);
+            suite.record(family + "/cold", n, 1, elapsedSeconds(start));
+            suite.run(family, n, sortAndList);
+        }
+
+        // 保存与加载：文本格式与二进制快照各一组
+        suite.run("saveToFile/text", n, [&](size_t) {
+            sink += manager.saveToFile() ? 1 : 0;
+        });
+        suite.run("loadFromFile/text", n, [&](size_t) {
+            sink += manager.loadFromFile() ? 1 : 0;
+        });
+        if (suite.enabled("saveToFile/snapshot") || suite.enabled("loadFromFile/snapshot")) {
+            StudentManager snapshot(snapshotPath, options);
+            snapshot.addStudents(students);
+            suite.run("saveToFile/snapshot", n, [&](size_t) {
+                sink += snapshot.saveToFile() ? 1 : 0;
+            });
+            suite.run("loadFromFile/snapshot", n, [&](size_t) {
+                sink += snapshot.loadFromFile() ? 1 : 0;
+            });
+            snapshot.clearAllStudents();
+        }
+
+        // 删除：按随机顺序删除全部学生（包括期间触发的自动压缩）
+        if (suite.enabled("deleteStudent")) {
+            std::vector<int> order(n);
+            for (size_t i = 0; i < n; ++i) {
+                order[i] = students[i].getId();
+            }
+            std::shuffle(order.begin(), order.end(), rng);
+            start = Clock::now();
+            for (size_t i = 0; i < n; ++i) {
+                manager.deleteStudent(order[i]);
+            }
+            suite.record("deleteStudent", n, n, elapsedSeconds(start));
+        }
+        manager.clearAllStudents();    // 析构时保存的是空表
+    }
+    std::remove(textPath.c_str());
+    std::remove(snapshotPath.c_str());
+}
+
+// ========== JSON 输出 ==========
+
+std::string jsonString(const std::string& text) {
+    std::string out = "\"";
+    for (size_t i = 0; i < text.size(); ++i) {
+        char c = text[i];
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            char escaped[8];
+            std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned>(c));
+            out += escaped;
+        } else {
+            out += c;
+        }
+    }
+    return out + "\"";
+}
+
+// 字段名与 Google Benchmark 的 --benchmark_format=json 输出一致，可以直接用其 compare.py 对比
+bool writeJson(const std::string& path, const std::vector<Measurement>& results,
+               const RosterOptions& roster, unsigned loadThreads) {
+    std::ofstream out(path.c_str());
+    if (!out) {
+        return false;
+    }
+    char date[64];
+    std::time_t now = std::time(nullptr);
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S%z", std::localtime(&now));
+
+    out << "{\n  \"context\": {\n"
+        << "    \"date\": " << jsonString(date) << ",\n"
+        << "    \"executable\": \"student_api_bench\",\n"
+        << "    \"num_cpus\": " << ThreadPool::hardwareThreads() << ",\n"
+        << "    \"library_build_type\": \"release\",\n"
+        << "    \"majors\": " << roster.majors << ",\n"
+        << "    \"name_chars\": [" << roster.minNameChars << ", " << roster.maxNameChars << "],\n"
+        << "    \"utf8_names\": " << (roster.utf8 ? "true" : "false") << ",\n"
+        << "    \"seed\": " << roster.seed << ",\n"
+        << "    \"load_threads\": " << loadThreads << "\n"
+        << "  },\n  \"benchmarks\": [";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const Measurement& m = results[i];
+        std::ostringstream entry;
+        entry.precision(17);
+        std::string name = m.family + "/" + std::to_string(m.students);
+        entry << (i == 0 ? "\n" : ",\n")
+              << "    {\n"
+              << "      \"name\": " << jsonString(name) << ",\n"
+              << "      \"run_name\": " << jsonString(name) << ",\n"
+              << "      \"run_type\": \"iteration\",\n"
+              << "      \"family\": " << jsonString(m.family) << ",\n"
+              << "      \"students\": " << m.students << ",\n"
+              << "      \"iterations\": " << m.iterations << ",\n"
+              << "      \"real_time\": " << m.seconds / m.iterations * 1e9 << ",\n"
+              << "      \"cpu_time\": " << m.seconds / m.iterations * 1e9 << ",\n"
+              << "      \"time_unit\": \"ns\",\n"
+              << "      \"items_per_second\": " << m.iterations / m.seconds << "\n"
+              << "    }";
+        out << entry.str();
+    }
+    out << "\n  ]\n}\n";
+    return static_cast<bool>(out);
+}
+
+bool parseNameChars(const std::string& text, RosterOptions& roster) {
+    size_t colon = text.find(':');
+    if (colon == std::string::npos) {
+        return false;
+    }
+    roster.minNameChars = static_cast<size_t>(std::strtoul(text.substr(0, colon).c_str(), nullptr, 10));
+    roster.maxNameChars = static_cast<size_t>(std::strtoul(text.substr(colon + 1).c_str(), nullptr, 10));
+    return roster.minNameChars >= 1 && roster.minNameChars <= roster.maxNameChars;
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    RosterOptions roster;
+    std::string jsonPath, filter;
+    double minTime = 0.2;
+    unsigned loadThreads = 1;
+    std::vector<size_t> sizes;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--json" && hasValue) {
+            jsonPath = argv[++i];
+        } else if (arg == "--majors" && hasValue) {
+            roster.majors = std::max<size_t>(1, std::strtoul(argv[++i], nullptr, 10));
+        } else if (arg == "--name-chars" && hasValue) {
+            if (!parseNameChars(argv[++i], roster)) {
+                std::cerr << "--name-chars 的格式应为 最少:最多，例如 2:4" << std::endl;
+                return 1;
+            }
+        } else if (arg == "--ascii") {
+            roster.utf8 = false;
+        } else if (arg == "--min-time" && hasValue) {
+            minTime = std::strtod(argv[++i], nullptr);
+        } else if (arg == "--filter" && hasValue) {
+            filter = argv[++i];
+        } else if (arg == "--load-threads" && hasValue) {
+            loadThreads = static_cast<unsigned>(std::max<unsigned long>(1, std::strtoul(argv[++i], nullptr, 10)));
+        } else if (arg == "--seed" && hasValue) {
+            roster.seed = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (!arg.empty() && arg[0] != '-') {
+            sizes.push_back(static_cast<size_t>(std::strtoul(arg.c_str(), nullptr, 10)));
+        } else {
+            std::cerr << "未知参数：" << arg << std::endl;
+            return 1;
+        }
+    }
+    if (sizes.empty()) {
+        const size_t DEFAULT_SIZES[] = { 1000, 10000, 100000, 1000000, 10000000 };
+        sizes.assign(DEFAULT_SIZES, DEFAULT_SIZES + sizeof(DEFAULT_SIZES) / sizeof(DEFAULT_SIZES[0]));
+    }
+
+    Suite suite(minTime, filter);
+    for (size_t i = 0; i < sizes.size(); ++i) {
+        if (sizes[i] == 0) continue;
+        std::cout << "========== " << sizes[i] << " 名学生 ==========" << std::endl;
+        runSuite(suite, sizes[i], roster, loadThreads);
+    }
+
+    if (!jsonPath.empty()) {
+        if (!writeJson(jsonPath, suite.measurements(), roster, loadThreads)) {
+            std::cerr << "无法写入 " << jsonPath << std::endl;
+            return 1;
+        }
+        std::cout << "结果已写入 " << jsonPath << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,1165 @@
+#include "StudentManager.h"
+#include "ThreadPool.h"
+#include "GpaKernels.h"
+#include "ConcurrentStudentManager.h"
+#include "ShardedStudentManager.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <random>
+#include <chrono>
+#include <cstdlib>
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <cstdio>
+#include <limits>
+#include <thread>
+#include <malloc.h>
+
+// 性能基准测试
+// 用法：./student_bench [记录数 ...]，默认测试 10K、1M、10M 条记录
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+double elapsedSeconds(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+// 在作用域内屏蔽 std::cout 输出（addStudent 等操作会打印提示信息）
+class ScopedSilence {
+private:
+    std::streambuf* saved;
+
+public:
+    ScopedSilence() : saved(std::cout.rdbuf(nullptr)) {}
+    ~ScopedSilence() {
+        std::cout.rdbuf(saved);
+        std::cout.clear();
+    }
+};
+
+// 当前已分配的堆内存字节数（含分配器的块头开销）；不支持时返回 0
+size_t heapBytesInUse() {
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+    struct mallinfo2 info = mallinfo2();
+    return info.uordblks + info.hblkhd;
+#else
+    return 0;
+#endif
+}
+
+const char* const MAJORS[] = { "计算机科学", "软件工程", "数据科学", "数学", "物理" };
+const char* const SURNAMES[] = { "张", "李", "王", "赵", "钱", "孙", "周", "吴" };
+
+Student makeStudent(int id, std::mt19937& rng) {
+    std::string name = SURNAMES[rng() % 8];
+    name += "同学";
+    return Student(id, name, 18 + static_cast<int>(rng() % 8), (rng() % 2) ? "男" : "女",
+                   MAJORS[rng() % 5], (rng() % 401) / 100.0);
+}
+
+// 学号查找：命中与未命中各测一组随机学号
+void benchLookup(size_t n) {
+    const int BASE_ID = 20000000;
+    const size_t QUERIES = 1000000;
+    std::mt19937 rng(42);
+
+    StudentManager manager("");
+    Clock::time_point start = Clock::now();
+    {
+        ScopedSilence silence;
+        for (size_t i = 0; i < n; ++i) {
+            manager.addStudent(makeStudent(BASE_ID + static_cast<int>(i), rng));
+        }
+    }
+    double loadTime = elapsedSeconds(start);
+
+    std::vector<int> hits(QUERIES), misses(QUERIES);
+    for (size_t i = 0; i < QUERIES; ++i) {
+        hits[i] = BASE_ID + static_cast<int>(rng() % n);
+        misses[i] = BASE_ID + static_cast<int>(n + rng() % n);
+    }
+
+    size_t found = 0;
+    start = Clock::now();
+    for (size_t i = 0; i < QUERIES; ++i) {
+        found += manager.findStudent(hits[i]) ? 1 : 0;
+    }
+    double hitTime = elapsedSeconds(start);
+
+    start = Clock::now();
+    for (size_t i = 0; i < QUERIES; ++i) {
+        found += manager.findStudent(misses[i]) ? 1 : 0;
+    }
+    double missTime = elapsedSeconds(start);
+
+    std::cout << std::setw(10) << n
+              << " | 插入 " << std::fixed << std::setprecision(3) << loadTime << " s"
+              << " | 命中查找 " << std::setprecision(1) << hitTime * 1e9 / QUERIES << " ns/次"
+              << " | 未命中查找 " << missTime * 1e9 / QUERIES << " ns/次"
+              << " | 命中数 " << found << std::endl;
+}
+
+// 批量删除：随机删除 10% 的学生（模拟学期末集中退学）
+void benchDelete(size_t n) {
+    const int BASE_ID = 20000000;
+    std::mt19937 rng(7);
+
+    StudentManager manager("");
+    std::vector<int> ids(n);
+    {
+        ScopedSilence silence;
+        for (size_t i = 0; i < n; ++i) {
+            ids[i] = BASE_ID + static_cast<int>(i);
+            manager.addStudent(makeStudent(ids[i], rng));
+        }
+    }
+    std::shuffle(ids.begin(), ids.end(), rng);
+
+    size_t deletions = n / 10;
+    Clock::time_point start = Clock::now();
+    {
+        ScopedSilence silence;
+        for (size_t i = 0; i < deletions; ++i) {
+            manager.deleteStudent(ids[i]);
+        }
+    }
+    double deleteTime = elapsedSeconds(start);
+
+    start = Clock::now();
+    size_t deadSlots = manager.getDeletedSlots();
+    manager.compact();
+    double compactTime = elapsedSeconds(start);
+
+    std::cout << std::setw(10) << n
+              << " | 删除 " << deletions << " 条 " << std::fixed << std::setprecision(3) << deleteTime << " s"
+              << " (" << std::setprecision(1) << deleteTime * 1e9 / deletions << " ns/次)"
+              << " | 压缩 " << deadSlots << " 个墓碑 " << std::setprecision(3) << compactTime << " s"
+              << std::endl;
+}
+
+// 旧版 loadFromFile 的实现（每行一个 stringstream + 字段 vector + stoi/stod），作为对比基线
+size_t legacyLoad(const std::string& path, std::vector<Student>& students) {
+    std::ifstream file(path.c_str());
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.empty()) continue;
+        std::stringstream ss(line);
+        std::string item;
+        std::vector<std::string> tokens;
+        while (std::getline(ss, item, ',')) {
+            tokens.push_back(item);
+        }
+        if (tokens.size() == 6) {
+            try {
+                students.emplace_back(std::stoi(tokens[0]), tokens[1], std::stoi(tokens[2]),
+                                      tokens[3], tokens[4], std::stod(tokens[5]));
+            } catch (const std::exception&) {
+            }
+        }
+    }
+    return students.size();
+}
+
+// 生成 n 行的 CSV 数据文件，返回文件字节数
+size_t writeRosterFile(const std::string& path, size_t n) {
+    std::mt19937 rng(99);
+    std::ofstream file(path.c_str());
+    for (size_t i = 0; i < n; ++i) {
+        Student s = makeStudent(20000000 + static_cast<int>(i), rng);
+        file << s.getId() << "," << s.getName() << "," << s.getAge() << "," << s.getGender()
+             << "," << s.getMajor() << "," << s.getGpa() << "\n";
+    }
+    return static_cast<size_t>(file.tellp());
+}
+
+// 删除数据文件及其日志
+void removeDataFiles(const std::string& path) {
+    std::remove(path.c_str());
+    std::remove((path + ".wal").c_str());
+    std::remove((path + ".wal.1").c_str());
+}
+
+// 文件加载吞吐量：旧实现 vs 内存映射解析
+void benchLoad(size_t n) {
+    const std::string path = "bench_roster.txt";
+    size_t bytes = writeRosterFile(path, n);
+    double megabytes = bytes / (1024.0 * 1024.0);
+
+    Clock::time_point start = Clock::now();
+    std::vector<Student> legacy;
+    size_t legacyRows = legacyLoad(path, legacy);
+    double legacyTime = elapsedSeconds(start);
+
+    size_t rows = 0;
+    double loadTime = 0.0;
+    {
+        // 构造函数会加载文件；没有修改时析构不会重写数据文件
+        start = Clock::now();
+        StudentManager manager(path);
+        loadTime = elapsedSeconds(start);
+        rows = manager.getLastLoadReport().loadedRows;
+    }
+    removeDataFiles(path);
+
+    std::cout << std::setw(10) << n
+              << " | " << std::fixed << std::setprecision(1) << megabytes << " MB"
+              << " | 旧实现 " << std::setprecision(3) << legacyTime << " s ("
+              << std::setprecision(0) << megabytes / legacyTime << " MB/s, " << legacyRows << " 行)"
+              << " | 内存映射 " << std::setprecision(3) << loadTime << " s ("
+              << std::setprecision(0) << megabytes / loadTime << " MB/s, " << rows << " 行)"
+              << std::endl;
+}
+
+// 多线程分块加载与单线程加载对比
+void benchParallelLoad(size_t n) {
+    const std::string path = "bench_roster.txt";
+    writeRosterFile(path, n);
+
+    static const unsigned THREADS[] = { 1, 2, 4, 8, 16 };
+    double baseline = 0.0;
+    std::cout << std::setw(10) << n;
+    for (size_t i = 0; i < sizeof(THREADS) / sizeof(THREADS[0]); ++i) {
+        ManagerOptions options;
+        options.loadThreads = THREADS[i];
+        Clock::time_point start = Clock::now();
+        StudentManager manager(path, options);
+        double loadTime = elapsedSeconds(start);
+        if (i == 0) {
+            baseline = loadTime;
+        }
+        std::cout << " | " << THREADS[i] << " 线程 " << std::fixed << std::setprecision(3) << loadTime
+                  << " s (x" << std::setprecision(2) << baseline / loadTime << ")";
+    }
+    std::cout << std::endl;
+    removeDataFiles(path);
+}
+
+// 重启加载时间：文本格式 vs 二进制快照
+void benchSnapshot(size_t n) {
+    const std::string textPath = "bench_roster.txt";
+    const std::string snapPath = "bench_roster.snap";
+    std::mt19937 rng(5);
+    {
+        StudentManager manager("");
+        ScopedSilence silence;
+        for (size_t i = 0; i < n; ++i) {
+            manager.addStudent(makeStudent(20000000 + static_cast<int>(i), rng));
+        }
+        manager.exportTo(textPath);
+        manager.exportTo(snapPath);
+    }
+
+    Clock::time_point start = Clock::now();
+    double textTime = 0.0, snapTime = 0.0;
+    size_t textBytes = 0, snapBytes = 0;
+    {
+        StudentManager manager(textPath);
+        textTime = elapsedSeconds(start);
+        textBytes = manager.getLastLoadReport().bytesRead;
+    }
+    start = Clock::now();
+    {
+        StudentManager manager(snapPath);
+        snapTime = elapsedSeconds(start);
+        snapBytes = manager.getLastLoadReport().bytesRead;
+    }
+    removeDataFiles(textPath);
+    removeDataFiles(snapPath);
+
+    std::cout << std::setw(10) << n
+              << " | 文本 " << std::fixed << std::setprecision(1) << textBytes / 1048576.0 << " MB "
+              << std::setprecision(3) << textTime << " s"
+              << " | 快照 " << std::setprecision(1) << snapBytes / 1048576.0 << " MB "
+              << std::setprecision(3) << snapTime << " s"
+              << " | 加速 x" << std::setprecision(2) << textTime / snapTime << std::endl;
+}
+
+// 内存占用与清空时间：原来的 Student 数组（每个学生 3 个 std::string）vs 列式表（姓名在字符串池中）。
+// 短姓名在 std::string 的内联缓冲区内（不单独分配），长姓名（如外文全名）每个都要一次堆分配
+void benchMemory(size_t n) {
+    for (int longNames = 0; longNames < 2; ++longNames) {
+        std::mt19937 rng(31);
+        std::vector<Student> source;
+        source.reserve(n);
+        for (size_t i = 0; i < n; ++i) {
+            Student s = makeStudent(20000000 + static_cast<int>(i), rng);
+            if (longNames) {
+                s.setName(s.getName() + " Alexander-Maximilian " + std::to_string(i % 1000));
+            }
+            source.push_back(s);
+        }
+
+        size_t before = heapBytesInUse();
+        std::vector<Student>* rows = new std::vector<Student>(source);
+        size_t aosBytes = heapBytesInUse() - before;
+        Clock::time_point start = Clock::now();
+        delete rows;
+        double aosClear = elapsedSeconds(start);
+
+        before = heapBytesInUse();
+        StudentTable* table = new StudentTable();
+        table->reserve(n);
+        for (size_t i = 0; i < n; ++i) {
+            table->append(source[i]);
+        }
+        size_t tableBytes = heapBytesInUse() - before;
+        start = Clock::now();
+        table->clear();
+        double tableClear = elapsedSeconds(start);
+        delete table;
+
+        std::cout << std::setw(10) << n << (longNames ? " 长姓名" : " 短姓名") << std::fixed
+                  << " | Student 数组 " << std::setprecision(1) << aosBytes / static_cast<double>(n) << " B/行"
+                  << " 清空 " << std::setprecision(3) << aosClear * 1e3 << " ms"
+                  << " | 列式表 " << std::setprecision(1) << tableBytes / static_cast<double>(n) << " B/行"
+                  << " 清空 " << std::setprecision(3) << tableClear * 1e3 << " ms"
+                  << " | 内存 x" << std::setprecision(2) << aosBytes / static_cast<double>(tableBytes) << std::endl;
+    }
+}
+
+// 绩点聚合：原来的 Student 数组（AoS）整表扫描 vs 增量维护的统计量。
+// 另列出删除最高绩点学生后第一次读取的时间（最值缓存失效，需要扫描一次）
+void benchGpaScan(size_t n) {
+    std::mt19937 rng(11);
+    std::vector<Student> rows;
+    std::vector<char> alive(n, 1);
+    rows.reserve(n);
+    StudentManager manager("");
+    {
+        ScopedSilence silence;
+        for (size_t i = 0; i < n; ++i) {
+            rows.push_back(makeStudent(20000000 + static_cast<int>(i), rng));
+            manager.addStudent(rows.back());
+        }
+    }
+
+    // 重复多轮，使小数据量的计时也足够稳定
+    const size_t rounds = std::max<size_t>(1, 50000000 / n);
+    volatile double sink = 0.0;        // 防止编译器省略扫描
+    Clock::time_point start = Clock::now();
+    for (size_t r = 0; r < rounds; ++r) {
+        // 与改动前的 getAverageGpa + getStatistics 相同的访问方式
+        double total = 0.0;
+        const Student* maxGpa = nullptr;
+        const Student* minGpa = nullptr;
+        for (size_t i = 0; i < rows.size(); ++i) {
+            if (!alive[i]) continue;
+            total += rows[i].getGpa();
+            if (maxGpa == nullptr || maxGpa->getGpa() < rows[i].getGpa()) maxGpa = &rows[i];
+            if (minGpa == nullptr || rows[i].getGpa() < minGpa->getGpa()) minGpa = &rows[i];
+        }
+        sink += total + maxGpa->getGpa() - minGpa->getGpa();
+    }
+    double aosTime = elapsedSeconds(start) / rounds;
+
+    GpaStatistics stats = manager.getGpaStatistics();
+    {
+        ScopedSilence silence;
+        manager.deleteStudent(stats.highest.getId());
+    }
+    start = Clock::now();
+    stats = manager.getGpaStatistics();
+    double rescanTime = elapsedSeconds(start);
+    sink += stats.highest.getGpa();
+
+    const size_t reads = 1000000;
+    start = Clock::now();
+    for (size_t r = 0; r < reads; ++r) {
+        sink += manager.getAverageGpa();
+        stats = manager.getGpaStatistics();
+        sink += stats.highest.getGpa() - stats.lowest.getGpa();
+    }
+    double incrementalTime = elapsedSeconds(start) / reads;
+
+    std::cout << std::setw(10) << n << std::fixed
+              << " | AoS 扫描 " << std::setprecision(3) << aosTime * 1e3 << " ms"
+              << " | 增量统计 " << std::setprecision(3) << incrementalTime * 1e6 << " us"
+              << " (最值失效后 " << std::setprecision(3) << rescanTime * 1e3 << " ms)"
+              << " | 加速 x" << std::setprecision(0) << aosTime / incrementalTime << std::endl;
+}
+
+// 统计面板刷新：原来的三趟标量扫描 vs 单趟扫描内核（标量 / SSE2 / AVX2）
+void benchGpaKernels(size_t n) {
+    std::mt19937 rng(17);
+    std::vector<double> gpas(n);
+    std::vector<char> alive(n, 1);
+    for (size_t i = 0; i < n; ++i) {
+        gpas[i] = (rng() % 401) / 100.0;
+    }
+    // 删除约 1% 的行：旧方式靠存活标记跳过，内核靠 NaN 跳过
+    for (size_t i = 0; i < n / 100; ++i) {
+        size_t row = rng() % n;
+        alive[row] = 0;
+        gpas[row] = std::numeric_limits<double>::quiet_NaN();
+    }
+
+    const size_t rounds = std::max<size_t>(1, 50000000 / n);
+    volatile double sink = 0.0;
+    Clock::time_point start = Clock::now();
+    for (size_t r = 0; r < rounds; ++r) {
+        double total = 0.0;
+        size_t count = 0;
+        for (size_t i = 0; i < n; ++i) {
+            if (alive[i]) {
+                total += gpas[i];
+                ++count;
+            }
+        }
+        size_t maxRow = n, minRow = n;
+        for (size_t i = 0; i < n; ++i) {
+            if (alive[i] && (maxRow == n || gpas[maxRow] < gpas[i])) maxRow = i;
+        }
+        for (size_t i = 0; i < n; ++i) {
+            if (alive[i] && (minRow == n || gpas[i] < gpas[minRow])) minRow = i;
+        }
+        sink = sink + total / count + gpas[maxRow] - gpas[minRow];
+    }
+    double baseTime = elapsedSeconds(start) / rounds;
+
+    std::cout << std::setw(10) << n << std::fixed
+              << " | 三趟标量 " << std::setprecision(3) << baseTime * 1e3 << " ms";
+    static const GpaKernels::Isa ISAS[] = { GpaKernels::ISA_SCALAR, GpaKernels::ISA_SSE2, GpaKernels::ISA_AVX2 };
+    std::vector<uint64_t> bitmap((n + 63) / 64);
+    for (size_t k = 0; k < 3; ++k) {
+        if (ISAS[k] > GpaKernels::bestIsa()) continue;
+        start = Clock::now();
+        for (size_t r = 0; r < rounds; ++r) {
+            GpaSummary summary;
+            GpaKernels::scanWith(ISAS[k], &gpas[0], n, -std::numeric_limits<double>::infinity(),
+                                 &bitmap[0], summary);
+            sink = sink + summary.sum / summary.count + summary.max - summary.min;
+        }
+        double time = elapsedSeconds(start) / rounds;
+        std::cout << " | " << GpaKernels::isaName(ISAS[k]) << " " << std::setprecision(3) << time * 1e3
+                  << " ms (" << std::setprecision(1) << n * sizeof(double) / time / 1e9 << " GB/s)";
+    }
+    std::cout << std::endl;
+}
+
+// 按专业筛选：逐条比较字符串 vs 比较字典编码
+void benchMajorFilter(size_t n) {
+    std::mt19937 rng(13);
+    std::vector<Student> rows;
+    rows.reserve(n);
+    StudentManager manager("");
+    {
+        ScopedSilence silence;
+        for (size_t i = 0; i < n; ++i) {
+            rows.push_back(makeStudent(20000000 + static_cast<int>(i), rng));
+            manager.addStudent(rows.back());
+        }
+    }
+
+    const std::string major = "数据科学";
+    const size_t rounds = std::max<size_t>(1, 10000000 / n);
+    size_t oldMatches = 0, newMatches = 0;
+    Clock::time_point start = Clock::now();
+    for (size_t r = 0; r < rounds; ++r) {
+        // 与改动前的 searchByMajor 相同
+        std::vector<Student> result;
+        for (size_t i = 0; i < rows.size(); ++i) {
+            if (rows[i].getMajor() == major) {
+                result.push_back(rows[i]);
+            }
+        }
+        oldMatches = result.size();
+    }
+    double oldTime = elapsedSeconds(start) / rounds;
+
+    start = Clock::now();
+    for (size_t r = 0; r < rounds; ++r) {
+        newMatches = manager.searchByMajor(major).size();
+    }
+    double newTime = elapsedSeconds(start) / rounds;
+
+    // 每条记录中性别、专业两个字段占用的字节数（不含超出短字符串缓冲区的堆内存）
+    size_t oldBytes = 2 * sizeof(std::string);
+    size_t newBytes = 2 * sizeof(StringDictionary::Code);
+
+    std::cout << std::setw(10) << n << std::fixed
+              << " | 字符串比较 " << std::setprecision(3) << oldTime * 1e3 << " ms"
+              << " | 字典编码 " << std::setprecision(3) << newTime * 1e3 << " ms"
+              << " | 加速 x" << std::setprecision(2) << oldTime / newTime
+              << " | 匹配 " << oldMatches << "/" << newMatches
+              << " | 性别+专业 " << oldBytes << " -> " << newBytes << " 字节/条" << std::endl;
+}
+
+// 有序索引：旧版每次排序整表 std::sort vs 增量维护的有序索引上的区间查询
+void benchSortedIndexes(size_t n) {
+    std::mt19937 rng(21);
+    std::vector<Student> rows;
+    rows.reserve(n);
+    ManagerOptions options;
+    options.writeAheadLog = false;
+    StudentManager manager("", options);
+    {
+        ScopedSilence silence;
+        for (size_t i = 0; i < n; ++i) {
+            rows.push_back(makeStudent(20000000 + static_cast<int>(i), rng));
+            manager.addStudent(rows.back());
+        }
+    }
+
+    // 与改动前的 sortByGpa 相同：每次请求都整表排序
+    Clock::time_point start = Clock::now();
+    std::sort(rows.begin(), rows.end(),
+        [](const Student& a, const Student& b) {
+            return a.getGpa() > b.getGpa();
+        });
+    double sortTime = elapsedSeconds(start);
+
+    // 第一次使用时建立索引
+    start = Clock::now();
+    {
+        ScopedSilence silence;
+        manager.sortByGpa();
+    }
+    double buildTime = elapsedSeconds(start);
+
+    const size_t QUERIES = 1000;
+    size_t matches = 0;
+    start = Clock::now();
+    for (size_t i = 0; i < QUERIES; ++i) {
+        matches += manager.getTopStudentsByGpa(10).size();
+    }
+    double topTime = elapsedSeconds(start) / QUERIES;
+
+    start = Clock::now();
+    size_t rangeRows = manager.getStudentsByGpaRange(3.5, 3.8).size();
+    double rangeTime = elapsedSeconds(start);
+
+    // 索引建立后的增量维护开销
+    const size_t CHANGES = 10000;
+    start = Clock::now();
+    {
+        ScopedSilence silence;
+        for (size_t i = 0; i < CHANGES; ++i) {
+            int id = 20000000 + static_cast<int>(rng() % n);
+            manager.updateStudent(id, makeStudent(id, rng));
+        }
+    }
+    double updateTime = elapsedSeconds(start) / CHANGES;
+
+    std::cout << std::setw(10) << n << std::fixed
+              << " | 整表排序 " << std::setprecision(3) << sortTime * 1e3 << " ms"
+              << " | 建索引 " << buildTime * 1e3 << " ms"
+              << " | 前 10 名 " << std::setprecision(1) << topTime * 1e6 << " us (" << matches / QUERIES << " 条)"
+              << " | 绩点 [3.5, 3.8] " << std::setprecision(3) << rangeTime * 1e3 << " ms (" << rangeRows << " 条)"
+              << " | 修改 " << std::setprecision(1) << updateTime * 1e6 << " us/次" << std::endl;
+}
+
+// 姓名搜索：旧版逐条 find vs 姓名子串索引（输入联想取前 20 条，统计 p50/p99 延迟）
+void benchNameSearch(size_t n) {
+    std::mt19937 rng(17);
+    ManagerOptions options;
+    options.writeAheadLog = false;
+    StudentManager manager("", options);
+    std::vector<std::string> names;
+    names.reserve(n);
+    {
+        ScopedSilence silence;
+        for (size_t i = 0; i < n; ++i) {
+            Student s = makeStudent(20000000 + static_cast<int>(i), rng);
+            // 姓 + 两位编号，让片段的分布接近真实姓名
+            s.setName(s.getName().substr(0, 3) + std::to_string(rng() % 100));
+            names.push_back(s.getName());
+            manager.addStudent(s);
+        }
+    }
+
+    // 模拟逐字输入：取某个姓名的前 1~3 个字符
+    const size_t QUERIES = 2000;
+    std::vector<std::string> queries(QUERIES);
+    for (size_t i = 0; i < QUERIES; ++i) {
+        const std::string& name = names[rng() % n];
+        queries[i] = name.substr(0, 3 + rng() % 3);
+    }
+
+    // 与改动前的 searchByName 相同（只计匹配，不复制对象）
+    size_t oldRounds = std::max<size_t>(1, std::min<size_t>(QUERIES, 10000000 / n));
+    Clock::time_point start = Clock::now();
+    size_t oldMatches = 0;
+    for (size_t q = 0; q < oldRounds; ++q) {
+        for (size_t i = 0; i < names.size(); ++i) {
+            oldMatches += names[i].find(queries[q]) != std::string::npos ? 1 : 0;
+        }
+    }
+    double oldTime = elapsedSeconds(start) / oldRounds;
+
+    start = Clock::now();
+    manager.searchByName("x", 1);      // 第一次搜索时建立索引
+    double buildTime = elapsedSeconds(start);
+
+    std::vector<double> latencies(QUERIES);
+    size_t matches = 0;
+    for (size_t i = 0; i < QUERIES; ++i) {
+        start = Clock::now();
+        matches += manager.searchByName(queries[i], 20).size();
+        latencies[i] = elapsedSeconds(start);
+    }
+    std::sort(latencies.begin(), latencies.end());
+
+    std::cout << std::setw(10) << n << std::fixed
+              << " | 逐条查找 " << std::setprecision(3) << oldTime * 1e3 << " ms/次"
+              << " | 建索引 " << buildTime * 1e3 << " ms"
+              << " | 索引 p50 " << std::setprecision(1) << latencies[QUERIES / 2] * 1e6 << " us"
+              << " p99 " << latencies[QUERIES * 99 / 100] * 1e6 << " us"
+              << " | 平均结果 " << matches / QUERIES << " 条" << std::endl;
+}
+
+// 并发吞吐量：threads 个线程共执行 OPERATIONS 次操作，writePercent% 为修改，其余为按学号查找
+double concurrentThroughput(ConcurrentStudentManager& manager, size_t n, size_t threads, unsigned writePercent) {
+    const size_t OPERATIONS = 2000000;
+    const int BASE_ID = 20000000;
+    std::vector<std::thread> workers;
+    Clock::time_point start = Clock::now();
+    for (size_t t = 0; t < threads; ++t) {
+        workers.push_back(std::thread([&manager, n, threads, writePercent, t]() {
+            std::mt19937 rng(static_cast<unsigned>(t + 1));
+            Student student;
+            for (size_t i = 0; i < OPERATIONS / threads; ++i) {
+                int id = BASE_ID + static_cast<int>(rng() % n);
+                if (rng() % 100 < writePercent) {
+                    manager.updateStudent(id, makeStudent(id, rng));
+                } else {
+                    manager.findStudent(id, student);
+                }
+            }
+        }));
+    }
+    for (size_t t = 0; t < workers.size(); ++t) {
+        workers[t].join();
+    }
+    return (OPERATIONS / threads) * threads / elapsedSeconds(start);
+}
+
+// 线程安全管理器在 1/4/16/64 个线程下的吞吐量：单把读写锁 vs 按线程分片的读写锁
+void benchConcurrency(size_t n) {
+    std::mt19937 rng(23);
+    ManagerOptions options;
+    options.writeAheadLog = false;
+    ConcurrentStudentManager single("", options, 1);
+    ConcurrentStudentManager sharded("", options, 64);
+    {
+        ScopedSilence silence;
+        for (size_t i = 0; i < n; ++i) {
+            Student s = makeStudent(20000000 + static_cast<int>(i), rng);
+            single.addStudent(s);
+            sharded.addStudent(s);
+        }
+    }
+
+    static const size_t THREADS[] = { 1, 4, 16, 64 };
+    for (size_t k = 0; k < 4; ++k) {
+        double singleRead, shardedRead, shardedMixed;
+        {
+            ScopedSilence silence;
+            singleRead = concurrentThroughput(single, n, THREADS[k], 0);
+            shardedRead = concurrentThroughput(sharded, n, THREADS[k], 0);
+            shardedMixed = concurrentThroughput(sharded, n, THREADS[k], 5);
+        }
+        std::cout << std::setw(10) << n << " | " << std::setw(2) << THREADS[k] << " 线程" << std::fixed
+                  << " | 只读 单锁 " << std::setprecision(2) << singleRead / 1e6 << " M次/s"
+                  << " | 只读 分片锁 " << shardedRead / 1e6 << " M次/s"
+                  << " | 5% 修改 分片锁 " << shardedMixed / 1e6 << " M次/s" << std::endl;
+    }
+}
+
+// 分片管理器：插入、统计与按专业筛选在 1 个分片与 4 个分片下的耗时（分片越多，并行扫描的线程越多）
+void benchSharding(size_t n) {
+    static const size_t SHARDS[] = { 1, 4 };
+    ManagerOptions options;
+    options.writeAheadLog = false;
+    for (size_t k = 0; k < 2; ++k) {
+        std::mt19937 rng(31);
+        ShardedStudentManager manager("", SHARDS[k], options);
+        Clock::time_point start = Clock::now();
+        {
+            ScopedSilence silence;
+            for (size_t i = 0; i < n; ++i) {
+                manager.addStudent(makeStudent(20000000 + static_cast<int>(i), rng));
+            }
+        }
+        double insertTime = elapsedSeconds(start);
+
+        const size_t rounds = std::max<size_t>(1, 10000000 / n);
+        size_t count = 0;
+        start = Clock::now();
+        for (size_t r = 0; r < rounds; ++r) {
+            count += manager.getGpaStatistics().count;
+        }
+        double statsTime = elapsedSeconds(start) / rounds;
+
+        start = Clock::now();
+        size_t matches = manager.searchByMajor("数据科学").size();
+        double majorTime = elapsedSeconds(start);
+
+        start = Clock::now();
+        size_t top = manager.getTopStudentsByGpa(10).size();
+        double topTime = elapsedSeconds(start);
+
+        std::cout << std::setw(10) << n << " | " << SHARDS[k] << " 个分片" << std::fixed
+                  << " | 插入 " << std::setprecision(3) << insertTime << " s"
+                  << " | 统计 " << statsTime * 1e3 << " ms (" << count / rounds << " 人)"
+                  << " | 按专业筛选 " << majorTime * 1e3 << " ms (" << matches << " 条)"
+                  << " | 前 10 名（含建索引） " << topTime * 1e3 << " ms (" << top << " 条)" << std::endl;
+    }
+}
+
+// 批量导入：逐条 addStudent（输出写入内存缓冲区，模拟重定向的控制台）vs addStudents vs importFrom
+void benchImport(size_t n) {
+    std::mt19937 rng(37);
+    std::vector<Student> batch;
+    batch.reserve(n);
+    std::ostringstream feed;
+    for (size_t i = 0; i < n; ++i) {
+        batch.push_back(makeStudent(20000000 + static_cast<int>(i), rng));
+        const Student& s = batch.back();
+        feed << s.getId() << "," << s.getName() << "," << s.getAge() << "," << s.getGender()
+             << "," << s.getMajor() << "," << s.getGpa() << "\n";
+    }
+    // 混入 1% 的重复学号
+    for (size_t i = 0; i < n / 100; ++i) {
+        batch.push_back(batch[rng() % n]);
+    }
+    std::string text = feed.str();
+
+    ManagerOptions options;
+    options.writeAheadLog = false;
+    double loopTime = 0.0;
+    {
+        StudentManager manager("", options);
+        std::ostringstream console;
+        std::streambuf* saved = std::cout.rdbuf(console.rdbuf());
+        Clock::time_point start = Clock::now();
+        for (size_t i = 0; i < batch.size(); ++i) {
+            manager.addStudent(batch[i]);
+        }
+        loopTime = elapsedSeconds(start);
+        std::cout.rdbuf(saved);
+    }
+
+    LoadReport batchReport, streamReport;
+    double batchTime = 0.0, streamTime = 0.0;
+    {
+        StudentManager manager("", options);
+        Clock::time_point start = Clock::now();
+        batchReport = manager.addStudents(batch);
+        batchTime = elapsedSeconds(start);
+    }
+    {
+        StudentManager manager("", options);
+        std::istringstream in(text);
+        Clock::time_point start = Clock::now();
+        streamReport = manager.importFrom(in);
+        streamTime = elapsedSeconds(start);
+    }
+
+    std::cout << std::setw(10) << n << std::fixed
+              << " | 逐条 addStudent " << std::setprecision(3) << loopTime << " s"
+              << " | addStudents " << batchTime << " s (导入 " << batchReport.loadedRows
+              << "，重复 " << batchReport.skipped.size() << ")"
+              << " | importFrom " << streamTime << " s (导入 " << streamReport.loadedRows << ")" << std::endl;
+}
+
+// 把整张学生表输出到文件：旧版逐行 std::setw + std::endl vs StudentFormatter 整块写出
+void benchTableOutput(size_t n) {
+    const std::string path = "bench_table.txt";
+    std::mt19937 rng(41);
+    ManagerOptions options;
+    options.writeAheadLog = false;
+    options.messages = nullptr;
+    StudentManager manager("", options);
+    for (size_t i = 0; i < n; ++i) {
+        manager.addStudent(makeStudent(20000000 + static_cast<int>(i), rng));
+    }
+
+    double oldTime = 0.0;
+    {
+        // 与改动前的 Student::display 相同，每行一次 std::endl
+        std::ofstream file(path.c_str());
+        Clock::time_point start = Clock::now();
+        manager.forEachStudent([&file](const StudentRef& s) {
+            file << "学号: " << std::setw(8) << s.getId()
+                 << " | 姓名: " << std::setw(10) << s.getName()
+                 << " | 年龄: " << std::setw(3) << s.getAge()
+                 << " | 性别: " << std::setw(4) << s.getGender()
+                 << " | 专业: " << std::setw(15) << s.getMajor()
+                 << " | 绩点: " << std::fixed << std::setprecision(2) << s.getGpa() << std::endl;
+        });
+        file.close();
+        oldTime = elapsedSeconds(start);
+    }
+
+    double newTime = 0.0;
+    size_t bytes = 0;
+    {
+        std::ofstream file(path.c_str());
+        Clock::time_point start = Clock::now();
+        manager.displayAllStudents(file);
+        file.close();
+        newTime = elapsedSeconds(start);
+        std::ifstream check(path.c_str(), std::ios::binary | std::ios::ate);
+        bytes = static_cast<size_t>(check.tellg());
+    }
+    std::remove(path.c_str());
+
+    double megabytes = bytes / (1024.0 * 1024.0);
+    std::cout << std::setw(10) << n << std::fixed
+              << " | " << std::setprecision(1) << megabytes << " MB"
+              << " | 逐行 endl " << std::setprecision(3) << oldTime << " s ("
+              << std::setprecision(0) << megabytes / oldTime << " MB/s)"
+              << " | StudentFormatter " << std::setprecision(3) << newTime << " s ("
+              << std::setprecision(0) << megabytes / newTime << " MB/s)" << std::endl;
+}
+
+// 按专业查询：旧版复制出 vector<Student> vs 流式回调 vs 只取一页
+void benchStreamingQuery(size_t n) {
+    std::mt19937 rng(17);
+    ManagerOptions options;
+    options.writeAheadLog = false;
+    options.messages = nullptr;
+    StudentManager manager("", options);
+    for (size_t i = 0; i < n; ++i) {
+        manager.addStudent(makeStudent(20000000 + static_cast<int>(i), rng));
+    }
+
+    const std::string major = "数据科学";
+    const size_t rounds = std::max<size_t>(1, 10000000 / n);
+    size_t copied = 0, streamed = 0, paged = 0;
+    Clock::time_point start = Clock::now();
+    for (size_t r = 0; r < rounds; ++r) {
+        // 与改动前的 searchByMajor 相同：每条匹配记录连同字符串一起复制
+        std::vector<Student> result;
+        manager.forEachStudent([&](const StudentRef& s) {
+            if (s.getMajor() == major) {
+                result.push_back(s.toStudent());
+            }
+        });
+        copied = result.size();
+    }
+    double copyTime = elapsedSeconds(start) / rounds;
+
+    start = Clock::now();
+    for (size_t r = 0; r < rounds; ++r) {
+        double sum = 0.0;
+        streamed = manager.scanByMajor(major, [&sum](const StudentRef& s) {
+            sum += s.getGpa();
+            return true;
+        });
+    }
+    double streamTime = elapsedSeconds(start) / rounds;
+
+    // 结果中间的一页（50 条）
+    QueryPage page(copied / 2, 50);
+    const size_t pageRounds = rounds * 10;
+    start = Clock::now();
+    for (size_t r = 0; r < pageRounds; ++r) {
+        paged = manager.getStudentsByMajor(major, page).size();
+    }
+    double pageTime = elapsedSeconds(start) / pageRounds;
+
+    std::cout << std::setw(10) << n << std::fixed
+              << " | 复制结果 " << std::setprecision(3) << copyTime * 1e3 << " ms (" << copied << " 条, "
+              << std::setprecision(1) << copied * sizeof(Student) / (1024.0 * 1024.0) << " MB+)"
+              << " | 流式回调 " << std::setprecision(3) << streamTime * 1e3 << " ms (" << streamed << " 条)"
+              << " | 中间一页 " << std::setprecision(3) << pageTime * 1e3 << " ms (" << paged << " 条)" << std::endl;
+}
+
+// 组合查询“计算机科学、20~22 岁、绩点 >= 3.5，按绩点取前 100 名”：
+// 旧做法每个条件筛一遍再整体排序 vs 查询引擎（全表扫描 + 堆 / 绩点有序索引上取满即停）
+void benchQuery(size_t n) {
+    std::mt19937 rng(23);
+    ManagerOptions options;
+    options.writeAheadLog = false;
+    options.messages = nullptr;
+    StudentManager manager("", options);
+    for (size_t i = 0; i < n; ++i) {
+        manager.addStudent(makeStudent(20000000 + static_cast<int>(i), rng));
+    }
+
+    const size_t rounds = std::max<size_t>(1, 1000000 / n);
+    size_t oldCount = 0;
+    Clock::time_point start = Clock::now();
+    for (size_t r = 0; r < rounds; ++r) {
+        std::vector<StudentRef> byMajor = manager.getStudentsByMajor("计算机科学"), byAge, byGpa;
+        for (size_t i = 0; i < byMajor.size(); ++i) {
+            if (byMajor[i].getAge() >= 20 && byMajor[i].getAge() <= 22) byAge.push_back(byMajor[i]);
+        }
+        for (size_t i = 0; i < byAge.size(); ++i) {
+            if (byAge[i].getGpa() >= 3.5) byGpa.push_back(byAge[i]);
+        }
+        std::sort(byGpa.begin(), byGpa.end(), [](const StudentRef& a, const StudentRef& b) {
+            return a.getGpa() > b.getGpa();
+        });
+        oldCount = std::min<size_t>(byGpa.size(), 100);
+    }
+    double oldTime = elapsedSeconds(start) / rounds;
+
+    StudentQuery query;
+    query.where(FIELD_MAJOR, OP_EQ, "计算机科学").between(FIELD_AGE, 20, 22).where(FIELD_GPA, OP_GE, 3.5)
+         .orderBy(FIELD_GPA, true).page(0, 100);
+    size_t scanCount = 0;
+    start = Clock::now();
+    for (size_t r = 0; r < rounds; ++r) {
+        scanCount = manager.query(query).rows.size();
+    }
+    double scanTime = elapsedSeconds(start) / rounds;
+
+    manager.getTopStudentsByGpa(1);    // 建立绩点有序索引
+    size_t indexCount = 0;
+    start = Clock::now();
+    for (size_t r = 0; r < rounds * 10; ++r) {
+        indexCount = manager.query(query).rows.size();
+    }
+    double indexTime = elapsedSeconds(start) / (rounds * 10);
+
+    std::cout << std::setw(10) << n << std::fixed << std::setprecision(3)
+              << " | 逐条件筛选+排序 " << oldTime * 1e3 << " ms (" << oldCount << " 条)"
+              << " | 扫描+堆 " << scanTime * 1e3 << " ms (" << scanCount << " 条)"
+              << " | 绩点索引 " << indexTime * 1e3 << " ms (" << indexCount << " 条)" << std::endl;
+}
+
+// 绩点分位数与排名：每次报表都取出全部绩点排序 vs 增量维护的分布上 O(log n) 查询
+void benchPercentiles(size_t n) {
+    std::mt19937 rng(29);
+    ManagerOptions options;
+    options.writeAheadLog = false;
+    options.messages = nullptr;
+    StudentManager manager("", options);
+    for (size_t i = 0; i < n; ++i) {
+        manager.addStudent(makeStudent(20000000 + static_cast<int>(i), rng));
+    }
+
+    const size_t rounds = std::max<size_t>(1, 10000000 / n);
+    volatile double sink = 0.0;
+    Clock::time_point start = Clock::now();
+    for (size_t r = 0; r < rounds; ++r) {
+        std::vector<StudentRef> all = manager.getAllStudents();
+        std::vector<double> gpas;
+        gpas.reserve(all.size());
+        for (size_t i = 0; i < all.size(); ++i) {
+            gpas.push_back(all[i].getGpa());
+        }
+        std::sort(gpas.begin(), gpas.end());
+        sink += gpas[gpas.size() / 10] + gpas[gpas.size() / 2] + gpas[gpas.size() * 9 / 10];
+        double target = manager.findStudent(20000000 + static_cast<int>(r % n)).getGpa();
+        sink += std::lower_bound(gpas.begin(), gpas.end(), target) - gpas.begin();
+    }
+    double sortTime = elapsedSeconds(start) / rounds;
+
+    const size_t queries = 1000000;
+    start = Clock::now();
+    for (size_t r = 0; r < queries; ++r) {
+        sink += manager.getGpaPercentile(10) + manager.getGpaPercentile(50) + manager.getGpaPercentile(90);
+        sink += manager.getGpaPercentileRank(20000000 + static_cast<int>(r % n));
+    }
+    double treeTime = elapsedSeconds(start) / queries;
+
+    std::cout << std::setw(10) << n << std::fixed
+              << " | 排序 " << std::setprecision(3) << sortTime * 1e3 << " ms"
+              << " | 分布查询 " << std::setprecision(3) << treeTime * 1e6 << " us"
+              << " | 加速 x" << std::setprecision(0) << sortTime / treeTime << std::endl;
+}
+
+// 单次修改的持久化开销：追加日志（组提交 / 每次同步）vs 整体重写数据文件
+void benchWal(size_t n) {
+    const std::string path = "bench_roster.txt";
+    writeRosterFile(path, n);
+    const size_t CHANGES = 1000;
+
+    // 每次修改后都调用 saveToFile 整体重写太慢，按重写一次的时间估算
+    double rewriteTime = 0.0;
+    {
+        ManagerOptions options;
+        options.writeAheadLog = false;
+        StudentManager manager(path, options);
+        Clock::time_point start = Clock::now();
+        manager.saveToFile();
+        rewriteTime = elapsedSeconds(start);
+    }
+
+    static const unsigned INTERVALS[] = { 10, 0 };
+    double logTime[2] = { 0.0, 0.0 };
+    std::mt19937 rng(3);
+    for (size_t k = 0; k < 2; ++k) {
+        ManagerOptions options;
+        options.walSyncIntervalMs = INTERVALS[k];
+        {
+            StudentManager manager(path, options);
+            ScopedSilence silence;
+            Clock::time_point start = Clock::now();
+            for (size_t i = 0; i < CHANGES; ++i) {
+                int id = 20000000 + static_cast<int>(rng() % n);
+                manager.updateStudent(id, makeStudent(id, rng));
+            }
+            manager.syncLog();
+            logTime[k] = elapsedSeconds(start);
+        }
+        // 丢弃本轮日志，下一轮从同一份数据文件开始
+        std::remove((path + ".wal").c_str());
+    }
+    removeDataFiles(path);
+
+    std::cout << std::setw(10) << n << std::fixed
+              << " | 整体重写 " << std::setprecision(1) << rewriteTime * 1e6 << " us/次"
+              << " | 日志组提交 " << std::setprecision(1) << logTime[0] / CHANGES * 1e6 << " us/次"
+              << " | 日志逐条同步 " << std::setprecision(1) << logTime[1] / CHANGES * 1e6 << " us/次"
+              << std::endl;
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    std::vector<size_t> sizes;
+    for (int i = 1; i < argc; ++i) {
+        sizes.push_back(static_cast<size_t>(std::strtoul(argv[i], nullptr, 10)));
+    }
+    if (sizes.empty()) {
+        sizes.push_back(10000);
+        sizes.push_back(1000000);
+        sizes.push_back(10000000);
+    }
+
+    std::cout << "========== 学号查找基准测试 ==========" << std::endl;
+    for (size_t i = 0; i < sizes.size(); ++i) {
+        if (sizes[i] > 0) {
+            benchLookup(sizes[i]);
+        }
+    }
+
+    std::cout << "\n========== 批量删除基准测试 ==========" << std::endl;
+    for (size_t i = 0; i < sizes.size(); ++i) {
+        if (sizes[i] >= 10) {
+            benchDelete(sizes[i]);
+        }
+    }
+
+    std::cout << "\n========== 文件加载基准测试 ==========" << std::endl;
+    for (size_t i = 0; i < sizes.size(); ++i) {
+        if (sizes[i] > 0) {
+            benchLoad(sizes[i]);
+        }
+    }
+
+    std::cout << "\n========== 并行加载基准测试（硬件线程数 " << ThreadPool::hardwareThreads()
+              << "） ==========" << std::endl;
+    for (size_t i = 0; i < sizes.size(); ++i) {
+        if (sizes[i] > 0) {
+            benchParallelLoad(sizes[i]);
+        }
+    }
+
+    std::cout << "\n========== 快照格式基准测试 ==========" << std::endl;
+    for (size_t i = 0; i < sizes.size(); ++i) {
+        if (sizes[i] > 0) {
+            benchSnapshot(sizes[i]);
+        }
+    }
+
+    std::cout << "\n========== 内存占用基准测试 ==========" << std::endl;
+    for (size_t i = 0; i < sizes.size(); ++i) {
+        if (sizes[i] > 0) {
+            benchMemory(sizes[i]);
+        }
+    }
+
+    std::cout << "\n========== 绩点聚合基准测试（扫描 vs 增量统计） ==========" << std::endl;
+    for (size_t i = 0; i < sizes.size(); ++i) {
+        if (sizes[i] > 0) {
+            benchGpaScan(sizes[i]);
+        }
+    }
+
+    std::cout << "\n========== 绩点扫描内核基准测试（含筛选位图） ==========" << std::endl;
+    for (size_t i = 0; i < sizes.size(); ++i) {
+        if (sizes[i] > 0) {
+            benchGpaKernels(sizes[i]);
+        }
+    }
+
+    std::cout << "\n========== 按专业筛选基准测试 ==========" << std::endl;
+    for (size_t i = 0; i < sizes.size(); ++i) {
+        if (sizes[i] > 0) {
+            benchMajorFilter(sizes[i]);
+        }
+    }
+
+    std::cout << "\n========== 有序索引基准测试 ==========" << std::endl;
+    for (size_t i = 0; i < sizes.size(); ++i) {
+        if (sizes[i] > 0) {
+            benchSortedIndexes(sizes[i]);
+        }
+    }
+
+    std::cout << "\n========== 姓名搜索基准测试 ==========" << std::endl;
+    for (size_t i = 0; i < sizes.size(); ++i) {
+        if (sizes[i] > 0) {
+            benchNameSearch(sizes[i]);
+        }
+    }
+
+    std::cout << "\n========== 并发读写基准测试（硬件线程数 " << ThreadPool::hardwareThreads()
+              << "） ==========" << std::endl;
+    for (size_t i = 0; i < sizes.size(); ++i) {
+        if (sizes[i] > 0) {
+            benchConcurrency(sizes[i]);
+        }
+    }
+
+    std::cout << "\n========== 分片基准测试（硬件线程数 " << ThreadPool::hardwareThreads()
+              << "） ==========" << std::endl;
+    for (size_t i = 0; i < sizes.size(); ++i) {
+        if (sizes[i] > 0) {
+            benchSharding(sizes[i]);
+        }
+    }
+
+    std::cout << "\n========== 批量导入基准测试 ==========" << std::endl;
+    for (size_t i = 0; i < sizes.size(); ++i) {
+        if (sizes[i] > 0) {
+            benchImport(sizes[i]);
+        }
+    }
+
+    std::cout << "\n========== 学生表输出基准测试 ==========" << std::endl;
+    for (size_t i = 0; i < sizes.size(); ++i) {
+        if (sizes[i] > 0) {
+            benchTableOutput(sizes[i]);
+        }
+    }
+
+    std::cout << "\n========== 流式查询基准测试 ==========" << std::endl;
+    for (size_t i = 0; i < sizes.size(); ++i) {
+        if (sizes[i] > 0) {
+            benchStreamingQuery(sizes[i]);
+        }
+    }
+
+    std::cout << "\n========== 组合查询基准测试 ==========" << std::endl;
+    for (size_t i = 0; i < sizes.size(); ++i) {
+        if (sizes[i] > 0) {
+            benchQuery(sizes[i]);
+        }
+    }
+
+    std::cout << "\n========== 绩点分位数与排名基准测试 ==========" << std::endl;
+    for (size_t i = 0; i < sizes.size(); ++i) {
+        if (sizes[i] > 0) {
+            benchPercentiles(sizes[i]);
+        }
+    }
+
+    std::cout << "\n========== 修改持久化基准测试 ==========" << std::endl;
+    for (size_t i = 0; i < sizes.size(); ++i) {
+        if (sizes[i] > 0) {
+            benchWal(sizes[i]);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,346 @@
+#include "Metrics.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <deque>
+#include <string>
+#include <thread>
+#include <random>
+#include <chrono>
+#include <algorithm>
+#include <cstdlib>
+#include <cstdio>
+#include <cstring>
+#include <cerrno>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+
+// 服务模式（student_manager --serve）的压测客户端：开若干个连接，每个连接一个线程，
+// 始终保持固定数量的请求在途（流水线深度），收到多少条响应就补发多少条请求，
+// 统计吞吐量与每条请求从发出到收到响应的延迟分布。
+// 用法：./student_loadgen (--unix PATH | --tcp PORT) [选项]
+//   --connections N     连接数（默认 1）
+//   --pipeline D        每个连接在途的请求数（默认 32，1 即一问一答）
+//   --seconds S         压测时长（默认 5 秒）
+//   --populate N        压测前先用 add 命令写入学号 1..N 的学生（已存在的跳过）
+//   --ids N             find 的学号在 1..N 中均匀随机（默认同 --populate，都未指定时为 100000）
+//   --seed S            随机种子（默认 42）
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+struct Target {
+    std::string unixPath;
+    int tcpPort;
+
+    Target() : tcpPort(0) {}
+};
+
+int connectTo(const Target& target) {
+    int fd;
+    if (!target.unixPath.empty()) {
+        sockaddr_un address;
+        std::memset(&address, 0, sizeof(address));
+        address.sun_family = AF_UNIX;
+        std::strncpy(address.sun_path, target.unixPath.c_str(), sizeof(address.sun_path) - 1);
+        fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (fd >= 0 && ::connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+            ::close(fd);
+            return -1;
+        }
+    } else {
+        sockaddr_in address;
+        std::memset(&address, 0, sizeof(address));
+        address.sin_family = AF_INET;
+        address.sin_port = htons(static_cast<uint16_t>(target.tcpPort));
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        fd = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (fd >= 0 && ::connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+            ::close(fd);
+            return -1;
+        }
+        int on = 1;
+        ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+    }
+    return fd;
+}
+
+bool sendAll(int fd, const std::string& data) {
+    size_t sent = 0;
+    while (sent < data.size()) {
+        ssize_t n = ::send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        sent += static_cast<size_t>(n);
+    }
+    return true;
+}
+
+// 读取响应：按 "+<行数>\n" 加结果行或 "-<原因>\n" 切分
+class ResponseReader {
+private:
+    int fd;
+    std::string buffer;
+    size_t offset;
+
+    // 从 offset 起解析一条完整的响应，成功时移动 offset
+    bool parse(bool& ok, bool& empty) {
+        const char* begin = buffer.data() + offset;
+        const char* end = buffer.data() + buffer.size();
+        const char* newline = static_cast<const char*>(std::memchr(begin, '\n', static_cast<size_t>(end - begin)));
+        if (newline == nullptr) return false;
+        const char* next = newline + 1;
+        ok = *begin == '+';
+        empty = false;
+        if (ok) {
+            long lines = std::strtol(begin + 1, nullptr, 10);
+            // find 未找到时只有一行以 # 开头的说明
+            empty = lines == 0 || (next < end && *next == '#');
+            for (long i = 0; i < lines; ++i) {
+                const char* line = static_cast<const char*>(std::memchr(next, '\n', static_cast<size_t>(end - next)));
+                if (line == nullptr) return false;
+                next = line + 1;
+            }
+        }
+        offset = static_cast<size_t>(next - buffer.data());
+        return true;
+    }
+
+public:
+    explicit ResponseReader(int fd) : fd(fd), offset(0) {}
+
+    // 阻塞到至少收到一条响应，返回本次收到的条数，连接出错时返回 -1
+    template <typename Callback>
+    int read(Callback callback) {
+        int responses = 0;
+        while (responses == 0) {
+            buffer.erase(0, offset);
+            offset = 0;
+            size_t old = buffer.size();
+            buffer.resize(old + 64 * 1024);
+            ssize_t n = ::recv(fd, &buffer[old], 64 * 1024, 0);
+            buffer.resize(old + (n > 0 ? static_cast<size_t>(n) : 0));
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) return -1;
+            bool ok = false, empty = false;
+            while (parse(ok, empty)) {
+                callback(ok, empty);
+                ++responses;
+            }
+        }
+        return responses;
+    }
+};
+
+struct WorkerResult {
+    LatencyHistogram latency;
+    uint64_t completed;
+    uint64_t errors;                   // "-" 响应
+    uint64_t misses;                   // 学号不存在
+    bool failed;                       // 连接失败或中断
+
+    WorkerResult() : completed(0), errors(0), misses(0), failed(false) {}
+};
+
+void appendFind(std::string& out, int id) {
+    out += "find ";
+    out += std::to_string(id);
+    out += '\n';
+}
+
+void runWorker(const Target& target, size_t pipeline, Clock::time_point deadline, int ids, unsigned seed,
+               WorkerResult& result) {
+    int fd = connectTo(target);
+    if (fd < 0) {
+        result.failed = true;
+        return;
+    }
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> pickId(1, ids);
+    std::deque<Clock::time_point> inFlight;  // 在途请求的发出时刻，响应按顺序返回
+    std::string requests;
+    ResponseReader reader(fd);
+
+    bool sending = true;
+    size_t refill = pipeline;
+    while (true) {
+        if (sending && refill > 0) {
+            requests.clear();
+            for (size_t i = 0; i < refill; ++i) {
+                appendFind(requests, pickId(rng));
+            }
+            Clock::time_point now = Clock::now();
+            inFlight.insert(inFlight.end(), refill, now);
+            if (!sendAll(fd, requests)) {
+                result.failed = true;
+                break;
+            }
+        }
+        if (inFlight.empty()) {
+            break;
+        }
+        Clock::time_point received;
+        int count = reader.read([&](bool ok, bool empty) {
+            if (!ok) ++result.errors;
+            else if (empty) ++result.misses;
+        });
+        if (count < 0) {
+            result.failed = true;
+            break;
+        }
+        received = Clock::now();
+        for (int i = 0; i < count; ++i) {
+            uint64_t nanos = static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(received - inFlight.front()).count());
+            result.latency.counts[LatencyHistogram::bucketOf(nanos)]++;
+            result.latency.totalNanos += nanos;
+            result.latency.maxNanos = std::max(result.latency.maxNanos, nanos);
+            inFlight.pop_front();
+        }
+        result.completed += static_cast<uint64_t>(count);
+        sending = received < deadline;
+        refill = static_cast<size_t>(count);
+    }
+    ::close(fd);
+}
+
+// 用一个连接流水线写入学号 1..count 的学生，每次发送 1000 条
+bool populate(const Target& target, int count) {
+    int fd = connectTo(target);
+    if (fd < 0) return false;
+    const char* const MAJORS[] = { "计算机科学", "软件工程", "数学", "物理", "经济学" };
+    ResponseReader reader(fd);
+    std::string requests;
+    uint64_t rejected = 0;
+    bool ok = true;
+    for (int first = 1; ok && first <= count; first += 1000) {
+        int last = std::min(count, first + 999);
+        requests.clear();
+        for (int id = first; id <= last; ++id) {
+            char record[128];
+            std::snprintf(record, sizeof(record), "add %d,学生%d,%d,%s,%s,%.2f\n", id, id, 18 + id % 8,
+                          id % 2 ? "男" : "女", MAJORS[id % 5], (id * 37 % 400) / 100.0);
+            requests += record;
+        }
+        ok = sendAll(fd, requests);
+        for (int pending = last - first + 1; ok && pending > 0;) {
+            int n = reader.read([&](bool added, bool) { if (!added) ++rejected; });
+            ok = n > 0;
+            pending -= n;
+        }
+    }
+    ::close(fd);
+    if (ok) {
+        std::cout << "已写入 " << count << " 名学生（其中 " << rejected << " 名已存在）" << std::endl;
+    }
+    return ok;
+}
+
+std::string formatNanos(uint64_t nanos) {
+    char text[32];
+    if (nanos < 1000) {
+        std::snprintf(text, sizeof(text), "%llu ns", static_cast<unsigned long long>(nanos));
+    } else if (nanos < 1000000) {
+        std::snprintf(text, sizeof(text), "%.1f µs", nanos / 1e3);
+    } else {
+        std::snprintf(text, sizeof(text), "%.2f ms", nanos / 1e6);
+    }
+    return text;
+}
+
+void usage(const char* program) {
+    std::cerr << "用法：" << program << " (--unix PATH | --tcp PORT) [--connections N] [--pipeline D]"
+              << " [--seconds S] [--populate N] [--ids N] [--seed S]" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    Target target;
+    size_t connections = 1, pipeline = 32;
+    double seconds = 5;
+    int populateCount = 0, ids = 0;
+    unsigned seed = 42;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--unix" && hasValue) {
+            target.unixPath = argv[++i];
+        } else if (arg == "--tcp" && hasValue) {
+            target.tcpPort = std::atoi(argv[++i]);
+        } else if (arg == "--connections" && hasValue) {
+            connections = std::max<size_t>(1, std::strtoul(argv[++i], nullptr, 10));
+        } else if (arg == "--pipeline" && hasValue) {
+            pipeline = std::max<size_t>(1, std::strtoul(argv[++i], nullptr, 10));
+        } else if (arg == "--seconds" && hasValue) {
+            seconds = std::strtod(argv[++i], nullptr);
+        } else if (arg == "--populate" && hasValue) {
+            populateCount = std::max(0, std::atoi(argv[++i]));
+        } else if (arg == "--ids" && hasValue) {
+            ids = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--seed" && hasValue) {
+            seed = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+        } else {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+    if (target.unixPath.empty() && target.tcpPort <= 0) {
+        usage(argv[0]);
+        return 1;
+    }
+    if (ids == 0) {
+        ids = populateCount > 0 ? populateCount : 100000;
+    }
+    if (populateCount > 0 && !populate(target, populateCount)) {
+        std::cerr << "错误：写入学生失败，服务是否已启动？" << std::endl;
+        return 1;
+    }
+
+    std::vector<WorkerResult> results(connections);
+    std::vector<std::thread> workers;
+    Clock::time_point start = Clock::now();
+    Clock::time_point deadline = start + std::chrono::microseconds(static_cast<int64_t>(seconds * 1e6));
+    for (size_t i = 0; i < connections; ++i) {
+        workers.push_back(std::thread(runWorker, std::cref(target), pipeline, deadline, ids,
+                                      seed + static_cast<unsigned>(i), std::ref(results[i])));
+    }
+    for (size_t i = 0; i < workers.size(); ++i) {
+        workers[i].join();
+    }
+    double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+
+    WorkerResult total;
+    size_t failedConnections = 0;
+    for (size_t i = 0; i < results.size(); ++i) {
+        total.latency.merge(results[i].latency);
+        total.completed += results[i].completed;
+        total.errors += results[i].errors;
+        total.misses += results[i].misses;
+        failedConnections += results[i].failed ? 1 : 0;
+    }
+
+    std::cout << "连接 " << connections << "，流水线深度 " << pipeline << "，用时 "
+              << std::fixed << std::setprecision(2) << elapsed << " 秒" << std::endl;
+    std::cout << "完成 " << total.completed << " 条 find 请求，吞吐量 "
+              << std::setprecision(0) << total.completed / elapsed << " 条/秒" << std::endl;
+    std::cout << "未找到 " << total.misses << "，错误响应 " << total.errors;
+    if (failedConnections > 0) {
+        std::cout << "，" << failedConnections << " 个连接失败";
+    }
+    std::cout << std::endl;
+    if (total.completed > 0) {
+        std::cout << "延迟：平均 " << formatNanos(static_cast<uint64_t>(total.latency.meanNanos()))
+                  << "，p50 " << formatNanos(total.latency.percentileNanos(50))
+                  << "，p99 " << formatNanos(total.latency.percentileNanos(99))
+                  << "，p99.9 " << formatNanos(total.latency.percentileNanos(99.9))
+                  << "，最大 " << formatNanos(total.latency.maxNanos) << std::endl;
+    }
+    return failedConnections == 0 ? 0 : 1;
+}
@@ -1,7 +1,16 @@
 #include "StudentManager.h"
+#include "CommandInterpreter.h"
+#include "StudentServer.h"
 #include <iostream>
 #include <limits>
+#include <sstream>
+#include <iomanip>
 #include <string>
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+#include <chrono>
+#include <csignal>
 
 class Menu {
 private:
@@ -70,6 +79,8 @@ public:
     std::cout << "9. 搜索功能" << std::endl;
     std::cout << "10. 统计信息" << std::endl;
     std::cout << "11. 清空所有数据" << std::endl;
+    std::cout << "12. 组合查询" << std::endl;
+    std::cout << "13. 运行指标" << std::endl;
     std::cout << "0. 退出系统" << std::endl;
     std::cout << std::string(50, '=') << std::endl;
   }
@@ -101,43 +112,45 @@ public:
     std::cout << "\n========== 修改学生信息 ==========" << std::endl;
     int id = getIntInput("请输入要修改的学生学号：");
 
-    Student *student = manager.findStudent(id);
-    if (student == nullptr) {
+    StudentRef current = manager.findStudent(id);
+    if (!current) {
       std::cout << "未找到该学生！" << std::endl;
       return;
     }
 
     std::cout << "当前学生信息：" << std::endl;
-    student->display();
+    current->display();
     std::cout << std::endl;
 
+    // 在副本上修改，再通过 updateStudent 提交（修改会写入日志）
+    Student student = current.toStudent();
     std::string name = getStringInput("请输入新姓名（直接回车保持不变）：");
     if (!name.empty())
-      student->setName(name);
+      student.setName(name);
 
     std::cout << "请输入新年龄（输入-1保持不变）：";
     int age;
     std::cin >> age;
     clearInputBuffer();
     if (age != -1)
-      student->setAge(age);
+      student.setAge(age);
 
     std::string gender = getStringInput("请输入新性别（直接回车保持不变）：");
     if (!gender.empty())
-      student->setGender(gender);
+      student.setGender(gender);
 
     std::string major = getStringInput("请输入新专业（直接回车保持不变）：");
     if (!major.empty())
-      student->setMajor(major);
+      student.setMajor(major);
 
     std::cout << "请输入新绩点（输入-1保持不变）：";
     double gpa;
     std::cin >> gpa;
     clearInputBuffer();
     if (gpa != -1)
-      student->setGpa(gpa);
+      student.setGpa(gpa);
 
-    std::cout << "学生信息修改成功！" << std::endl;
+    manager.updateStudent(id, student);
   }
 
   // 查找学生
@@ -145,10 +158,16 @@ public:
     std::cout << "\n========== 查找学生 ==========" << std::endl;
     int id = getIntInput("请输入要查找的学生学号：");
 
-    Student *student = manager.findStudent(id);
-    if (student != nullptr) {
+    StudentRef student = manager.findStudent(id);
+    if (student) {
       std::cout << "找到学生：" << std::endl;
       student->display();
+      double rank = manager.getGpaPercentileRank(id);
+      if (rank >= 0.0) {
+        std::ostringstream text;
+        text << std::fixed << std::setprecision(1) << rank;
+        std::cout << "绩点百分位排名：" << text.str() << "%" << std::endl;
+      }
     } else {
       std::cout << "未找到该学生！" << std::endl;
     }
@@ -228,6 +247,36 @@ public:
     }
   }
 
+  // 组合查询
+  void queryMenu() {
+    std::cout << "\n========== 组合查询 ==========" << std::endl;
+    std::cout << "字段：学号/id 姓名/name 年龄/age 性别/gender 专业/major 绩点/gpa" << std::endl;
+    std::cout << "运算：= != < <= > >= ~（包含） ^=（前缀） between 下限 and 上限" << std::endl;
+    std::cout << "示例：major = 计算机科学 and age between 20 and 22 and gpa >= 3.5 "
+                 "order by gpa desc limit 100 stats" << std::endl;
+    std::string text = getStringInput("请输入查询条件：");
+
+    StudentQuery query;
+    std::string error;
+    if (!StudentQuery::parse(text, query, error)) {
+      std::cout << "查询语句有误：" << error << std::endl;
+      return;
+    }
+    manager.displayQuery(query);
+  }
+
+  // 运行指标：显示各操作的调用次数与耗时，可导出为 Prometheus 文本格式
+  void metricsMenu() {
+    manager.getMetrics().display(std::cout);
+    if (!Metrics::enabled()) {
+      return;
+    }
+    std::string path = getStringInput("导出到文件（Prometheus 文本格式，直接回车跳过）：");
+    if (!path.empty() && manager.exportMetrics(path)) {
+      std::cout << "运行指标已写入 " << path << std::endl;
+    }
+  }
+
   // 清空数据
   void clearAllData() {
     std::cout << "\n警告：此操作将删除所有学生数据！" << std::endl;
@@ -277,10 +326,17 @@ public:
         break;
       case 10:
         manager.getStatistics();
+        manager.displayGpaDistribution();
         break;
       case 11:
         clearAllData();
         break;
+      case 12:
+        queryMenu();
+        break;
+      case 13:
+        metricsMenu();
+        break;
       case 0:
         std::cout << "感谢使用学生管理系统，再见！" << std::endl;
         return;
@@ -294,7 +350,180 @@ public:
   }
 };
 
-int main() {
+// 批处理模式：逐行读取命令，对同一个 StudentManager 执行。结果攒在内存里整块写到标准输出，
+// 错误信息带行号写到标准错误；不出提示、不等回车。--transaction 时全部命令在一个事务中执行，
+// 结束时只保存一次，任何一条命令失败都回滚并停止
+int runBatch(int argc, char *argv[]) {
+  std::string input = "-";
+  std::string dataFile = "students.txt";
+  bool transaction = false;
+  for (int i = 2; i < argc; ++i) {
+    std::string arg = argv[i];
+    if (arg == "--transaction") {
+      transaction = true;
+    } else if (arg == "--data" && i + 1 < argc) {
+      dataFile = argv[++i];
+    } else if (arg[0] != '-' || arg == "-") {
+      input = arg;
+    } else {
+      std::cerr << "用法：" << argv[0] << " --batch [命令文件，默认读标准输入] [--data 数据文件] [--transaction]\n"
+                << "命令：\n" << CommandInterpreter::usage();
+      return 1;
+    }
+  }
+
+  FILE *in = input == "-" ? stdin : std::fopen(input.c_str(), "r");
+  if (in == nullptr) {
+    std::cerr << "错误：无法打开命令文件 " << input << std::endl;
+    return 1;
+  }
+
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  ManagerOptions options;
+  options.messages = &std::cerr;  // 只有加载时的警告会走到这里
+  StudentManager manager(dataFile, options);
+  manager.setMessageStream(nullptr);
+  if (transaction && !manager.beginTransaction()) {
+    std::cerr << "错误：无法开始事务" << std::endl;
+    return 1;
+  }
+
+  const size_t FLUSH_BYTES = 1 << 20;
+  CommandInterpreter interpreter(manager);
+  std::string out, errors, error;
+  out.reserve(FLUSH_BYTES + 4096);
+  char *line = nullptr;
+  size_t capacity = 0;
+  ssize_t length;
+  size_t lineNumber = 0, commands = 0, failures = 0;
+  while ((length = ::getline(&line, &capacity, in)) != -1) {
+    ++lineNumber;
+    ++commands;
+    const char *end = line + length;
+    if (end > line && end[-1] == '\n') --end;
+    if (!interpreter.execute(line, end, out, error)) {
+      ++failures;
+      errors += "第 " + std::to_string(lineNumber) + " 行：错误：" + error + "\n";
+      if (transaction) break;
+    }
+    if (out.size() >= FLUSH_BYTES) {
+      std::fwrite(out.data(), 1, out.size(), stdout);
+      out.clear();
+    }
+    if (errors.size() >= FLUSH_BYTES) {
+      std::fwrite(errors.data(), 1, errors.size(), stderr);
+      errors.clear();
+    }
+  }
+  std::free(line);
+  if (in != stdin) std::fclose(in);
+  std::fwrite(out.data(), 1, out.size(), stdout);
+  std::fflush(stdout);
+  std::fwrite(errors.data(), 1, errors.size(), stderr);
+
+  bool saved = true;
+  if (transaction) {
+    manager.setMessageStream(&std::cerr);
+    if (failures == 0) {
+      saved = manager.commitTransaction();
+    } else {
+      manager.rollbackTransaction();
+      std::cerr << "事务已回滚，数据文件未修改" << std::endl;
+    }
+  }
+  double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  std::cerr << "批处理完成：执行 " << commands << " 行，失败 " << failures << " 行，用时 "
+            << std::fixed << std::setprecision(3) << seconds << " 秒" << std::endl;
+  return failures == 0 && saved ? 0 : 1;
+}
+
+// 服务模式：在本地套接字上处理请求（命令格式同批处理模式），直到收到 SIGINT 或 SIGTERM。
+// 退出前保存数据文件
+StudentServer *runningServer = nullptr;
+
+void stopServer(int) {
+  if (runningServer != nullptr) runningServer->stop();
+}
+
+int runServe(int argc, char *argv[]) {
+  std::string dataFile = "students.txt";
+  std::vector<std::string> addresses;
+  for (int i = 2; i < argc; ++i) {
+    std::string arg = argv[i];
+    if (arg == "--data" && i + 1 < argc) {
+      dataFile = argv[++i];
+    } else if (arg.compare(0, 5, "unix:") == 0 || arg.compare(0, 4, "tcp:") == 0) {
+      addresses.push_back(arg);
+    } else {
+      addresses.clear();
+      break;
+    }
+  }
+  if (addresses.empty()) {
+    std::cerr << "用法：" << argv[0] << " --serve unix:<套接字路径> | tcp:<端口> ... [--data 数据文件]\n"
+              << "每行一条请求，成功时响应 \"+<行数>\" 后接结果行，失败时响应 \"-<原因>\"。命令：\n"
+              << CommandInterpreter::usage();
+    return 1;
+  }
+
+  ManagerOptions options;
+  options.messages = &std::cerr;
+  StudentManager manager(dataFile, options);
+  manager.setMessageStream(nullptr);
+  StudentServer server(manager);
+  for (size_t i = 0; i < addresses.size(); ++i) {
+    std::string error;
+    bool isUnix = addresses[i][0] == 'u';
+    bool listening = isUnix ? server.listenUnix(addresses[i].substr(5), error)
+                          : server.listenTcp(std::atoi(addresses[i].c_str() + 4), error);
+    if (!listening) {
+      std::cerr << "错误：" << error << std::endl;
+      return 1;
+    }
+    std::cerr << "正在监听 " << addresses[i] << std::endl;
+  }
+
+  runningServer = &server;
+  std::signal(SIGINT, stopServer);
+  std::signal(SIGTERM, stopServer);
+  std::signal(SIGPIPE, SIG_IGN);
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  server.run();
+  runningServer = nullptr;
+
+  double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  std::cerr << "服务已停止：共 " << server.connectionCount() << " 个连接，处理 " << server.requestCount()
+            << " 条请求，运行 " << std::fixed << std::setprecision(1) << seconds << " 秒" << std::endl;
+  manager.setMessageStream(&std::cerr);
+  return manager.saveToFile() ? 0 : 1;
+}
+
+int main(int argc, char *argv[]) {
+  std::string mode = argc > 1 ? argv[1] : "";
+
+  // 格式转换：student_manager --convert students.txt students.bin
+  if (mode == "--convert") {
+    if (argc != 4) {
+      std::cout << "用法：" << argv[0] << " --convert <源文件> <目标文件>" << std::endl;
+      return 1;
+    }
+    if (!StudentManager::convertFile(argv[2], argv[3])) {
+      return 1;
+    }
+    std::cout << "已将 " << argv[2] << " 转换为 " << argv[3] << std::endl;
+    return 0;
+  }
+
+  // 批处理：student_manager --batch commands.txt，或 some_job | student_manager --batch
+  if (mode == "--batch") {
+    return runBatch(argc, argv);
+  }
+
+  // 服务：student_manager --serve unix:/tmp/students.sock，客户端见 student_loadgen
+  if (mode == "--serve") {
+    return runServe(argc, argv);
+  }
+
   Menu menu;
   menu.run();
   return 0;
@@ -0,0 +1,619 @@
+#include "ConcurrentStudentManager.h"
+#include "ShardedStudentManager.h"
+#include "BinarySnapshot.h"
+#include <iostream>
+#include <vector>
+#include <string>
+#include <thread>
+#include <atomic>
+#include <random>
+#include <cstdlib>
+#include <cstdio>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <fstream>
+#include <sstream>
+#include <iterator>
+#include <csignal>
+#include <sys/resource.h>
+#include <unistd.h>
+
+// ConcurrentStudentManager 多线程压力测试
+// 用法：./student_stress [写线程数] [读线程数] [每个写线程的操作数]
+// 每个写线程只修改自己的一段学号，读线程同时查找、搜索、统计并检查读到的记录是否完整
+
+namespace {
+
+const int BASE_ID = 30000000;
+const int IDS_PER_WRITER = 1000;
+
+// 学号 id 的第 version 个版本：姓名、年龄、绩点都由 version 决定，读者据此检查是否读到半新半旧的记录
+Student makeVersion(int id, int version) {
+    return Student(id, "S" + std::to_string(id) + "_" + std::to_string(version), 18 + version % 8,
+                   (version % 2) ? "男" : "女", "计算机科学", (version % 401) / 100.0);
+}
+
+bool isConsistent(const Student& student) {
+    std::string prefix = "S" + std::to_string(student.getId()) + "_";
+    const std::string& name = student.getName();
+    if (name.compare(0, prefix.size(), prefix) != 0) {
+        return false;
+    }
+    int version = std::atoi(name.c_str() + prefix.size());
+    Student expected = makeVersion(student.getId(), version);
+    return student.getAge() == expected.getAge() && student.getGender() == expected.getGender() &&
+           student.getMajor() == expected.getMajor() && student.getGpa() == expected.getGpa();
+}
+
+std::atomic<size_t> failures(0);
+
+void fail(const std::string& message) {
+    if (failures.fetch_add(1) < 10) {
+        std::fprintf(stderr, "失败：%s\n", message.c_str());
+    }
+}
+
+// 写线程：在自己的学号段内随机增、删、改，记录最终哪些学号存在
+void writer(ConcurrentStudentManager& manager, int index, size_t operations, std::vector<char>& present) {
+    std::mt19937 rng(index + 1);
+    int base = BASE_ID + index * IDS_PER_WRITER;
+    present.assign(IDS_PER_WRITER, 0);
+    for (size_t i = 0; i < operations; ++i) {
+        int slot = static_cast<int>(rng() % IDS_PER_WRITER);
+        int id = base + slot;
+        int version = static_cast<int>(i);
+        switch (rng() % 4) {
+            case 0:
+            case 1:
+                if (manager.addStudent(makeVersion(id, version)) == !present[slot]) {
+                    present[slot] = 1;
+                } else {
+                    fail("添加结果与预期不符：" + std::to_string(id));
+                }
+                break;
+            case 2:
+                if (manager.updateStudent(id, makeVersion(id, version)) != static_cast<bool>(present[slot])) {
+                    fail("修改结果与预期不符：" + std::to_string(id));
+                }
+                break;
+            default:
+                if (manager.deleteStudent(id) == static_cast<bool>(present[slot])) {
+                    present[slot] = 0;
+                } else {
+                    fail("删除结果与预期不符：" + std::to_string(id));
+                }
+                break;
+        }
+    }
+}
+
+// 读线程：随机查找、按姓名搜索、统计，直到写线程全部结束
+void reader(const ConcurrentStudentManager& manager, int index, int writers,
+            const std::atomic<bool>& done, std::atomic<size_t>& reads) {
+    std::mt19937 rng(1000 + index);
+    size_t count = 0;
+    while (!done.load()) {
+        int id = BASE_ID + static_cast<int>(rng() % (writers * IDS_PER_WRITER));
+        switch (rng() % 4) {
+            case 0:
+            case 1: {
+                Student student;
+                if (manager.findStudent(id, student) && (student.getId() != id || !isConsistent(student))) {
+                    fail("查找到不完整的记录：" + std::to_string(id));
+                }
+                break;
+            }
+            case 2: {
+                std::vector<Student> result = manager.searchByName("S" + std::to_string(id) + "_");
+                if (result.size() > 1) {
+                    fail("同一学号搜索到多条记录：" + std::to_string(id));
+                }
+                for (size_t i = 0; i < result.size(); ++i) {
+                    if (result[i].getId() != id || !isConsistent(result[i])) {
+                        fail("搜索到不完整的记录：" + std::to_string(id));
+                    }
+                }
+                break;
+            }
+            default: {
+                // 启用了 verifyStatistics：增量统计与全表扫描不一致时抛出 std::logic_error
+                try {
+                    int total = manager.getTotalStudents();
+                    double average = manager.getAverageGpa();
+                    double median = manager.getGpaPercentile(50.0);
+                    double rank = manager.getGpaPercentileRank(id);
+                    if (total < 0 || total > writers * IDS_PER_WRITER || average < 0.0 || average > 4.0 ||
+                        median < 0.0 || median > 4.0 || rank > 100.0 || (rank < 0.0 && rank != -1.0)) {
+                        fail("统计结果超出范围");
+                    }
+                } catch (const std::logic_error& e) {
+                    fail(e.what());
+                }
+                break;
+            }
+        }
+        ++count;
+    }
+    reads += count;
+}
+
+// ========== 预写日志 ==========
+
+bool copyFile(const std::string& from, const std::string& to) {
+    std::ifstream in(from.c_str(), std::ios::binary);
+    std::ofstream out(to.c_str(), std::ios::binary | std::ios::trunc);
+    if (in) {
+        out << in.rdbuf();
+    }
+    return static_cast<bool>(in);
+}
+
+long fileLength(const std::string& path) {
+    std::ifstream in(path.c_str(), std::ios::binary | std::ios::ate);
+    return in ? static_cast<long>(in.tellg()) : -1;
+}
+
+// 进程在日志写盘之后、析构之前崩溃：复制数据文件和日志（析构时不会再有任何写入）
+void simulateCrash(const std::string& path, const std::string& crashPath) {
+    copyFile(path, crashPath);
+    copyFile(path + ".wal", crashPath + ".wal");
+}
+
+void removeDataFiles(const std::string& path) {
+    std::remove(path.c_str());
+    std::remove((path + ".wal").c_str());
+    std::remove((path + ".wal.1").c_str());
+}
+
+// 重放、残缺尾部与写盘失败
+void checkWriteAheadLog() {
+    const std::string path = "stress_wal.txt", crashPath = "stress_wal_crash.txt";
+    removeDataFiles(path);
+    removeDataFiles(crashPath);
+    ManagerOptions options;
+    options.messages = nullptr;
+    options.walSyncIntervalMs = 0;     // 每次修改都同步写盘
+
+    // 崩溃后重放：数据文件加日志恢复出全部修改
+    {
+        StudentManager manager(path, options);
+        for (int id = BASE_ID; id < BASE_ID + 100; ++id) {
+            manager.addStudent(makeVersion(id, 1));
+        }
+        for (int id = BASE_ID; id < BASE_ID + 10; ++id) {
+            manager.updateStudent(id, makeVersion(id, 2));
+            manager.deleteStudent(id + 10);
+        }
+        manager.updateStudent(BASE_ID + 99, makeVersion(BASE_ID + 200, 3)); // 改学号
+        manager.sortByGpa();           // 只记一条顺序记录，不写检查点
+        simulateCrash(path, crashPath);
+    }
+    {
+        StudentManager recovered(crashPath, options);
+        bool ok = recovered.getTotalStudents() == 90 && recovered.getSortOrder() == SORT_BY_GPA && !recovered.findStudent(BASE_ID + 10) &&
+                  !recovered.findStudent(BASE_ID + 99) && recovered.findStudent(BASE_ID + 200) &&
+                  recovered.findStudent(BASE_ID).getName() == makeVersion(BASE_ID, 2).getName() &&
+                  recovered.findStudent(BASE_ID + 50).getName() == makeVersion(BASE_ID + 50, 1).getName();
+        if (!ok) {
+            fail("崩溃后重放日志的结果与预期不符");
+        }
+        // 最后一条记录只写了一半：截掉末尾几个字节，重放应停在它之前
+        recovered.addStudent(makeVersion(BASE_ID + 300, 1));
+        simulateCrash(crashPath, path);
+    }
+    long length = fileLength(path + ".wal");
+    if (length <= 3 || ::truncate((path + ".wal").c_str(), length - 3) != 0) {
+        fail("无法构造残缺的日志尾部");
+    }
+    {
+        StudentManager recovered(path, options);
+        if (recovered.getTotalStudents() != 90 || recovered.findStudent(BASE_ID + 300)) {
+            fail("日志残缺的尾部没有被忽略");
+        }
+        // 打开日志时截掉残缺的尾部，之后追加的记录重放时能读到
+        recovered.addStudent(makeVersion(BASE_ID + 301, 1));
+        simulateCrash(path, crashPath);
+    }
+    {
+        StudentManager recovered(crashPath, options);
+        if (recovered.getTotalStudents() != 91 || !recovered.findStudent(BASE_ID + 301)) {
+            fail("截掉残缺尾部后追加的日志记录丢失");
+        }
+    }
+
+    // 写盘失败（用文件大小上限模拟磁盘已满）：修改返回 false，记录保留，恢复后补写
+    removeDataFiles(path);
+    removeDataFiles(crashPath);
+    {
+        StudentManager manager(path, options);
+        manager.addStudent(makeVersion(BASE_ID, 1));
+        struct rlimit original;
+        ::getrlimit(RLIMIT_FSIZE, &original);
+        struct rlimit limited = original;
+        limited.rlim_cur = static_cast<rlim_t>(fileLength(path + ".wal"));
+        std::signal(SIGXFSZ, SIG_IGN);
+        ::setrlimit(RLIMIT_FSIZE, &limited);
+        bool added = manager.addStudent(makeVersion(BASE_ID + 1, 1));
+        bool failed = manager.hasLogFailure();
+        ::setrlimit(RLIMIT_FSIZE, &original);
+        if (added || !failed) {
+            fail("日志写盘失败时修改仍报告成功");
+        }
+        if (!manager.syncLog() || manager.hasLogFailure()) {
+            fail("日志恢复写盘后仍然失败");
+        }
+        manager.addStudent(makeVersion(BASE_ID + 2, 1));
+        simulateCrash(path, crashPath);
+    }
+    {
+        StudentManager recovered(crashPath, options);
+        if (recovered.getTotalStudents() != 3 || !recovered.findStudent(BASE_ID + 1)) {
+            fail("写盘失败的日志记录没有在恢复后补写");
+        }
+    }
+    removeDataFiles(path);
+    removeDataFiles(crashPath);
+}
+
+// ========== 快照格式 ==========
+
+std::string readFile(const std::string& path) {
+    std::ifstream in(path.c_str(), std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+bool sameStudent(StudentRef a, const Student& b) {
+    return a && a.getId() == b.getId() && a.getName() == b.getName() && a.getAge() == b.getAge() &&
+           a.getGender() == b.getGender() && a.getMajor() == b.getMajor() && a.getGpa() == b.getGpa();
+}
+
+// 文本 -> 快照 -> 文本逐字节不变；快照中含逗号、换行的姓名和专业原样读回
+void checkSnapshotRoundTrip() {
+    const std::string text = "stress_round.txt", snap = "stress_round.snap";
+    const std::string textAgain = "stress_round2.txt", snapAgain = "stress_round2.snap";
+    ManagerOptions options;
+    options.messages = nullptr;
+    options.writeAheadLog = false;
+
+    std::vector<Student> plain;
+    for (int id = BASE_ID; id < BASE_ID + 500; ++id) {
+        plain.push_back(makeVersion(id, id % 37));
+    }
+    {
+        StudentManager manager("", options);
+        manager.addStudents(plain);
+        manager.exportTo(text);
+    }
+    if (!StudentManager::convertFile(text, snap) || !StudentManager::convertFile(snap, textAgain) ||
+        readFile(text) != readFile(textAgain)) {
+        fail("文本经快照转换回文本后内容改变");
+    }
+
+    std::vector<Student> special = plain;
+    special.push_back(Student(BASE_ID + 1000, "Smith, John", 20, "男", "计算机科学", 3.5));
+    special.push_back(Student(BASE_ID + 1001, "第一行\n第二行", 21, "女", "数学,统计", 2.75));
+    special.push_back(Student(BASE_ID + 1002, "\"引号\",\r\n", 22, "女", "", 0.0));
+    special.push_back(Student(BASE_ID + 1003, "", 23, "男", "法学\n", 4.0));
+    {
+        StudentManager manager("", options);
+        manager.addStudents(special);
+        manager.exportTo(snap);
+    }
+    std::string error;
+    {
+        StudentManager loaded(snap, options);
+        if (loaded.getTotalStudents() != static_cast<int>(special.size()) || !loaded.verifyStatistics(error)) {
+            fail("快照重新加载后人数或统计不符");
+        }
+        for (size_t i = 0; i < special.size(); ++i) {
+            if (!sameStudent(loaded.findStudent(special[i].getId()), special[i])) {
+                fail("快照重新加载后记录改变：" + std::to_string(special[i].getId()));
+                break;
+            }
+        }
+    }
+    if (!StudentManager::convertFile(snap, snapAgain) || readFile(snap) != readFile(snapAgain)) {
+        fail("快照重新保存后内容改变");
+    }
+
+    // 空名册：只有文件头的快照
+    {
+        StudentManager empty("", options);
+        if (!empty.exportTo(snap)) {
+            fail("无法保存空快照");
+        }
+    }
+    {
+        StudentManager loaded(snap, options);
+        if (loaded.getTotalStudents() != 0 || loaded.getLastLoadReport().bytesRead != BinarySnapshot::HEADER_SIZE) {
+            fail("空快照重新加载后内容不符");
+        }
+    }
+    std::remove(text.c_str());
+    std::remove(snap.c_str());
+    std::remove(textAgain.c_str());
+    std::remove(snapAgain.c_str());
+}
+
+
+// ========== 事务 ==========
+
+// 回滚撤销事务中的修改与排序：记录、显示顺序、回滚后保存的数据文件都回到事务开始时的状态
+void checkTransactionRollback() {
+    const std::string path = "stress_txn.txt";
+    removeDataFiles(path);
+    ManagerOptions options;
+    options.messages = nullptr;
+    options.walSyncIntervalMs = 0;
+    {
+        StudentManager manager(path, options);
+        for (int id = BASE_ID; id < BASE_ID + 10; ++id) {
+            manager.addStudent(makeVersion(id, id - BASE_ID));  // 绩点随学号递增，按绩点排序与存储顺序相反
+        }
+        if (!manager.beginTransaction()) {
+            fail("无法开始事务");
+            return;
+        }
+        manager.addStudent(makeVersion(BASE_ID + 10, 1));
+        manager.deleteStudent(BASE_ID);
+        manager.sortByGpa();
+        manager.rollbackTransaction();
+        std::vector<StudentRef> rows = manager.getAllStudents();
+        bool ok = manager.getSortOrder() == SORT_NONE && manager.getTotalStudents() == 10 &&
+                  manager.findStudent(BASE_ID) && !manager.findStudent(BASE_ID + 10);
+        for (size_t i = 0; ok && i < rows.size(); ++i) {
+            ok = rows[i].getId() == BASE_ID + static_cast<int>(i);
+        }
+        if (!ok) {
+            fail("事务回滚后记录或显示顺序没有恢复");
+        }
+        manager.saveToFile();
+    }
+    {
+        StudentManager reloaded(path, options);
+        std::vector<StudentRef> rows = reloaded.getAllStudents();
+        for (size_t i = 0; i < rows.size(); ++i) {
+            if (rows[i].getId() != BASE_ID + static_cast<int>(i)) {
+                fail("事务回滚后保存的数据文件没有按回滚前的顺序写出");
+                break;
+            }
+        }
+    }
+    removeDataFiles(path);
+}
+
+// ========== 统计 ==========
+
+// 绩点为 NaN 的学生计入总人数，但不参与平均绩点与最值
+template <typename Manager>
+void checkNanStatistics(Manager& manager, const std::string& label) {
+    manager.addStudent(Student(BASE_ID, "有绩点", 20, "男", "数学", 3.0));
+    manager.addStudent(Student(BASE_ID + 1, "无绩点", 20, "女", "数学", std::numeric_limits<double>::quiet_NaN()));
+    GpaStatistics stats = manager.getGpaStatistics();
+    std::ostringstream text;
+    manager.getStatistics(text);
+    if (stats.count != 2 || stats.graded != 1 || stats.sum != 3.0 || stats.highest.getId() != BASE_ID ||
+        text.str().find("学生总数：2\n") == std::string::npos || text.str().find("平均绩点：3.00") == std::string::npos) {
+        fail(label + "：含 NaN 绩点时的人数或平均绩点不对");
+    }
+}
+
+void checkStatisticsHeadCount() {
+    ManagerOptions options;
+    options.messages = nullptr;
+    options.writeAheadLog = false;
+    options.verifyStatistics = true;
+    StudentManager single("", options);
+    checkNanStatistics(single, "单个 StudentManager");
+    ShardedStudentManager sharded("", 4, options);
+    checkNanStatistics(sharded, "ShardedStudentManager");
+}
+
+// ========== 分片 ==========
+
+// 按绩点从高到低、NaN 排在最后
+bool gpaOrdered(const std::vector<StudentRef>& rows) {
+    for (size_t i = 1; i < rows.size(); ++i) {
+        double before = rows[i - 1].getGpa(), after = rows[i].getGpa();
+        if (std::isnan(before) ? !std::isnan(after) : (!std::isnan(after) && after > before)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// 各分片结果的归并顺序（含 NaN 绩点），以及跨分片改学号时日志写入失败
+void checkShardedManager() {
+    ManagerOptions options;
+    options.messages = nullptr;
+    options.writeAheadLog = false;
+    {
+        ShardedStudentManager manager("", 4, options);
+        for (int id = 1; id <= 12; ++id) {
+            double gpa = id == 1 ? std::numeric_limits<double>::quiet_NaN() : id * 0.25;
+            manager.addStudent(Student(id, "S" + std::to_string(id), 20, "男", "数学", gpa));
+        }
+        std::vector<StudentRef> all = manager.getAllStudents(SORT_BY_GPA);
+        if (all.size() != 12 || !gpaOrdered(all) || all.back().getId() != 1) {
+            fail("分片按绩点归并时 NaN 没有排在最后");
+        }
+        std::vector<StudentRef> top = manager.getTopStudentsByGpa(11);
+        if (top.size() != 11 || !gpaOrdered(top) || std::isnan(top.back().getGpa())) {
+            fail("分片绩点前 k 名的归并顺序不对");
+        }
+        if (!gpaOrdered(manager.getStudentsByGpaRange(0.0, 4.0))) {
+            fail("分片绩点区间的归并顺序不对");
+        }
+    }
+
+    // 所有分片的日志都写不进去：跨分片改学号返回 false，旧记录保留
+    const std::string path = "stress_shard.txt";
+    const size_t SHARDS = 4;
+    options.writeAheadLog = true;
+    options.walSyncIntervalMs = 0;
+    for (size_t i = 0; i < SHARDS; ++i) {
+        removeDataFiles(ShardedStudentManager::shardPath(path, i));
+    }
+    {
+        ShardedStudentManager manager(path, SHARDS, options);
+        for (int id = BASE_ID; id < BASE_ID + 20; ++id) {
+            manager.addStudent(makeVersion(id, 1));
+        }
+        int newId = BASE_ID + 100;
+        while (manager.shardOf(newId) == manager.shardOf(BASE_ID)) {
+            ++newId;
+        }
+        long shortest = -1;
+        for (size_t i = 0; i < SHARDS; ++i) {
+            long length = fileLength(ShardedStudentManager::shardPath(path, i) + ".wal");
+            if (shortest < 0 || length < shortest) shortest = length;
+        }
+        struct rlimit original;
+        ::getrlimit(RLIMIT_FSIZE, &original);
+        struct rlimit limited = original;
+        limited.rlim_cur = static_cast<rlim_t>(shortest);
+        std::signal(SIGXFSZ, SIG_IGN);
+        ::setrlimit(RLIMIT_FSIZE, &limited);
+        bool updated = manager.updateStudent(BASE_ID, makeVersion(newId, 2));
+        ::setrlimit(RLIMIT_FSIZE, &original);
+        if (updated || !manager.findStudent(BASE_ID)) {
+            fail("跨分片改学号时日志写入失败仍报告成功，或丢掉了旧记录");
+        }
+        manager.syncLog();
+    }
+    for (size_t i = 0; i < SHARDS; ++i) {
+        removeDataFiles(ShardedStudentManager::shardPath(path, i));
+    }
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    int writers = argc > 1 ? std::atoi(argv[1]) : 4;
+    int readers = argc > 2 ? std::atoi(argv[2]) : 8;
+    size_t operations = argc > 3 ? static_cast<size_t>(std::strtoul(argv[3], nullptr, 10)) : 20000;
+
+    ManagerOptions options;
+    options.writeAheadLog = false;
+    options.messages = nullptr;     // 不输出 addStudent 等操作的提示信息
+    options.verifyStatistics = true; // 每次读取统计都与全表扫描核对
+    ConcurrentStudentManager manager("", options);
+
+    std::atomic<bool> done(false);
+    std::atomic<size_t> reads(0);
+    std::vector<std::vector<char> > present(writers);
+    std::vector<std::thread> readerThreads, writerThreads;
+    for (int i = 0; i < readers; ++i) {
+        readerThreads.push_back(std::thread(reader, std::cref(manager), i, writers,
+                                            std::cref(done), std::ref(reads)));
+    }
+    for (int i = 0; i < writers; ++i) {
+        writerThreads.push_back(std::thread(writer, std::ref(manager), i, operations, std::ref(present[i])));
+    }
+    for (size_t i = 0; i < writerThreads.size(); ++i) {
+        writerThreads[i].join();
+    }
+    done = true;
+    for (size_t i = 0; i < readerThreads.size(); ++i) {
+        readerThreads[i].join();
+    }
+
+    // 各线程分槽记录的运行指标合并后，修改次数应与写线程的操作数一致
+    if (Metrics::enabled()) {
+        MetricsSnapshot metrics = manager.getMetrics();
+        uint64_t changes = metrics.operations[METRIC_ADD].count() + metrics.operations[METRIC_DELETE].count() +
+                           metrics.operations[METRIC_UPDATE].count();
+        if (changes != writers * operations) {
+            fail("运行指标记录的修改次数与预期不符");
+        }
+    }
+
+    // 写线程全部结束后，存储中的记录应与各写线程的记录完全一致
+    int expected = 0;
+    for (int w = 0; w < writers; ++w) {
+        for (int slot = 0; slot < IDS_PER_WRITER; ++slot) {
+            int id = BASE_ID + w * IDS_PER_WRITER + slot;
+            Student student;
+            bool found = manager.findStudent(id, student);
+            if (found != static_cast<bool>(present[w][slot])) {
+                fail("最终状态与预期不符：" + std::to_string(id));
+            } else if (found && !isConsistent(student)) {
+                fail("最终记录不完整：" + std::to_string(id));
+            }
+            expected += present[w][slot];
+        }
+    }
+    if (manager.getTotalStudents() != expected) {
+        fail("学生总数与预期不符");
+    }
+
+    // 增量统计在压缩后、以及重新加载后都应与全表扫描一致
+    const std::string path = "stress_statistics.txt";
+    std::string error;
+    manager.compact();
+    manager.read([&](const StudentManager& m) {
+        if (!m.verifyStatistics(error)) {
+            fail("压缩后统计不一致：" + error);
+        }
+        m.exportTo(path);
+    });
+    for (unsigned threads = 1; threads <= 4; threads *= 4) {
+        ManagerOptions reload = options;
+        reload.loadThreads = threads;
+        StudentManager loaded(path, reload);
+        if (!loaded.verifyStatistics(error)) {
+            fail("重新加载后统计不一致：" + error);
+        } else if (loaded.getGpaStatistics().count != static_cast<size_t>(expected)) {
+            fail("重新加载后人数与预期不符");
+        } else if (Metrics::enabled() && loaded.getMetrics().bytesRead == 0) {
+            fail("运行指标没有记录读取的字节数");
+        }
+    }
+    std::remove(path.c_str());
+
+    // 后台保存写出的是发起时的快照：之后的修改（清空后写入新版本）不影响写出的文件
+    const std::string asyncPath = "stress_async.txt";
+    {
+        ConcurrentStudentManager source(asyncPath, options);
+        for (int id = BASE_ID; id < BASE_ID + IDS_PER_WRITER; ++id) {
+            source.addStudent(makeVersion(id, 1));
+        }
+        std::future<bool> saved = source.saveAsync();
+        source.clearAllStudents();
+        for (int id = BASE_ID; id < BASE_ID + IDS_PER_WRITER; ++id) {
+            source.addStudent(makeVersion(id, 2));
+        }
+        if (!saved.get()) {
+            fail("后台保存失败");
+        }
+        StudentManager loaded(asyncPath, options);
+        if (loaded.getTotalStudents() != IDS_PER_WRITER || !loaded.verifyStatistics(error)) {
+            fail("后台保存的文件人数或统计不符");
+        }
+        for (int id = BASE_ID; id < BASE_ID + IDS_PER_WRITER; ++id) {
+            StudentRef student = loaded.findStudent(id);
+            if (!student || student.getName() != makeVersion(id, 1).getName()) {
+                fail("后台保存的记录不是发起保存时的版本：" + std::to_string(id));
+                break;
+            }
+        }
+    }
+    std::remove(asyncPath.c_str());
+
+    checkWriteAheadLog();
+    checkSnapshotRoundTrip();
+    checkShardedManager();
+    checkStatisticsHeadCount();
+    checkTransactionRollback();
+
+    std::cout << "写线程 " << writers << " 个，共 " << writers * operations << " 次修改；"
+              << "读线程 " << readers << " 个，共 " << reads.load() << " 次查询；"
+              << "最终 " << expected << " 名学生" << std::endl;
+    if (failures.load() != 0) {
+        std::cout << "压力测试失败：" << failures.load() << " 处错误" << std::endl;
+        return 1;
+    }
+    std::cout << "压力测试通过" << std::endl;
+    return 0;
+}
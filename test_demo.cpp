@@ -26,7 +26,7 @@ int main() {
     manager.displayAllStudents();
     
     std::cout << "\n3. 查找学号为20210002的学生：" << std::endl;
-    Student* found = manager.findStudent(20210002);
+    StudentRef found = manager.findStudent(20210002);
     if (found) {
         found->display();
     }
@@ -51,11 +51,13 @@ int main() {
     manager.getStatistics();
     
     std::cout << "\n9. 修改学生信息（修改张三的绩点为3.95）：" << std::endl;
-    Student* student = manager.findStudent(20210001);
+    StudentRef student = manager.findStudent(20210001);
     if (student) {
-        student->setGpa(3.95);
+        Student updated = student.toStudent();
+        updated.setGpa(3.95);
+        manager.updateStudent(20210001, updated);
         std::cout << "修改后的信息：" << std::endl;
-        student->display();
+        manager.findStudent(20210001)->display();
     }
     
     std::cout << "\n10. 删除学生（删除学号20210005）：" << std::endl;
@@ -63,7 +65,7 @@ int main() {
     manager.displayAllStudents();
     
     std::cout << "\n========== 演示完成 ==========" << std::endl;
-    std::cout << "数据已保存到 demo_students.txt 文件中。" << std::endl;
+    std::cout << "数据已保存到 demo_students.txt 文件中（最近的修改记录在 demo_students.txt.wal）。" << std::endl;
     
     return 0;
 }
\ No newline at end of file